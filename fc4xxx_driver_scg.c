@@ -18,13 +18,15 @@
 *   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
 ********************************************************************************/
 #include "fc4xxx_driver_scg.h"
+#include "fc4xxx_driver_scg_ext.h"
+#include <stddef.h>
+#include <string.h>
 
 
 /* ################################################################################## */
 /* ####################################### Macro #################################### */
 #define SIRC_CLOCK       12000000U
 #define SIRC32K_CLOCK    32000U
-#define FIRC_CLOCK       96000000U
 #define FOSC_STABILIZATION_TIMEOUT 320500U
 #define FIRC_STABILIZATION_TIMEOUT 20U
 #define SIRC_STABILIZATION_TIMEOUT 100U
@@ -33,13 +35,182 @@
 #define SCG_CLKSRC_STABILIZATION_TIMEOUT 1000U
 #define CLOCK_OFF_STABILIZATION_TIMEOUT 1000U
 #define CLOCK_DIV_STABILIZATION_TIMEOUT 1000U
-#define PLL0_CLK_MAX 200000000U
-#define PLL0_CLK_MIN 75000000U
-#define SYS_CORE_CLK_MAX 150000000U
-#define SYS_BUS_CLK_MAX 75000000U
-#define SYS_SLOW_CLK_MAX 37500000U
 #define ASYNC_CLOCKDIVL_DEFAULT  SCG_ASYNCCLOCKDIV_BY8
 
+#define SYSTICK_MIN_CARRY_COUNT 64U
+#define SYSTICK_RELOAD_TIMEOUT 100U
+
+/* adaptive startup deadline: max observed * 2 + 1000 loops worth of cycles, after at least 2 samples */
+#define SCG_STARTUP_HISTORY_MIN     2U
+#define SCG_STARTUP_MARGIN_MUL      2U
+#define SCG_STARTUP_MARGIN_ADD      (1000U * SCG_WAIT_LOOP_CYCLES)
+/* a startup slower than 150% of the history mean raises the degradation warning */
+#define SCG_STARTUP_DEGRADE_PCT     150U
+/* samples are SCG_GET_CYCLES() ticks, a history recorded in wait loops has another magic */
+#define SCG_STARTUP_MAGIC           0x53545543U
+#define SCG_STARTUP_FOSC            0U
+#define SCG_STARTUP_SOSC            1U
+#define SCG_STARTUP_PLL0            2U
+
+/* DIVCORE field is 4 bits, the ramp steps keep (DIVCORE + 1) within 1..16 */
+#define SCG_RAMP_DIVCORE_RANGE      16U
+
+/* probe groups of s_tClockSequenceInfo, one per SCG_SetXxxClockStatus function */
+#define SCG_PROBE_FIRC              0x01U
+#define SCG_PROBE_SIRC              0x02U
+#define SCG_PROBE_SIRC32K           0x04U
+#define SCG_PROBE_FOSC              0x08U
+#define SCG_PROBE_SOSC              0x10U
+#define SCG_PROBE_PLL0              0x20U
+#define SCG_PROBE_CLKOUT            0x40U
+#define SCG_PROBE_CORE              0x80U
+#define SCG_PROBE_ALL               0xFFU
+
+/* NVM clock source selection bits of CLKOUTCFG, FIRC is the faster NVM clock */
+#define SCG_NVMCLK_MASK             (SCG_CLKOUTCFG_NVMCLK_FIRC_MASK | SCG_CLKOUTCFG_NVMCLK_SIRC_MASK)
+
+#define SCG_ENTER_CRITICAL(u32Primask)  do { (u32Primask) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define SCG_EXIT_CRITICAL(u32Primask)   __set_PRIMASK(u32Primask)
+
+/* SCG register write trace: the SCG_HWA_xxx write accessors used below are wrapped to record every write */
+#ifdef SCG_TRACE_ENABLE
+#define SCG_TRACE_SET(pfSet, eReg, u32Val) \
+    do { uint32_t u32TraceVal = (uint32_t)(u32Val); pfSet(u32TraceVal); \
+         SCG_TraceRecord((eReg), SCG_TRACE_OP_WRITE, u32TraceVal); } while (0)
+#define SCG_TRACE_MODIFY(pfModify, eReg, u32Reg) \
+    do { pfModify(); SCG_TraceRecord((eReg), SCG_TRACE_OP_MODIFY, (u32Reg)); } while (0)
+
+#define SCG_HWA_SetCCR(u32Val)          SCG_TRACE_SET(SCG_HWA_SetCCR, SCG_TRACE_REG_CCR, (u32Val))
+#define SCG_HWA_SetClkOutCfg(u32Val)    SCG_TRACE_SET(SCG_HWA_SetClkOutCfg, SCG_TRACE_REG_CLKOUTCFG, (u32Val))
+#define SCG_HWA_SetFircCsr(u32Val)      SCG_TRACE_SET(SCG_HWA_SetFircCsr, SCG_TRACE_REG_FIRCCSR, (u32Val))
+#define SCG_HWA_SetFircDiv(u32Val)      SCG_TRACE_SET(SCG_HWA_SetFircDiv, SCG_TRACE_REG_FIRCDIV, (u32Val))
+#define SCG_HWA_SetFircCfg(u32Val)      SCG_TRACE_SET(SCG_HWA_SetFircCfg, SCG_TRACE_REG_FIRCCFG, (u32Val))
+#define SCG_HWA_SetFircTcfg(u32Val)     SCG_TRACE_SET(SCG_HWA_SetFircTcfg, SCG_TRACE_REG_FIRCTCFG, (u32Val))
+#define SCG_HWA_SetSircCsr(u32Val)      SCG_TRACE_SET(SCG_HWA_SetSircCsr, SCG_TRACE_REG_SIRCCSR, (u32Val))
+#define SCG_HWA_SetSircDiv(u32Val)      SCG_TRACE_SET(SCG_HWA_SetSircDiv, SCG_TRACE_REG_SIRCDIV, (u32Val))
+#define SCG_HWA_SetSircTcfg(u32Val)     SCG_TRACE_SET(SCG_HWA_SetSircTcfg, SCG_TRACE_REG_SIRCTCFG, (u32Val))
+#define SCG_HWA_SetSirc32kCsr(u32Val)   SCG_TRACE_SET(SCG_HWA_SetSirc32kCsr, SCG_TRACE_REG_SIRC32KCSR, (u32Val))
+#define SCG_HWA_SetFoscCsr(u32Val)      SCG_TRACE_SET(SCG_HWA_SetFoscCsr, SCG_TRACE_REG_FOSCCSR, (u32Val))
+#define SCG_HWA_SetFoscDiv(u32Val)      SCG_TRACE_SET(SCG_HWA_SetFoscDiv, SCG_TRACE_REG_FOSCDIV, (u32Val))
+#define SCG_HWA_SetFoscCfg(u32Val)      SCG_TRACE_SET(SCG_HWA_SetFoscCfg, SCG_TRACE_REG_FOSCCFG, (u32Val))
+#define SCG_HWA_SetSoscCcr(u32Val)      SCG_TRACE_SET(SCG_HWA_SetSoscCcr, SCG_TRACE_REG_SOSCCSR, (u32Val))
+#define SCG_HWA_SetSoscCfg(u32Val)      SCG_TRACE_SET(SCG_HWA_SetSoscCfg, SCG_TRACE_REG_SOSCCFG, (u32Val))
+#define SCG_HWA_SetPll0Csr(u32Val)      SCG_TRACE_SET(SCG_HWA_SetPll0Csr, SCG_TRACE_REG_PLL0CSR, (u32Val))
+#define SCG_HWA_SetPll0Div(u32Val)      SCG_TRACE_SET(SCG_HWA_SetPll0Div, SCG_TRACE_REG_PLL0DIV, (u32Val))
+#define SCG_HWA_SetPll0Cfg(u32Val)      SCG_TRACE_SET(SCG_HWA_SetPll0Cfg, SCG_TRACE_REG_PLL0CFG, (u32Val))
+#define SCG_HWA_EnableFircDiv()   SCG_TRACE_MODIFY(SCG_HWA_EnableFircDiv, SCG_TRACE_REG_FIRCDIV, SCG->FIRCDIV)
+#define SCG_HWA_DiableFircDiv()   SCG_TRACE_MODIFY(SCG_HWA_DiableFircDiv, SCG_TRACE_REG_FIRCDIV, SCG->FIRCDIV)
+#define SCG_HWA_DisableFirc()     SCG_TRACE_MODIFY(SCG_HWA_DisableFirc, SCG_TRACE_REG_FIRCCSR, SCG->FIRCCSR)
+#define SCG_HWA_EnableSircDiv()   SCG_TRACE_MODIFY(SCG_HWA_EnableSircDiv, SCG_TRACE_REG_SIRCDIV, SCG->SIRCDIV)
+#define SCG_HWA_DiableSircDiv()   SCG_TRACE_MODIFY(SCG_HWA_DiableSircDiv, SCG_TRACE_REG_SIRCDIV, SCG->SIRCDIV)
+#define SCG_HWA_EnableFoscDiv()   SCG_TRACE_MODIFY(SCG_HWA_EnableFoscDiv, SCG_TRACE_REG_FOSCDIV, SCG->FOSCDIV)
+#define SCG_HWA_DiableFoscDiv()   SCG_TRACE_MODIFY(SCG_HWA_DiableFoscDiv, SCG_TRACE_REG_FOSCDIV, SCG->FOSCDIV)
+#define SCG_HWA_DisableFosc()     SCG_TRACE_MODIFY(SCG_HWA_DisableFosc, SCG_TRACE_REG_FOSCCSR, SCG->FOSCCSR)
+#define SCG_HWA_DisableSosc()     SCG_TRACE_MODIFY(SCG_HWA_DisableSosc, SCG_TRACE_REG_SOSCCSR, SCG->SOSCCSR)
+#define SCG_HWA_EnablePll0Div()   SCG_TRACE_MODIFY(SCG_HWA_EnablePll0Div, SCG_TRACE_REG_PLL0DIV, SCG->PLL0DIV)
+#define SCG_HWA_DiablePll0Div()   SCG_TRACE_MODIFY(SCG_HWA_DiablePll0Div, SCG_TRACE_REG_PLL0DIV, SCG->PLL0DIV)
+#define SCG_HWA_UnlockPll0()      SCG_TRACE_MODIFY(SCG_HWA_UnlockPll0, SCG_TRACE_REG_PLL0CSR, SCG->PLL0CSR)
+#define SCG_HWA_DisablePll0()     SCG_TRACE_MODIFY(SCG_HWA_DisablePll0, SCG_TRACE_REG_PLL0CSR, SCG->PLL0CSR)
+#endif
+
+/* ################################################################################## */
+/* ################################### Type define ################################## */
+typedef struct
+{
+    bool bPrepared;
+    bool bIdle;
+    uint32_t u32IdleCcr;
+    uint32_t u32RunCcr;
+    SCG_RunClockType eRunClock;
+    SCG_ClockInfoType tIdleInfo[3];
+    SCG_ClockInfoType tRunInfo[3];
+    SCG_IdleStatsType tStats;
+} SCG_IdleGovernorType;
+
+typedef struct
+{
+    uint32_t u32Magic;
+    uint8_t au8Count[3U];
+    uint8_t au8Next[3U];
+    uint8_t au8Degraded[3U];
+    uint8_t u8Reserved[3U];
+    uint32_t au32Sample[3U][SCG_STARTUP_HISTORY_LEN];
+    uint32_t u32Crc;
+} SCG_StartupHistoryType;
+
+typedef struct
+{
+    bool bHashValid;
+    uint32_t u32Hash;                   /**< hash of the registers s_tClockSequenceInfo was built from */
+    uint32_t u32FoscFreq;               /**< last known FOSC crystal frequency, not readable from SCG */
+    uint32_t u32SoscFreq;               /**< last known SOSC crystal frequency, not readable from SCG */
+    SCG_AuditNotifyCallBackType pNotify;
+} SCG_AuditType;
+
+typedef struct
+{
+    uint32_t u32Count;                  /**< SCG_AcquireNvmClockBoost calls not yet released */
+    uint32_t u32SavedNvmClk;            /**< CLKOUTCFG NVMCLK bits restored by the last release */
+} SCG_NvmBoostType;
+
+typedef struct
+{
+    bool bEnabled;
+    uint32_t u32LastTime;               /**< SCG_RESIDENCY_TIMESTAMP() of the last update */
+    uint32_t u32OscOn;                  /**< bit n set when oscillator n of s_pResidencyOscCsr is enabled */
+    uint32_t u32SwitchCycles;           /**< CCR switch time since the last update */
+    SCG_ResidencyStatsType tStats;
+} SCG_ResidencyType;
+
+typedef enum
+{
+    SCG_ASYNC_IDLE = 0U,
+    SCG_ASYNC_SOSC_VALID,
+    SCG_ASYNC_SOSC_OFF,
+    SCG_ASYNC_FOSC_VALID,
+    SCG_ASYNC_FOSC_DIV_OFF,
+    SCG_ASYNC_FOSC_DIV_ON,
+    SCG_ASYNC_FOSC_OFF,
+    SCG_ASYNC_PLL0_LOCK,
+    SCG_ASYNC_PLL0_DIV_OFF,
+    SCG_ASYNC_PLL0_DIV_ON,
+    SCG_ASYNC_PLL0_OFF,
+    SCG_ASYNC_DONE
+} SCG_AsyncPhaseType;
+
+typedef enum
+{
+    SCG_ASYNCJOB_SOSC = 0U,
+    SCG_ASYNCJOB_FOSC,
+    SCG_ASYNCJOB_PLL0,
+    SCG_ASYNCJOB_CLKCTRL
+} SCG_AsyncJobKindType;
+
+typedef struct
+{
+    SCG_AsyncPhaseType ePhase;
+    SCG_AsyncJobKindType eKind;
+    SCG_StatusType eStatus;
+    uint32_t u32Start;
+    uint32_t u32Deadline;
+    uint32_t u32Budget;
+    SCG_AsyncDoneCallBackType pDone;
+    void *pContext;
+    union
+    {
+        SCG_SoscType tSosc;
+        SCG_FoscType tFosc;
+        SCG_Pll0Type tPll0;
+    } uCfg;
+} SCG_AsyncJobType;
+
+/* completion of a job started by a blocking setter, filled by whichever context delivers it */
+typedef struct
+{
+    volatile bool bDone;
+    volatile SCG_StatusType eStatus;
+} SCG_AsyncWaitType;
+
 /* ################################################################################## */
 /* ################################ Local Variables ################################# */
 static SCG_ClockSequenceType s_tClockSequenceInfo =
@@ -47,15 +218,97 @@ static SCG_ClockSequenceType s_tClockSequenceInfo =
     .eRunClock = SCG_RUNCLOCK_NONE,
 };
 
-static SCG_CLockError_CallBackType s_SircClkErrNotify;
-static SCG_CLockError_CallBackType s_SoscClkErrNotify;
-static SCG_CLockError_CallBackType s_FoscClkErrNotify;
-static SCG_CLockError_CallBackType s_Pll0ClkErrNotify;
-static SCG_CLockError_CallBackType s_FircClkErrNotify;
+/* SCG_PROBE_xxx groups of s_tClockSequenceInfo read from the registers, the others are unknown */
+static uint32_t s_u32ProbedClocks;
+
+/* clock error notifications and clock monitor events, indexed like s_eMonitorNode */
+static SCG_CLockError_CallBackType s_pClkErrNotify[5U];
+static SCG_ClockMonitorStatsType s_tMonitorStats[5U];
+
+static SCG_IdleGovernorType s_tIdleGovernor;
+
+static SCG_TimebaseType s_tTimebase;
+
+static SCG_RampCfgType s_tRamp;
+
+static SCG_AuditType s_tAudit;
+
+static SCG_NvmBoostType s_tNvmBoost;
+
+static SCG_ResidencyType s_tResidency;
+
+#ifdef SCG_TRACE_ENABLE
+static volatile uint32_t s_u32TraceHead;
+static SCG_TraceEntryType s_tTraceEntry[SCG_TRACE_LEN];
+#endif
+
+static SCG_FoscTuneType s_tFoscTune = SCG_FOSC_TUNE_DEFAULT;
+static SCG_SoscTuneType s_tSoscTune = SCG_SOSC_TUNE_DEFAULT;
+
+static SCG_AsyncJobType s_tAsyncJob;
+
+/* startup history survives warm resets, SCG_RETAINED_ATTR must map to memory not cleared at boot */
+static SCG_StartupHistoryType s_tStartupHistory SCG_RETAINED_ATTR;
+static SCG_StartupDegradeCallBackType s_pStartupDegradeNotify;
+
+/* clock node of each startup history slot */
+static const SCG_ClkSrcType s_eStartupNode[3U] =
+{
+    SCG_FOSC_CLK, SCG_SOSC_CLK, SCG_PLL0_CLK
+};
+
+/* clock node of each async divider output, SCG_END_OF_CLOCKS if the output is not tracked */
+static const SCG_ClkSrcType s_eAsyncDivNode[4U][3U] =
+{
+    {SCG_FIRCDIVH_CLK, SCG_FIRCDIVM_CLK, SCG_END_OF_CLOCKS},
+    {SCG_SIRCDIVH_CLK, SCG_SIRCDIVM_CLK, SCG_END_OF_CLOCKS},
+    {SCG_FOSCDIVH_CLK, SCG_FOSCDIVM_CLK, SCG_FOSCDIVL_CLK},
+    {SCG_PLL0DIVH_CLK, SCG_PLL0DIVM_CLK, SCG_END_OF_CLOCKS}
+};
+
+/* clock node of each s_pClkErrNotify and s_tMonitorStats slot, in SCG_IRQHandler dispatch order */
+static const SCG_ClkSrcType s_eMonitorNode[5U] = {SCG_CLOCK_ERROR_PRIORITY};
+
+/* SCG_CLOCK_ERROR_PRIORITY must name exactly five nodes covering every monitored source */
+#define SCG_MONITOR_BIT(eNode)              (1ULL << (uint32_t)(eNode))
+#define SCG_MONITOR_MASK_5(a, b, c, d, e)   (SCG_MONITOR_BIT(a) | SCG_MONITOR_BIT(b) | SCG_MONITOR_BIT(c) | \
+                                             SCG_MONITOR_BIT(d) | SCG_MONITOR_BIT(e))
+#define SCG_MONITOR_MASK(...)               SCG_MONITOR_MASK_5(__VA_ARGS__)
+typedef char SCG_MonitorPriorityCheckType[(SCG_MONITOR_MASK(SCG_CLOCK_ERROR_PRIORITY) ==
+                                           SCG_MONITOR_MASK_5(SCG_PLL0_CLK, SCG_FOSC_CLK, SCG_SOSC_CLK,
+                                                   SCG_FIRC_CLK, SCG_SIRC_CLK)) ? 1 : -1];
+
+/* control register and enable bit of each residency oscillator, in SCG_RESIDENCY_OSC_NUM order */
+static volatile uint32_t * const s_pResidencyOscCsr[SCG_RESIDENCY_OSC_NUM] =
+{
+    &SCG->FIRCCSR, &SCG->SIRCCSR, &SCG->SIRC32KCSR, &SCG->FOSCCSR, &SCG->SOSCCSR, &SCG->PLL0CSR
+};
+static const uint32_t s_u32ResidencyOscEn[SCG_RESIDENCY_OSC_NUM] =
+{
+    SCG_FIRCCSR_EN_MASK, SCG_SIRCCSR_EN_MASK, SCG_SIRC32KCSR_EN_MASK,
+    SCG_FOSCCSR_EN_MASK, SCG_SOSCCSR_EN_MASK, SCG_PLL0CSR_EN_MASK
+};
+
+/* source clock node of each row of s_tSeqDivField */
+static const SCG_ClkSrcType s_eAsyncDivSrc[4U] =
+{
+    SCG_FIRC_CLK, SCG_SIRC_CLK, SCG_FOSC_CLK, SCG_PLL0_CLK
+};
 
 
 /* ################################################################################## */
 /* ########################### Local Prototype Functions ############################ */
+static SCG_StatusType SCG_ApplyClkCtrl(const SCG_ClockCtrlType *pSysClkConfig);
+static uint8_t SCG_GetMonitorSlot(SCG_ClkSrcType eNode);
+static void SCG_SetMonitorNotify(SCG_ClkSrcType eNode, SCG_CLockError_CallBackType pNotify);
+#ifdef SCG_TRACE_ENABLE
+SCG_NOINLINE static SCG_RAMFUNC void SCG_TraceRecord(SCG_TraceRegType eReg, SCG_TraceOpType eOp, uint32_t u32Value);
+#endif
+
+/* bring-up sequences shared with fc4xxx_driver_scg_early.c, expanded with the SCG_HWA_xxx accessors
+ * and trace wrappers defined above */
+#define SCG_SEQ_FUNC    static SCG_RAMFUNC
+#include "fc4xxx_driver_scg_seq.h"
 
 
 /* ################################################################################## */
@@ -64,6 +317,175 @@ static SCG_CLockError_CallBackType s_FircClkErrNotify;
 /* ################################################################################## */
 /* ################################ Local Functions  ################################ */
 
+#ifdef SCG_TRACE_ENABLE
+/**
+ * @brief Append one entry to the trace ring, the slot is claimed with LDREX/STREX so writes from
+ *        thread and interrupt context never share a slot. The oldest entries are overwritten.
+ *        Called from the SCG_RAMFUNC switching routines, so it is placed with them and only touches
+ *        the ring in RAM, a traced write never fetches from flash in the middle of a clock switch.
+ */
+SCG_NOINLINE static SCG_RAMFUNC void SCG_TraceRecord(SCG_TraceRegType eReg, SCG_TraceOpType eOp, uint32_t u32Value)
+{
+    uint32_t u32Seq;
+    SCG_TraceEntryType *pEntry;
+
+    do
+    {
+        u32Seq = __LDREXW(&s_u32TraceHead);
+    } while (__STREXW(u32Seq + 1U, &s_u32TraceHead) != 0U);
+
+    pEntry = &s_tTraceEntry[u32Seq & (SCG_TRACE_LEN - 1U)];
+    pEntry->u32Cycles = SCG_GET_CYCLES();
+    pEntry->u32Caller = SCG_RETURN_ADDRESS();
+    pEntry->u32Value = u32Value;
+    pEntry->u16Seq = (uint16_t)u32Seq;
+    pEntry->u8Reg = (uint8_t)eReg;
+    pEntry->u8Op = (uint8_t)eOp;
+}
+#endif
+
+/**
+ * @brief Enabled oscillators, bit n for entry n of s_pResidencyOscCsr.
+ */
+static uint32_t SCG_ResidencyGetOscOn(void)
+{
+    uint32_t u32Index;
+    uint32_t u32OscOn = 0U;
+
+    for (u32Index = 0U; u32Index < SCG_RESIDENCY_OSC_NUM; u32Index++)
+    {
+        if ((*s_pResidencyOscCsr[u32Index] & s_u32ResidencyOscEn[u32Index]) != 0U)
+        {
+            u32OscOn |= (uint32_t)1U << u32Index;
+        }
+    }
+
+    return u32OscOn;
+}
+
+/**
+ * @brief Profile of the run clock in s_tClockSequenceInfo and the CCR dividers, a new profile is
+ *        added while tProfile has room.
+ * @return index in tProfile, SCG_RESIDENCY_PROFILES if the profile is not listed
+ */
+static uint32_t SCG_ResidencyFindProfile(void)
+{
+    SCG_ResidencyProfileType *pProfile;
+    uint32_t u32Index = 0U;
+    bool bFound = false;
+    uint8_t u8DivCore = SCG_HWA_GetSysClkDivCore();
+    uint8_t u8DivBus = SCG_HWA_GetSysClkDivBus();
+    uint8_t u8DivSlow = SCG_HWA_GetSysClkDivSlow();
+    uint32_t u32CoreFreq = s_tClockSequenceInfo.tClockInfo[SCG_CORE_CLK].u32Freq;
+
+    while ((bFound == false) && (u32Index < s_tResidency.tStats.u32ProfileNum))
+    {
+        pProfile = &s_tResidency.tStats.tProfile[u32Index];
+        if ((pProfile->eRunClock == s_tClockSequenceInfo.eRunClock) && (pProfile->u8DivCore == u8DivCore) &&
+                (pProfile->u8DivBus == u8DivBus) && (pProfile->u8DivSlow == u8DivSlow) &&
+                (pProfile->u32CoreFreq == u32CoreFreq))
+        {
+            bFound = true;
+        }
+        else
+        {
+            u32Index++;
+        }
+    }
+
+    if ((bFound == false) && (u32Index < SCG_RESIDENCY_PROFILES))
+    {
+        pProfile = &s_tResidency.tStats.tProfile[u32Index];
+        pProfile->eRunClock = s_tClockSequenceInfo.eRunClock;
+        pProfile->u8DivCore = u8DivCore;
+        pProfile->u8DivBus = u8DivBus;
+        pProfile->u8DivSlow = u8DivSlow;
+        pProfile->u32CoreFreq = u32CoreFreq;
+        pProfile->u32Entries = 0U;
+        pProfile->u64Time = 0U;
+        s_tResidency.tStats.u32ProfileNum++;
+    }
+
+    return u32Index;
+}
+
+/**
+ * @brief Charge the time since the last update to the current profile and the enabled oscillators,
+ *        then pick up oscillator enables and, with bRunClock set, a change of the run profile.
+ *        Called after every clock tree refresh, bRunClock only once the CORE/BUS/SLOW nodes are final.
+ */
+static void SCG_ResidencyUpdate(bool bRunClock)
+{
+    uint32_t u32Primask;
+    uint32_t u32Now;
+    uint32_t u32Delta;
+    uint32_t u32Index;
+    uint32_t u32OscOn;
+    SCG_ResidencyStatsType *pStats = &s_tResidency.tStats;
+
+    /* bEnabled only goes false inside SCG_ClearResidencyStats's critical section, so it can be tested
+       before entering one and a refresh without accounting never masks interrupts */
+    if (s_tResidency.bEnabled == true)
+    {
+        SCG_ENTER_CRITICAL(u32Primask);
+
+        u32Now = SCG_RESIDENCY_TIMESTAMP();
+        u32Delta = u32Now - s_tResidency.u32LastTime;
+        s_tResidency.u32LastTime = u32Now;
+
+        pStats->u64Elapsed += u32Delta;
+        if (pStats->u32Current < SCG_RESIDENCY_PROFILES)
+        {
+            pStats->tProfile[pStats->u32Current].u64Time += u32Delta;
+        }
+        else
+        {
+            pStats->u64UnlistedTime += u32Delta;
+        }
+
+        u32OscOn = SCG_ResidencyGetOscOn();
+        for (u32Index = 0U; u32Index < SCG_RESIDENCY_OSC_NUM; u32Index++)
+        {
+            if ((s_tResidency.u32OscOn & ((uint32_t)1U << u32Index)) != 0U)
+            {
+                pStats->au64OscTime[u32Index] += u32Delta;
+            }
+            else if ((u32OscOn & ((uint32_t)1U << u32Index)) != 0U)
+            {
+                pStats->au32OscEnables[u32Index]++;
+            }
+            else
+            {
+            }
+        }
+        s_tResidency.u32OscOn = u32OscOn;
+
+        if (bRunClock == true)
+        {
+            u32Index = SCG_ResidencyFindProfile();
+            if (u32Index != pStats->u32Current)
+            {
+                pStats->u32Current = u32Index;
+                if (u32Index < SCG_RESIDENCY_PROFILES)
+                {
+                    pStats->tProfile[u32Index].u32Entries++;
+                }
+                pStats->u32Transitions++;
+                pStats->u32LastSwitchCycles = s_tResidency.u32SwitchCycles;
+                pStats->u64TotalSwitchCycles += s_tResidency.u32SwitchCycles;
+                if (s_tResidency.u32SwitchCycles > pStats->u32MaxSwitchCycles)
+                {
+                    pStats->u32MaxSwitchCycles = s_tResidency.u32SwitchCycles;
+                }
+            }
+            /* switches that end in the same profile are not a transition */
+            s_tResidency.u32SwitchCycles = 0U;
+        }
+
+        SCG_EXIT_CRITICAL(u32Primask);
+    }
+}
+
 static void SCG_SetFircClockStatus(void)
 {
     bool bStatus;
@@ -90,6 +512,8 @@ static void SCG_SetFircClockStatus(void)
         s_tClockSequenceInfo.tClockInfo[SCG_FIRCDIVM_CLK].eClkStatus = SCG_CLOCK_DISABLE;
         s_tClockSequenceInfo.tClockInfo[SCG_FIRCDIVM_CLK].u32Freq = 0U;
     }
+    s_u32ProbedClocks |= SCG_PROBE_FIRC;
+    SCG_ResidencyUpdate(false);
 }
 
 static void SCG_SetSircClockStatus(void)
@@ -119,6 +543,8 @@ static void SCG_SetSircClockStatus(void)
         s_tClockSequenceInfo.tClockInfo[SCG_SIRCDIVM_CLK].eClkStatus = SCG_CLOCK_DISABLE;
         s_tClockSequenceInfo.tClockInfo[SCG_SIRCDIVM_CLK].u32Freq = 0U;
     }
+    s_u32ProbedClocks |= SCG_PROBE_SIRC;
+    SCG_ResidencyUpdate(false);
 }
 
 static void SCG_SetSirc32kClockStatus(void)
@@ -137,7 +563,8 @@ static void SCG_SetSirc32kClockStatus(void)
         s_tClockSequenceInfo.tClockInfo[SCG_SIRC32K_CLK].eClkStatus = SCG_CLOCK_DISABLE;
         s_tClockSequenceInfo.tClockInfo[SCG_SIRC32K_CLK].u32Freq = 0U;
     }
-
+    s_u32ProbedClocks |= SCG_PROBE_SIRC32K;
+    SCG_ResidencyUpdate(false);
 }
 
 static void SCG_SetFoscClockStatus(uint32_t u32FoscFreq)
@@ -172,6 +599,8 @@ static void SCG_SetFoscClockStatus(uint32_t u32FoscFreq)
         s_tClockSequenceInfo.tClockInfo[SCG_FOSCDIVL_CLK].eClkStatus = SCG_CLOCK_DISABLE;
         s_tClockSequenceInfo.tClockInfo[SCG_FOSCDIVL_CLK].u32Freq = 0U;
     }
+    s_u32ProbedClocks |= SCG_PROBE_FOSC;
+    SCG_ResidencyUpdate(false);
 }
 
 static void SCG_SetSoscClockStatus(uint32_t u32SoscFreq)
@@ -190,6 +619,51 @@ static void SCG_SetSoscClockStatus(uint32_t u32SoscFreq)
         s_tClockSequenceInfo.tClockInfo[SCG_SOSC_CLK].eClkStatus = SCG_CLOCK_DISABLE;
         s_tClockSequenceInfo.tClockInfo[SCG_SOSC_CLK].u32Freq = 0U;
     }
+    s_u32ProbedClocks |= SCG_PROBE_SOSC;
+    SCG_ResidencyUpdate(false);
+}
+
+/**
+ * @brief Read a root source node from the registers if it was not probed yet.
+ * @param eNode: SCG_FIRC_CLK, SCG_SIRC_CLK, SCG_SIRC32K_CLK, SCG_FOSC_CLK or SCG_SOSC_CLK
+ */
+static void SCG_ProbeRootNode(SCG_ClkSrcType eNode)
+{
+    switch (eNode)
+    {
+    case SCG_FIRC_CLK:
+        if ((s_u32ProbedClocks & SCG_PROBE_FIRC) == 0U)
+        {
+            SCG_SetFircClockStatus();
+        }
+        break;
+    case SCG_SIRC_CLK:
+        if ((s_u32ProbedClocks & SCG_PROBE_SIRC) == 0U)
+        {
+            SCG_SetSircClockStatus();
+        }
+        break;
+    case SCG_SIRC32K_CLK:
+        if ((s_u32ProbedClocks & SCG_PROBE_SIRC32K) == 0U)
+        {
+            SCG_SetSirc32kClockStatus();
+        }
+        break;
+    case SCG_FOSC_CLK:
+        if ((s_u32ProbedClocks & SCG_PROBE_FOSC) == 0U)
+        {
+            SCG_SetFoscClockStatus((uint32_t)UNKNOWN_CLOCK);
+        }
+        break;
+    case SCG_SOSC_CLK:
+        if ((s_u32ProbedClocks & SCG_PROBE_SOSC) == 0U)
+        {
+            SCG_SetSoscClockStatus((uint32_t)UNKNOWN_CLOCK);
+        }
+        break;
+    default:
+        break;
+    }
 }
 
 static void SCG_SetPll0ClockStatus(void)
@@ -199,6 +673,9 @@ static void SCG_SetPll0ClockStatus(void)
     bool bStatus;
     uint32_t u32DivRegVal = 0U;
 
+    /* the reference clock node is read below */
+    SCG_ProbeRootNode((SCG_HWA_GetPll0Src() == SCG_PLL0SOURCE_FIRC) ? SCG_FIRC_CLK : SCG_FOSC_CLK);
+
     /* check if PLL0 is valid, then set s_tScgClockInfo[SCG_PLL0_CLK] to valid value */
     bStatus = SCG_HWA_GetPll0Valid();
     if (bStatus == true)
@@ -207,11 +684,11 @@ static void SCG_SetPll0ClockStatus(void)
         u8Temp = SCG_HWA_GetPll0Src();
         if ((u8Temp == SCG_PLL0SOURCE_FIRC) && (s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].eClkStatus == SCG_CLOCK_VALID))
         {
-            u32Temp = s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].u32Freq >> 1U; /* Freq / 2*/
+            u32Temp = s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].u32Freq;
         }
         else if ((u8Temp == SCG_PLL0SOURCE_FOSC) && (s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].eClkStatus == SCG_CLOCK_VALID))
         {
-            u32Temp = s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].u32Freq >> 1U; /* Freq / 2*/
+            u32Temp = s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].u32Freq;
         }
         else
         {
@@ -220,7 +697,8 @@ static void SCG_SetPll0ClockStatus(void)
 
         u8Mult = SCG_HWA_GetPll0Mult();
         u8Prediv = SCG_HWA_GetPll0Prediv();
-        u32Temp = u32Temp / (u8Prediv + 1U) * (u8Mult + 16U);
+        /* the node holds the floor of the exact PLL0 frequency */
+        u32Temp = SCG_CalcPll0NodeFreq(u32Temp, u8Prediv, u8Mult);
         s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].eClkStatus = SCG_CLOCK_VALID;
         s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].u32Freq = u32Temp;
 
@@ -241,6 +719,8 @@ static void SCG_SetPll0ClockStatus(void)
         s_tClockSequenceInfo.tClockInfo[SCG_PLL0DIVM_CLK].eClkStatus = SCG_CLOCK_DISABLE;
         s_tClockSequenceInfo.tClockInfo[SCG_PLL0DIVM_CLK].u32Freq = 0U;
     }
+    s_u32ProbedClocks |= SCG_PROBE_PLL0;
+    SCG_ResidencyUpdate(false);
 }
 
 static void SCG_SetClockOutStatus(void)
@@ -256,26 +736,35 @@ static void SCG_SetClockOutStatus(void)
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].u32Freq = 0U;
         break;
     case SCG_CLOCKOUT_SRC_FOSC:
+        SCG_ProbeRootNode(SCG_FOSC_CLK);
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].eClkStatus = s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].eClkStatus;
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].u32Freq = s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].u32Freq;
         break;
     case SCG_CLOCKOUT_SRC_SIRC:
+        SCG_ProbeRootNode(SCG_SIRC_CLK);
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].eClkStatus = s_tClockSequenceInfo.tClockInfo[SCG_SIRC_CLK].eClkStatus;
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].u32Freq = s_tClockSequenceInfo.tClockInfo[SCG_SIRC_CLK].u32Freq;
         break;
     case SCG_CLOCKOUT_SRC_FIRC:
+        SCG_ProbeRootNode(SCG_FIRC_CLK);
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].eClkStatus = s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].eClkStatus;
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].u32Freq = s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].u32Freq;
         break;
     case SCG_CLOCKOUT_SRC_SOSC:
+        SCG_ProbeRootNode(SCG_SOSC_CLK);
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].eClkStatus = s_tClockSequenceInfo.tClockInfo[SCG_SOSC_CLK].eClkStatus;
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].u32Freq = s_tClockSequenceInfo.tClockInfo[SCG_SOSC_CLK].u32Freq;
         break;
     case SCG_CLOCKOUT_SRC_PLL0:
+        if ((s_u32ProbedClocks & SCG_PROBE_PLL0) == 0U)
+        {
+            SCG_SetPll0ClockStatus();
+        }
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].eClkStatus = s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].eClkStatus;
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].u32Freq = s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].u32Freq;
         break;
     case SCG_CLOCKOUT_SRC_SIRC32K:
+        SCG_ProbeRootNode(SCG_SIRC32K_CLK);
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].eClkStatus = s_tClockSequenceInfo.tClockInfo[SCG_SIRC32K_CLK].eClkStatus;
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].u32Freq = s_tClockSequenceInfo.tClockInfo[SCG_SIRC32K_CLK].u32Freq;
         break;
@@ -284,7 +773,7 @@ static void SCG_SetClockOutStatus(void)
         s_tClockSequenceInfo.tClockInfo[SCG_SCG_CLKOUT_CLK].u32Freq = 0U;
         break;
     }
-
+    s_u32ProbedClocks |= SCG_PROBE_CLKOUT;
 }
 
 static void SCG_SetCoreClockStatus(void)
@@ -302,6 +791,7 @@ static void SCG_SetCoreClockStatus(void)
     s_tClockSequenceInfo.tClockInfo[SCG_SLOW_CLK].u32Freq = UNKNOWN_CLOCK;
     if (u8Temp == SCG_CLOCK_SRC_FIRC)
     {
+        SCG_ProbeRootNode(SCG_FIRC_CLK);
         if (s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].eClkStatus == SCG_CLOCK_VALID)
         {
             u8Div = SCG_HWA_GetSysClkDivCore();
@@ -312,6 +802,10 @@ static void SCG_SetCoreClockStatus(void)
     }
     else if (u8Temp == SCG_CLOCK_SRC_PLL0)
     {
+        if ((s_u32ProbedClocks & SCG_PROBE_PLL0) == 0U)
+        {
+            SCG_SetPll0ClockStatus();
+        }
         if ((s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].eClkStatus == SCG_CLOCK_VALID) &&
                 (s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].u32Freq != UNKNOWN_CLOCK))
         {
@@ -331,6 +825,7 @@ static void SCG_SetCoreClockStatus(void)
     }
     else if (u8Temp == SCG_CLOCK_SRC_FOSC)
     {
+        SCG_ProbeRootNode(SCG_FOSC_CLK);
         if ((s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].eClkStatus == SCG_CLOCK_VALID) &&
                 (s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].u32Freq != UNKNOWN_CLOCK))
         {
@@ -355,1123 +850,3781 @@ static void SCG_SetCoreClockStatus(void)
         u32Temp = s_tClockSequenceInfo.tClockInfo[SCG_CORE_CLK].u32Freq / (u8Div + 1U);
         s_tClockSequenceInfo.tClockInfo[SCG_SLOW_CLK].u32Freq = u32Temp;
     }
-
+    s_u32ProbedClocks |= SCG_PROBE_CORE;
+    SCG_ResidencyUpdate(true);
 }
 
-/* ################################################################################## */
-/* ################################ Global Functions ################################ */
-
 /**
- * @brief Description SCG module maintains a list of SCG clock frequency and status.
- *  Which defined in global data instance as SCG_ClockInfoType s_tScgClockInfo[SCG_END_OF_CLOCKS],
- *  this function set all the clock source as SCG_CLOCK_UNDEFINE before clock set function called.
+ * @brief Read the SCG_PROBE_xxx groups of u32Mask not probed yet from the registers.
+ *        Each group also probes the nodes it is derived from, and only those.
  */
-void SCG_InitClockSrcStatus(void)
+static void SCG_ProbeClocks(uint32_t u32Mask)
 {
-    if (s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_NONE)
+    if ((u32Mask & SCG_PROBE_FIRC) != 0U)
+    {
+        SCG_ProbeRootNode(SCG_FIRC_CLK);
+    }
+    if ((u32Mask & SCG_PROBE_SIRC) != 0U)
+    {
+        SCG_ProbeRootNode(SCG_SIRC_CLK);
+    }
+    if ((u32Mask & SCG_PROBE_SIRC32K) != 0U)
+    {
+        SCG_ProbeRootNode(SCG_SIRC32K_CLK);
+    }
+    if ((u32Mask & SCG_PROBE_FOSC) != 0U)
+    {
+        SCG_ProbeRootNode(SCG_FOSC_CLK);
+    }
+    if ((u32Mask & SCG_PROBE_SOSC) != 0U)
+    {
+        SCG_ProbeRootNode(SCG_SOSC_CLK);
+    }
+    if ((u32Mask & ~s_u32ProbedClocks & SCG_PROBE_PLL0) != 0U)
     {
-        /* check if FIRC is valid, then set s_tScgClockInfo[SCG_FIRC_CLK] to valid value */
-        SCG_SetFircClockStatus();
-
-        /* check if SIRC is valid, then set s_tScgClockInfo[SCG_SIRC_CLK] to valid value */
-        SCG_SetSircClockStatus();
-
-        /* check if FOSC is valid, then set s_tScgClockInfo[SCG_FOSC_CLK] to valid value */
-        SCG_SetFoscClockStatus((uint32_t)UNKNOWN_CLOCK);
-
-        /* check if SIRC32K is valid, then set s_tScgClockInfo[SCG_SIRC32K_CLK] to valid value */
-        SCG_SetSirc32kClockStatus();
-
-        /* check if SOSC is valid, then set s_tScgClockInfo[SCG_SOSC_CLK] to valid value */
-        SCG_SetSoscClockStatus((uint32_t)UNKNOWN_CLOCK);
-
-        /* check if PLL0 is valid, then set s_tScgClockInfo[SCG_PLL0_CLK] to valid value */
         SCG_SetPll0ClockStatus();
-
-        /* check clock out configuration */
+    }
+    if ((u32Mask & ~s_u32ProbedClocks & SCG_PROBE_CLKOUT) != 0U)
+    {
         SCG_SetClockOutStatus();
-
-        /* check core clock configuration */
+    }
+    if ((u32Mask & ~s_u32ProbedClocks & SCG_PROBE_CORE) != 0U)
+    {
         SCG_SetCoreClockStatus();
     }
 }
 
 /**
- * @brief Set SOSC configuration.
- * @param pSoscConfig: pointer to the soccType structure variable, which defined SOSC initial information.
- * @return true or false. SOSC would wait for SOSC valid in while loop within pre-dinfined limited time to check the SOSC valid or not.
- *         If SOSC still not valid(this may happen if external Slow OSC not placed),  it would return fail
+ * @brief SCG_PROBE_xxx group holding a clock node, 0 for an unknown node.
  */
-SCG_StatusType SCG_SetSOSC(SCG_SoscType *pSoscConfig)
+static uint32_t SCG_GetProbeGroup(SCG_ClkSrcType eNode)
 {
-    SCG_StatusType eStatus;
-    uint32_t u32Temp;
-
-    /* if run clock is none, the function will init s_tClockSequenceInfo buffer first */
-    SCG_InitClockSrcStatus();
+    uint32_t u32Group;
 
-    /*            Set SOSC             */
-    if (pSoscConfig->bEnable == true)
+    switch (eNode)
     {
-        /* configure recommend value */
-        u32Temp = (uint32_t)(SCG_SOSCCFG_EOCV(64U) | SCG_SOSCCFG_GM_SEL(3U)  |
-                             SCG_SOSCCFG_CURPRG_SF(3U) | SCG_SOSCCFG_CURPRG_COMP(3U));
-        SCG_HWA_SetSoscCfg(u32Temp);
+    case SCG_FIRC_CLK:
+    case SCG_FIRCDIVH_CLK:
+    case SCG_FIRCDIVM_CLK:
+        u32Group = SCG_PROBE_FIRC;
+        break;
+    case SCG_SIRC_CLK:
+    case SCG_SIRCDIVH_CLK:
+    case SCG_SIRCDIVM_CLK:
+        u32Group = SCG_PROBE_SIRC;
+        break;
+    case SCG_SIRC32K_CLK:
+        u32Group = SCG_PROBE_SIRC32K;
+        break;
+    case SCG_FOSC_CLK:
+    case SCG_FOSCDIVH_CLK:
+    case SCG_FOSCDIVM_CLK:
+    case SCG_FOSCDIVL_CLK:
+        u32Group = SCG_PROBE_FOSC;
+        break;
+    case SCG_SOSC_CLK:
+        u32Group = SCG_PROBE_SOSC;
+        break;
+    case SCG_PLL0_CLK:
+    case SCG_PLL0DIVH_CLK:
+    case SCG_PLL0DIVM_CLK:
+        u32Group = SCG_PROBE_PLL0;
+        break;
+    case SCG_SCG_CLKOUT_CLK:
+        u32Group = SCG_PROBE_CLKOUT;
+        break;
+    case SCG_CORE_CLK:
+    case SCG_BUS_CLK:
+    case SCG_SLOW_CLK:
+        u32Group = SCG_PROBE_CORE;
+        break;
+    default:
+        u32Group = 0U;
+        break;
+    }
 
-        u32Temp = SCG->SOSCCSR;
-        /* unlock SOSC CSR register */
-        u32Temp &= ~(uint32_t)SCG_SOSCCSR_LK_MASK;
-        SCG_HWA_SetSoscCcr(u32Temp);
+    return u32Group;
+}
 
-        /* Enable SOSC and configure bypass configuration */
-        u32Temp &= ~(uint32_t)SCG_SOSCCSR_BYPASS_MASK;
-        u32Temp |= SCG_SOSCCSR_EN(1U) | SCG_SOSCCSR_BYPASS(pSoscConfig->bBypass);
-        SCG_HWA_SetSoscCcr(u32Temp);
+/**
+ * @brief Rescale the tick timer after the core clock changed, must be called with interrupts masked
+ *        right after the CCR switch and the CORE node update.
+ *        The built-in SysTick path carries the elapsed part of the current tick over to the new clock:
+ *        the remaining counts are scaled and loaded as a one-shot period, then the full reload value is
+ *        restored once the counter has reloaded, so no tick time is gained or lost by the switch.
+ * @param u32OldFreq: core clock frequency before the switch
+ */
+static void SCG_RescaleTimebase(uint32_t u32OldFreq)
+{
+    uint32_t u32NewFreq;
+    uint32_t u32Load;
+    uint32_t u32NewLoad;
+    uint32_t u32Remain;
+    uint32_t u32Temp;
 
-        /*         Check SIRC valid         */
-        u32Temp = SOSC_STABILIZATION_TIMEOUT;
-        while ((SCG_HWA_GetSoscValid() == false) && (u32Temp > 0U))
-        {
-            u32Temp--;
-        }
+    u32NewFreq = s_tClockSequenceInfo.tClockInfo[SCG_CORE_CLK].u32Freq;
 
-        if (u32Temp == 0U)
+    if ((u32NewFreq != u32OldFreq) && (u32NewFreq != UNKNOWN_CLOCK) && (u32OldFreq != UNKNOWN_CLOCK) &&
+            (u32NewFreq != 0U) && (u32OldFreq != 0U))
+    {
+        if (s_tTimebase.pTimebaseRescale != NULL)
         {
-            eStatus = SCG_CLOCK_TIMEOUT;
+            s_tTimebase.pTimebaseRescale(u32OldFreq, u32NewFreq);
         }
-        else
+        else if ((s_tTimebase.u32TickRateHz != 0U) &&
+                 ((SysTick->CTRL & (SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_CLKSOURCE_Msk)) ==
+                  (SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_CLKSOURCE_Msk)))
         {
-            u32Temp = SCG->SOSCCSR;
-            /* Configure CM CMRE and lock  */
-            u32Temp |= SCG_SOSCCSR_CM(pSoscConfig->bCm);
-            SCG_HWA_SetSoscCcr(u32Temp);
+            u32Load = SysTick->LOAD;
+            u32NewLoad = u32NewFreq / s_tTimebase.u32TickRateHz - 1U;
+            if (u32NewLoad > SysTick_LOAD_RELOAD_Msk)
+            {
+                u32NewLoad = SysTick_LOAD_RELOAD_Msk;
+            }
 
-            u32Temp &= ~(uint32_t)SCG_SOSCCSR_CMRE_MASK;
-            u32Temp |= SCG_SOSCCSR_CMRE(pSoscConfig->bCmre) |
-                       SCG_SOSCCSR_LK(pSoscConfig->bLock);
-            SCG_HWA_SetSoscCcr(u32Temp);
+            /* remaining counts of the current tick, expressed in new clock cycles */
+            u32Remain = (uint32_t)(((uint64_t)SysTick->VAL * ((uint64_t)u32NewLoad + 1U)) / ((uint64_t)u32Load + 1U));
 
-            eStatus = SCG_CLOCK_VALID;
+            if (u32Remain < SYSTICK_MIN_CARRY_COUNT)
+            {
+                /* too close to the tick boundary to carry, pend the due tick and start a full period */
+                SCB->ICSR = SCB_ICSR_PENDSTSET_Msk;
+                SysTick->LOAD = u32NewLoad;
+                SysTick->VAL = 0U;
+            }
+            else
+            {
+                SysTick->LOAD = u32Remain - 1U;
+                SysTick->VAL = 0U;
+                u32Temp = SYSTICK_RELOAD_TIMEOUT;
+                while ((SysTick->VAL == 0U) && (u32Temp > 0U))
+                {
+                    u32Temp--;
+                }
+                SysTick->LOAD = u32NewLoad;
+            }
         }
-    }
-    else
-    {
-        SCG_HWA_DisableSosc();
-        eStatus = SCG_CLOCK_DISABLE;
-        u32Temp = CLOCK_OFF_STABILIZATION_TIMEOUT;
-        while ((SCG_HWA_GetSoscValid() == true) && (u32Temp > 0U))
+        else
         {
-            u32Temp--;
+            /* tick timer not clocked from the core clock, nothing to do */
         }
     }
+}
+
+static uint16_t SCG_GetIrcTrimDiv(uint8_t u8TrimSrc)
+{
+    uint16_t u16TrimDiv;
 
-    if((true == pSoscConfig->bCm) && (false == pSoscConfig->bCmre))
+    if (u8TrimSrc == SCG_IRC_TRIMSRC_FOSC)
+    {
+        /*   Trim clock source choose FOSC   */
+        SCG_ProbeRootNode(SCG_FOSC_CLK);
+        u16TrimDiv = (uint16_t)(s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].u32Freq / 1000000U - 1U);
+    }
+    else if (u8TrimSrc == SCG_IRC_TRIMSRC_SOSC)
     {
-        s_SoscClkErrNotify = pSoscConfig->pSoscClockErrorNotify;
+        /*   Trim clock source choose SOSC   */
+        u16TrimDiv = 0U;
+    }
+    else
+    {
+        /*   do nothing   */
+        u16TrimDiv = 0U;
     }
 
+    return u16TrimDiv;
+}
 
-    /* set SOSC configuration information */
-    SCG_SetSoscClockStatus(pSoscConfig->u32XtalFreq);
+static uint32_t SCG_GetFircTcfgValue(const SCG_FircType *pFircConfig)
+{
+    /* Setting the SAMPLE bit and enabling DELAY means more sampling time and longer calibration time,
+     * which leads to more accurate calibration. */
+    return (uint32_t)(SCG_FIRCTCFG_TRIMSRC(pFircConfig->u8TrimSrc) |
+                      SCG_FIRCTCFG_TRIMDIV(SCG_GetIrcTrimDiv(pFircConfig->u8TrimSrc)) |
+                      SCG_FIRCTCFG_SAMPLE_MASK |
+                      SCG_FIRCTCFG_DELAY_MASK);
+}
 
-    return eStatus;
+static uint32_t SCG_GetSircTcfgValue(const SCG_SircType *pSircConfig)
+{
+    /* Setting the SAMPLE bit and enabling DELAY means more sampling time and longer calibration time,
+     * which leads to more accurate calibration. */
+    return (uint32_t)(SCG_SIRCTCFG_TRIMSRC(pSircConfig->u8TrimSrc) |
+                      SCG_SIRCTCFG_TRIMDIV(SCG_GetIrcTrimDiv(pSircConfig->u8TrimSrc)) |
+                      SCG_SIRCTCFG_SAMPLE_MASK |
+                      SCG_SIRCTCFG_DELAY_MASK);
+}
+
+static uint32_t SCG_GetFoscCfgValue(bool bBypass)
+{
+    /* EOCV, GM_SEL, ALC_D and HYST_D come from SCG_SetFoscTuning, default GM_SEL is the max value 15U */
+    return SCG_SeqFoscCfgValue(bBypass, &s_tFoscTune);
+}
+
+static uint32_t SCG_GetSoscCfgValue(void)
+{
+    return (uint32_t)(SCG_SOSCCFG_EOCV(s_tSoscTune.u8Eocv) | SCG_SOSCCFG_GM_SEL(s_tSoscTune.u8GmSel)  |
+                      SCG_SOSCCFG_CURPRG_SF(s_tSoscTune.u8CurprgSf) | SCG_SOSCCFG_CURPRG_COMP(s_tSoscTune.u8CurprgComp));
 }
 
 /**
- * \brief Set FOSC configuration
- *
- * \param pFoscConfig: pointer to the FOSCType structure data instance, which defined FOSC initial information.
- * \return  true or false. FOSCwould wait for FOSC valid in while loop within pre-dinfined limited time to check the FOSC valid or not.
- *          If FOSC still not valid(this may happen if external Fast OSC not placed),  it would return fail.
+ * @brief Check the DIVH/DIVM/DIVL fields of an async divider register against the requested value,
+ *        all three dividers must also be enabled.
  */
-SCG_StatusType SCG_SetFOSC(SCG_FoscType *pFoscConfig)
+static bool SCG_IsAsyncDivConfigured(uint32_t u32DivRegVal, uint32_t u32DivMask, uint32_t u32DivVal)
 {
-    SCG_StatusType eStatus;
-    bool bComp_En = false;
-    uint32_t u32Temp = 0U;
+    return (((u32DivRegVal & u32DivMask) == u32DivVal) &&
+            (SCG_CHECK_DIVH_EN(u32DivRegVal) != 0U) &&
+            (SCG_CHECK_DIVM_EN(u32DivRegVal) != 0U) &&
+            (SCG_CHECK_DIVL_EN(u32DivRegVal) != 0U));
+}
 
-    /* if run clock is none, the function will init s_tClockSequenceInfo buffer first */
-    SCG_InitClockSrcStatus();
+/**
+ * @brief Check whether the requested FIRC configuration is already in effect in hardware.
+ */
+static bool SCG_IsFircConfigured(const SCG_FircType *pFircConfig)
+{
+    bool bResult;
+    uint32_t u32Mask;
+    uint32_t u32Val;
 
-    if (pFoscConfig->bEnable == true)
+    if (pFircConfig->bEnable == true)
     {
-        if (pFoscConfig->bBypass == true)
-        {
-            bComp_En = false;
-        }
-        else
-        {
-            bComp_En = true;
-        }
-
-        /* COMP_EN is setting to 1  COMP_EN must be 1 when using an external crystal */
-        /* Configure GM to the max value, GM_SEL: 15U */
-        u32Temp = SCG_FOSCCFG_BYPASS(pFoscConfig->bBypass) | SCG_FOSCCFG_COMP_EN(bComp_En) |
-                  SCG_FOSCCFG_EOCV(50U) | SCG_FOSCCFG_GM_SEL(15U) |
-                  SCG_FOSCCFG_ALC_D(1U) | SCG_FOSCCFG_HYST_D(0U);
-        SCG_HWA_SetFoscCfg(u32Temp);
-
-        u32Temp = SCG->FOSCCSR;
-        u32Temp &= ~(uint32_t)SCG_FOSCCSR_LK_MASK;
-        SCG_HWA_SetFoscCsr(u32Temp);
-
-        /* configure stop enable and enable FOSC */
-        u32Temp &= ~(uint32_t)SCG_FOSCCSR_STEN_MASK;
-        u32Temp |= SCG_FOSCCSR_EN(1U) | SCG_FOSCCSR_STEN(pFoscConfig->bSten);
-        SCG_HWA_SetFoscCsr(u32Temp);
-
-        /*               Check FOSC valid                       */
-
-        u32Temp = FOSC_STABILIZATION_TIMEOUT;
-        while ((SCG_HWA_GetFoscValid() == false) && (u32Temp > 0U))
-        {
-            u32Temp--;
-        }
-
-        if (u32Temp != 0U)
-        {
-            u32Temp = SCG->FOSCCSR;
-            /* Configure CM CMRE and lock */
-            u32Temp |= SCG_FOSCCSR_CM(pFoscConfig->bCm);
-            SCG_HWA_SetFoscCsr(u32Temp);
-
-            u32Temp &= ~(uint32_t)SCG_FOSCCSR_CMRE_MASK;
-            u32Temp |= SCG_FOSCCSR_CMRE(pFoscConfig->bCmre) | SCG_FOSCCSR_LK(pFoscConfig->bLock);
-            SCG_HWA_SetFoscCsr(u32Temp);
-
-            eStatus = SCG_CLOCK_VALID;
-        }
-        else
+        u32Mask = (uint32_t)(SCG_FIRCCSR_TRUP_MASK | SCG_FIRCCSR_TREN_MASK | SCG_FIRCCSR_STEN_MASK |
+                             SCG_FIRCCSR_CM_MASK | SCG_FIRCCSR_LK_MASK);
+        u32Val = (uint32_t)(SCG_FIRCCSR_TRUP(pFircConfig->bTrEn) | SCG_FIRCCSR_TREN(pFircConfig->bTrEn) |
+                            SCG_FIRCCSR_STEN(pFircConfig->bSten) | SCG_FIRCCSR_CM(pFircConfig->bCm) |
+                            SCG_FIRCCSR_LK(pFircConfig->bLock));
+        bResult = (SCG_HWA_GetFircValid() == true) && ((SCG->FIRCCSR & u32Mask) == u32Val) &&
+                  (SCG->FIRCCFG == SCG_FIRCCFG_CLKEN(3U));
+
+        if (bResult == true)
         {
-            eStatus = SCG_CLOCK_TIMEOUT;
+            u32Val = (uint32_t)((((uint32_t)pFircConfig->eDivH << SCG_FIRCDIV_DIVH_SHIFT) & SCG_FIRCDIV_DIVH_MASK) |
+                                (((uint32_t)pFircConfig->eDivM << SCG_FIRCDIV_DIVM_SHIFT) & SCG_FIRCDIV_DIVM_MASK) |
+                                (((uint32_t)pFircConfig->eDivL << SCG_FIRCDIV_DIVL_SHIFT) & SCG_FIRCDIV_DIVL_MASK));
+            bResult = SCG_IsAsyncDivConfigured(SCG_HWA_GetFircDiv(),
+                                               (uint32_t)(SCG_FIRCDIV_DIVL_MASK | SCG_FIRCDIV_DIVM_MASK | SCG_FIRCDIV_DIVH_MASK),
+                                               u32Val);
         }
 
-        if (eStatus == SCG_CLOCK_VALID)
+        if ((bResult == true) && (pFircConfig->bTrEn == true))
         {
-            /*
-            	DIV setting process:
-            	MCU_FC4150_512K:   Clear FOSCDIV[DIVH_EN] --> Configure FOSCDIV[DIVH] --> Set FOSCDIV[DIVH_EN]
-            	MCU_FC4150_2M:    Clear FOSCDIV[DIVH_EN], wait FOSCDIV[DIVH_ACK] clear
-            					--> Configure FIRCDIV[DIVH]
-            					--> Set FOSCDIV[DIVH_EN], wait FOSCDIV[DIVH_ACK] is set
-            */
-            SCG_HWA_DiableFoscDiv();
-            u32Temp = CLOCK_DIV_STABILIZATION_TIMEOUT;
-            while (((SCG->FOSCDIV & (SCG_FOSCDIV_DIVH_ACK_MASK | SCG_FOSCDIV_DIVM_ACK_MASK | SCG_FOSCDIV_DIVL_ACK_MASK)) != 0U)
-                    && (u32Temp > 0U))
-            {
-                u32Temp--;
-            }
-            u32Temp = SCG->FOSCDIV;
-            u32Temp &= ~(uint32_t)(SCG_FOSCDIV_DIVL_MASK | SCG_FOSCDIV_DIVM_MASK | SCG_FOSCDIV_DIVH_MASK);
-            u32Temp |= ((((uint32_t)pFoscConfig->eDivH << SCG_FOSCDIV_DIVH_SHIFT) & SCG_FOSCDIV_DIVH_MASK) |
-                        (((uint32_t)pFoscConfig->eDivM << SCG_FOSCDIV_DIVM_SHIFT) & SCG_FOSCDIV_DIVM_MASK) |
-                        (((uint32_t)pFoscConfig->eDivL << SCG_FOSCDIV_DIVL_SHIFT) & SCG_FOSCDIV_DIVL_MASK));
-            SCG_HWA_SetFoscDiv(u32Temp) ;
-
-            SCG_HWA_EnableFoscDiv();
-            u32Temp = CLOCK_DIV_STABILIZATION_TIMEOUT;
-            while ((((SCG->FOSCDIV & (uint32_t)SCG_FOSCDIV_DIVL_ACK_MASK) == 0U) ||
-                    ((SCG->FOSCDIV & (uint32_t)SCG_FOSCDIV_DIVM_ACK_MASK) == 0U) ||
-                    ((SCG->FOSCDIV & (uint32_t)SCG_FOSCDIV_DIVH_ACK_MASK) == 0U)) &&
-                    (u32Temp > 0U))
-            {
-                u32Temp--;
-            }
+            bResult = (SCG->FIRCTCFG == SCG_GetFircTcfgValue(pFircConfig));
         }
     }
     else
     {
-        /* if core clock source if from fosc, must switch core clock source first */
-        if ((s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_FOSC) ||
-                (s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_PLL0_FOSC))
-        {
-            eStatus = SCG_CLOCK_SEQUENCE_ERROR;
-        }
-        else
-        {
-            SCG_HWA_DisableFosc();
-            eStatus = SCG_CLOCK_DISABLE;
-            u32Temp = CLOCK_OFF_STABILIZATION_TIMEOUT;
-            while ((SCG_HWA_GetFoscValid() == true) && (u32Temp > 0U))
-            {
-                u32Temp--;
-            }
-        }
+        bResult = ((SCG->FIRCCSR & SCG_FIRCCSR_EN_MASK) == 0U) && (SCG_HWA_GetFircValid() == false);
     }
 
-    if((true == pFoscConfig->bCm) && (false == pFoscConfig->bCmre))
+    return bResult;
+}
+
+/**
+ * @brief Check whether the requested SIRC configuration is already in effect in hardware.
+ */
+static bool SCG_IsSircConfigured(const SCG_SircType *pSircConfig)
+{
+    bool bResult;
+    uint32_t u32Mask;
+    uint32_t u32Val;
+
+    u32Mask = (uint32_t)(SCG_SIRCCSR_CM_MASK | SCG_SIRCCSR_LK_MASK | SCG_SIRCCSR_TRUP_MASK |
+                         SCG_SIRCCSR_TREN_MASK | SCG_SIRCCSR_LPEN_MASK | SCG_SIRCCSR_STEN_MASK);
+    u32Val = (uint32_t)(SCG_SIRCCSR_CM(pSircConfig->bCm) | SCG_SIRCCSR_LK(pSircConfig->bLock) |
+                        SCG_SIRCCSR_TRUP(pSircConfig->bTrEn) | SCG_SIRCCSR_TREN(pSircConfig->bTrEn) |
+                        SCG_SIRCCSR_LPEN(pSircConfig->bLpen) | SCG_SIRCCSR_STEN(pSircConfig->bSten));
+    bResult = (SCG_HWA_GetSircValid() == true) && ((SCG->SIRCCSR & u32Mask) == u32Val);
+
+    if (bResult == true)
     {
-        s_FoscClkErrNotify = pFoscConfig->pFoscClockErrorNotify;
+        u32Val = (uint32_t)((((uint32_t)pSircConfig->eDivH << SCG_SIRCDIV_DIVH_SHIFT) & SCG_SIRCDIV_DIVH_MASK) |
+                            (((uint32_t)pSircConfig->eDivM << SCG_SIRCDIV_DIVM_SHIFT) & SCG_SIRCDIV_DIVM_MASK) |
+                            (((uint32_t)pSircConfig->eDivL << SCG_SIRCDIV_DIVL_SHIFT) & SCG_SIRCDIV_DIVL_MASK));
+        bResult = SCG_IsAsyncDivConfigured(SCG_HWA_GetSircDiv(),
+                                           (uint32_t)(SCG_SIRCDIV_DIVL_MASK | SCG_SIRCDIV_DIVM_MASK | SCG_SIRCDIV_DIVH_MASK),
+                                           u32Val);
     }
 
-    /* set FOSC configuration information */
-    SCG_SetFoscClockStatus(pFoscConfig->u32XtalFreq);
+    if ((bResult == true) && (pSircConfig->bTrEn == true))
+    {
+        bResult = (SCG->SIRCTCFG == SCG_GetSircTcfgValue(pSircConfig));
+    }
 
-    return eStatus;
+    return bResult;
 }
 
 /**
- * \brief Set SIRC configuration.
- * \param pSircConfig: pointer to the SIRCType structure data instance, which defined SIRC initial information
- * \return true or false. SIRCwould wait for SIRC valid in while loop within pre-dinfined limited time
- *         to check the SIRC valid or not. If SOSC still not valid,  it would return fail.
+ * @brief Check whether the requested FOSC configuration is already in effect in hardware and in
+ *        s_tClockSequenceInfo.
  */
-SCG_StatusType SCG_SetSIRC(SCG_SircType *pSircConfig)
+static bool SCG_IsFoscConfigured(const SCG_FoscType *pFoscConfig)
 {
-    SCG_StatusType eStatus;
-    uint32_t u32Temp;
-    uint16_t u16TrimDiv;
+    bool bResult;
+    uint32_t u32Mask;
+    uint32_t u32Val;
 
-    /* if run clock is none, the function will init s_tClockSequenceInfo buffer first */
-    SCG_InitClockSrcStatus();
-
-    u32Temp = SCG->SIRCCSR;
-    u32Temp &= ~(uint32_t)(SCG_SIRCCSR_CM_MASK | SCG_SIRCCSR_LK_MASK | SCG_SIRCCSR_TRUP_MASK |
-                           SCG_SIRCCSR_TREN_MASK | SCG_SIRCCSR_LPEN_MASK |
-                           SCG_SIRCCSR_STEN_MASK);
-    u32Temp |= (uint32_t)(SCG_SIRCCSR_CM(pSircConfig->bCm) | SCG_SIRCCSR_LK(pSircConfig->bLock) |
-                          SCG_SIRCCSR_TRUP(pSircConfig->bTrEn) |
-                          SCG_SIRCCSR_TREN(pSircConfig->bTrEn) |
-                          SCG_SIRCCSR_LPEN(pSircConfig->bLpen) |
-                          SCG_SIRCCSR_STEN(pSircConfig->bSten));
-    SCG_HWA_SetSircCsr(u32Temp);
-
-    /*               Check SIRC valid                       */
-    u32Temp = SIRC_STABILIZATION_TIMEOUT;
-    while ((SCG_HWA_GetSircValid() == false) && (u32Temp > 0U))
+    if (pFoscConfig->bEnable == true)
     {
-        u32Temp--;
+        u32Mask = (uint32_t)(SCG_FOSCCSR_STEN_MASK | SCG_FOSCCSR_CM_MASK | SCG_FOSCCSR_CMRE_MASK | SCG_FOSCCSR_LK_MASK);
+        u32Val = (uint32_t)(SCG_FOSCCSR_STEN(pFoscConfig->bSten) | SCG_FOSCCSR_CM(pFoscConfig->bCm) |
+                            SCG_FOSCCSR_CMRE(pFoscConfig->bCmre) | SCG_FOSCCSR_LK(pFoscConfig->bLock));
+        bResult = (SCG_HWA_GetFoscValid() == true) && ((SCG->FOSCCSR & u32Mask) == u32Val) &&
+                  (SCG->FOSCCFG == SCG_GetFoscCfgValue(pFoscConfig->bBypass)) &&
+                  (s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].u32Freq == pFoscConfig->u32XtalFreq);
+
+        if (bResult == true)
+        {
+            u32Val = (uint32_t)((((uint32_t)pFoscConfig->eDivH << SCG_FOSCDIV_DIVH_SHIFT) & SCG_FOSCDIV_DIVH_MASK) |
+                                (((uint32_t)pFoscConfig->eDivM << SCG_FOSCDIV_DIVM_SHIFT) & SCG_FOSCDIV_DIVM_MASK) |
+                                (((uint32_t)pFoscConfig->eDivL << SCG_FOSCDIV_DIVL_SHIFT) & SCG_FOSCDIV_DIVL_MASK));
+            bResult = SCG_IsAsyncDivConfigured(SCG_HWA_GetFoscDiv(),
+                                               (uint32_t)(SCG_FOSCDIV_DIVL_MASK | SCG_FOSCDIV_DIVM_MASK | SCG_FOSCDIV_DIVH_MASK),
+                                               u32Val);
+        }
+    }
+    else
+    {
+        bResult = ((SCG->FOSCCSR & SCG_FOSCCSR_EN_MASK) == 0U) && (SCG_HWA_GetFoscValid() == false);
     }
 
-    if (u32Temp != 0U)
+    return bResult;
+}
+
+/**
+ * @brief Check whether the requested SOSC configuration is already in effect in hardware and in
+ *        s_tClockSequenceInfo.
+ */
+static bool SCG_IsSoscConfigured(const SCG_SoscType *pSoscConfig)
+{
+    bool bResult;
+    uint32_t u32Mask;
+    uint32_t u32Val;
+
+    if (pSoscConfig->bEnable == true)
     {
-        eStatus = SCG_CLOCK_VALID;
+        u32Mask = (uint32_t)(SCG_SOSCCSR_BYPASS_MASK | SCG_SOSCCSR_CM_MASK | SCG_SOSCCSR_CMRE_MASK | SCG_SOSCCSR_LK_MASK);
+        u32Val = (uint32_t)(SCG_SOSCCSR_BYPASS(pSoscConfig->bBypass) | SCG_SOSCCSR_CM(pSoscConfig->bCm) |
+                            SCG_SOSCCSR_CMRE(pSoscConfig->bCmre) | SCG_SOSCCSR_LK(pSoscConfig->bLock));
+        bResult = (SCG_HWA_GetSoscValid() == true) && ((SCG->SOSCCSR & u32Mask) == u32Val) &&
+                  (SCG->SOSCCFG == SCG_GetSoscCfgValue()) &&
+                  (s_tClockSequenceInfo.tClockInfo[SCG_SOSC_CLK].u32Freq == pSoscConfig->u32XtalFreq);
     }
     else
     {
-        eStatus = SCG_CLOCK_TIMEOUT;
+        bResult = ((SCG->SOSCCSR & SCG_SOSCCSR_EN_MASK) == 0U) && (SCG_HWA_GetSoscValid() == false);
     }
 
-    if (eStatus == SCG_CLOCK_VALID)
+    return bResult;
+}
+
+/**
+ * @brief Check whether the requested PLL0 configuration is already in effect in hardware and in
+ *        s_tClockSequenceInfo.
+ */
+static bool SCG_IsPll0Configured(const SCG_Pll0Type *pPll0Config)
+{
+    bool bResult;
+    uint32_t u32Mask;
+    uint32_t u32Val;
+
+    if (pPll0Config->bEnable == true)
     {
-        /*
-            DIV setting process:
-            MCU_FC4150_512K:   Clear SIRCDIV[DIVH_EN] --> Configure SIRCDIV[DIVH] --> Set SIRCDIV[DIVH_EN]
-            MCU_FC4150_2M:    Clear SIRCDIV[DIVH_EN], wait SIRCDIV[DIVH_ACK] clear
-                            --> Configure FIRCDIV[DIVH]
-                            --> Set SIRCDIV[DIVH_EN], wait SIRCDIV[DIVH_ACK] is set
-        */
-        SCG_HWA_DiableSircDiv();
-        u32Temp = CLOCK_DIV_STABILIZATION_TIMEOUT;
-        while (((SCG->SIRCDIV & (SCG_SIRCDIV_DIVH_MASK | SCG_SIRCDIV_DIVM_MASK | SCG_SIRCDIV_DIVL_MASK)) != 0U)
-                && (u32Temp > 0U))
-        {
-            u32Temp--;
-        }
-        u32Temp = SCG->SIRCDIV;
-        u32Temp &= ~(uint32_t)(SCG_SIRCDIV_DIVL_MASK | SCG_SIRCDIV_DIVM_MASK | SCG_SIRCDIV_DIVH_MASK);
-        u32Temp |= (uint32_t)((((uint32_t)pSircConfig->eDivH << SCG_SIRCDIV_DIVH_SHIFT) & SCG_SIRCDIV_DIVH_MASK) |
-                              (((uint32_t)pSircConfig->eDivM << SCG_SIRCDIV_DIVM_SHIFT) & SCG_SIRCDIV_DIVM_MASK) |
-                              (((uint32_t)pSircConfig->eDivL << SCG_SIRCDIV_DIVL_SHIFT) & SCG_SIRCDIV_DIVL_MASK));
-        SCG_HWA_SetSircDiv(u32Temp);
-        SCG_HWA_EnableSircDiv();
-        u32Temp = CLOCK_DIV_STABILIZATION_TIMEOUT;
-        while ((((SCG->SIRCDIV & (uint32_t)SCG_SIRCDIV_DIVL_ACK_MASK) == 0U) ||
-                ((SCG->SIRCDIV & (uint32_t)SCG_SIRCDIV_DIVM_ACK_MASK) == 0U) ||
-                ((SCG->SIRCDIV & (uint32_t)SCG_SIRCDIV_DIVH_ACK_MASK) == 0U)) &&
-                (u32Temp > 0U))
-        {
-            u32Temp--;
-        }
+        u32Mask = (uint32_t)(SCG_PLL0CFG_PREDIV_MASK | SCG_PLL0CFG_MULT_MASK | SCG_PLL0CFG_SOURCE_MASK);
+        u32Val = (uint32_t)(SCG_PLL0CFG_PREDIV(pPll0Config->ePrediv) | SCG_PLL0CFG_MULT(pPll0Config->eMult) |
+                            SCG_PLL0CFG_SOURCE(pPll0Config->eSrc));
+        bResult = (SCG_HWA_GetPll0Locked() == true) && ((SCG->PLL0CFG & u32Mask) == u32Val) &&
+                  (s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].eClkStatus == SCG_CLOCK_VALID);
 
-        /*   SIRC  configuration SIRCTCFG    */
-        if (pSircConfig->bTrEn == false)
+        if (bResult == true)
         {
-            /*   Trim enalbe disabled, just using IC internal IRC trim value */
+            u32Mask = (uint32_t)(SCG_PLL0CSR_EN_MASK | SCG_PLL0CSR_STEN_MASK | SCG_PLL0CSR_CM_MASK |
+                                 SCG_PLL0CSR_CMRE_MASK | SCG_PLL0CSR_LK_MASK);
+            u32Val = (uint32_t)(SCG_PLL0CSR_EN(1U) | SCG_PLL0CSR_STEN(pPll0Config->bSten) |
+                                SCG_PLL0CSR_CM(pPll0Config->bCm) | SCG_PLL0CSR_CMRE(pPll0Config->bCmre) |
+                                SCG_PLL0CSR_LK(pPll0Config->bLock));
+            bResult = ((SCG->PLL0CSR & u32Mask) == u32Val);
         }
-        else
+
+        if (bResult == true)
         {
-            /*   set SIRCTCFG trim configuration    */
-            if (pSircConfig->u8TrimSrc == SCG_IRC_TRIMSRC_FOSC)
-            {
-                /*   Trim clock source choosed FOSC   */
-                u16TrimDiv = (uint16_t)(s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].u32Freq / 1000000U - 1U);
-            }
-            else if (pSircConfig->u8TrimSrc == SCG_IRC_TRIMSRC_SOSC)
-            {
-                /*   Trim clock source choosed SOSC   */
-                u16TrimDiv = 0U;
-            }
-            else
-            {
-                u16TrimDiv = 0U;
-                /*   do nothing   */
-            }
-            /* Setting the SAMPLE bit and enabling DELAY means more sampling time and longer calibration time,
-             * which leads to more accurate calibration. */
-            u32Temp = (uint32_t)(SCG_SIRCTCFG_TRIMSRC(pSircConfig->u8TrimSrc) |
-                                 SCG_SIRCTCFG_TRIMDIV(u16TrimDiv) |
-                                 SCG_SIRCTCFG_SAMPLE_MASK |
-                                 SCG_SIRCTCFG_DELAY_MASK);
-            SCG_HWA_SetSircTcfg(u32Temp);
+            u32Val = (uint32_t)((((uint32_t)pPll0Config->eDivH << SCG_PLL0DIV_DIVH_SHIFT) & SCG_PLL0DIV_DIVH_MASK) |
+                                (((uint32_t)pPll0Config->eDivM << SCG_PLL0DIV_DIVM_SHIFT) & SCG_PLL0DIV_DIVM_MASK) |
+                                (((uint32_t)pPll0Config->eDivL << SCG_PLL0DIV_DIVL_SHIFT) & SCG_PLL0DIV_DIVL_MASK));
+            bResult = SCG_IsAsyncDivConfigured(SCG_HWA_GetPll0Div(),
+                                               (uint32_t)(SCG_PLL0DIV_DIVL_MASK | SCG_PLL0DIV_DIVM_MASK | SCG_PLL0DIV_DIVH_MASK),
+                                               u32Val);
         }
-
     }
-
-    if(true == pSircConfig->bCm)
+    else
     {
-        s_SircClkErrNotify = pSircConfig->pSircClockErrorNotify;
+        bResult = ((SCG->PLL0CSR & SCG_PLL0CSR_EN_MASK) == 0U) && (SCG_HWA_GetPll0Locked() == false);
     }
 
-    /* set SIRC configuration information */
-    SCG_SetSircClockStatus();
-
-    return eStatus;
+    return bResult;
 }
 
 /**
- * \brief Set SIRC32K configuration.
- * \param pSirc32kConfig: pointer to the Sirc32kType structure data instance, which defined SIRC32K initial information
- * \return true or false.
+ * @brief Check whether the requested CORE/BUS/SLOW configuration is already in effect in hardware.
  */
-SCG_StatusType SCG_SetSIRC32K(SCG_Sirc32kType *pSirc32kConfig)
+static bool SCG_IsClkCtrlConfigured(const SCG_ClockCtrlType *pSysClkConfig)
 {
-    SCG_StatusType eStatus;
-    uint32_t u32Temp = 0U;
+    uint32_t u32Mask;
+    uint32_t u32Val;
+
+    u32Mask = (uint32_t)(SCG_CCR_SYSCLK_CME_MASK | SCG_CCR_SCS_MASK | SCG_CCR_DIVCORE_MASK |
+                         SCG_CCR_DIVBUS_MASK | SCG_CCR_DIVSLOW_MASK);
+    u32Val = (uint32_t)((uint32_t)SCG_CCR_SYSCLK_CME(pSysClkConfig->bSysClkMonitor) |
+                        (uint32_t)SCG_CCR_SCS(pSysClkConfig->eSrc) |
+                        (uint32_t)SCG_CCR_DIVCORE(pSysClkConfig->eDivCore) |
+                        (uint32_t)SCG_CCR_DIVBUS(pSysClkConfig->eDivBus)  |
+                        (uint32_t)SCG_CCR_DIVSLOW(pSysClkConfig->eDivSlow));
+
+    return (((SCG->CCR & u32Mask) == u32Val) &&
+            (SCG_HWA_GetSysClkSrc() == (uint8_t)pSysClkConfig->eSrc) &&
+            (s_tClockSequenceInfo.tClockInfo[SCG_CORE_CLK].u32Freq != UNKNOWN_CLOCK));
+}
 
-    /* if run clock is none, the function will init s_tClockSequenceInfo buffer first */
-    SCG_InitClockSrcStatus();
+/**
+ * @brief Write CCR and wait until the system clock update is done.
+ * @param u32Ccr: new CCR value
+ * @param u8Src: CCR[SCS] expected after the switch
+ * @return SCG_CLOCK_TIMEOUT if UPRD stays low, SCG_CLOCK_ERROR if another source is in effect
+ */
+static SCG_RAMFUNC SCG_StatusType SCG_SwitchCcr(uint32_t u32Ccr, uint8_t u8Src)
+{
+    SCG_StatusType eStatus = SCG_CLOCK_VALID;
+    uint32_t u32Temp;
+    uint32_t u32Start;
 
-    u32Temp = (uint32_t)(SCG_SIRC32KCSR_LK(pSirc32kConfig->bLock) | SCG_SIRC32KCSR_EN(pSirc32kConfig->bEn));
-    SCG_HWA_SetSirc32kCsr(u32Temp);
+    u32Start = SCG_GET_CYCLES();
+    SCG_HWA_SetCCR(u32Ccr);
 
-    /*               Check SIRC valid                       */
-    u32Temp = SIRC_STABILIZATION_TIMEOUT;
-    while ((SCG_HWA_GetSirc32kValid() == false) && (u32Temp > 0U))
+    u32Temp = SCG_CLKSRC_STABILIZATION_TIMEOUT;
+    while ((SCG_HWA_GetSysClkUPRD() == false) && (u32Temp > 0U))
     {
         u32Temp--;
     }
 
+    /*   Time out, clock select failed     */
     if (u32Temp == 0U)
     {
         eStatus = SCG_CLOCK_TIMEOUT;
     }
+    else if (SCG_HWA_GetSysClkSrc() != u8Src)
+    {
+        eStatus = SCG_CLOCK_ERROR;
+    }
     else
     {
-        eStatus = SCG_CLOCK_VALID;
     }
-
-    /* set SIRC32K configuration information */
-    SCG_SetSirc32kClockStatus();
+    if (s_tResidency.bEnabled == true)
+    {
+        s_tResidency.u32SwitchCycles += SCG_GET_CYCLES() - u32Start;
+    }
 
     return eStatus;
 }
 
 /**
- * \brief Set FIRC configuration.
- * \param pFircConfig: pointer to the FIRCType structure data instance, which defined FIRC initial information.
- * \return true or false. FIRCwould wait for FIRC valid in while loop within pre-dinfined limited time
- *         to check the FIRC valid or not. If FIRC still not valid,  it would return fail.
+ * @brief Busy wait between two ramp steps.
  */
-SCG_StatusType SCG_SetFIRC(SCG_FircType *pFircConfig)
+static SCG_RAMFUNC void SCG_RampDwell(uint32_t u32Loops)
 {
-    SCG_StatusType eStatus;
-    uint32_t u32Temp;
-    uint16_t u16TrimDiv;
+    uint32_t u32Index;
 
-    /* if run clock is none, the function will init s_tClockSequenceInfo buffer first */
-    SCG_InitClockSrcStatus();
+    for (u32Index = 0U; u32Index < u32Loops; u32Index++)
+    {
+        __asm("nop");
+    }
+}
 
-    /*            Set FIRCCSR           */
-    if (pFircConfig->bEnable == true)
+/**
+ * @brief Reach the CCR value through intermediate DIVCORE steps, every step at most halves or doubles the core clock.
+ *        The current source is first stepped down towards the target frequency, the target source is then entered
+ *        with a larger DIVCORE and stepped up to the requested DIVCORE. BUS and SLOW only get slower on the way.
+ * @param u32Ccr: final CCR value
+ * @param u32SrcFreq: frequency of the target source
+ * @param u32OldCoreFreq: core clock before the switch
+ * @return status of the first failed step, SCG_CLOCK_VALID when the final value is in effect
+ */
+static SCG_RAMFUNC SCG_StatusType SCG_RampCcr(uint32_t u32Ccr, uint32_t u32SrcFreq, uint32_t u32OldCoreFreq)
+{
+    SCG_StatusType eStatus = SCG_CLOCK_VALID;
+    uint32_t u32CurCcr = SCG->CCR;
+    uint32_t u32CurDiv = (u32CurCcr & SCG_CCR_DIVCORE_MASK) >> SCG_CCR_DIVCORE_SHIFT;
+    uint32_t u32CurSrcFreq = u32OldCoreFreq * (u32CurDiv + 1U);
+    uint32_t u32CurFreq = u32OldCoreFreq;
+    uint32_t u32Div = (u32Ccr & SCG_CCR_DIVCORE_MASK) >> SCG_CCR_DIVCORE_SHIFT;
+    uint32_t u32TargetFreq = u32SrcFreq / (u32Div + 1U);
+    uint32_t u32Dwell = 0U;
+    bool bDone = false;
+
+    /* step down on the current source while the next step stays at or above the target,
+       the dwell of a step is spent before the next write so none follows the last one */
+    while ((eStatus == SCG_CLOCK_VALID) && (((u32CurDiv + 1U) * 2U) <= SCG_RAMP_DIVCORE_RANGE) &&
+            ((u32CurFreq / 2U) >= u32TargetFreq))
     {
-        SCG_HWA_SetFircCfg(SCG_FIRCCFG_CLKEN(3U));
+        u32CurDiv = ((u32CurDiv + 1U) * 2U) - 1U;
+        u32CurFreq = u32CurSrcFreq / (u32CurDiv + 1U);
+        u32CurCcr = (u32CurCcr & ~SCG_CCR_DIVCORE_MASK) | SCG_CCR_DIVCORE(u32CurDiv);
+        SCG_RampDwell(u32Dwell);
+        eStatus = SCG_SwitchCcr(u32CurCcr, (uint8_t)((u32CurCcr & SCG_CCR_SCS_MASK) >> SCG_CCR_SCS_SHIFT));
+        u32Dwell = s_tRamp.u32DownDwell;
+    }
 
-        u32Temp = SCG->FIRCCSR;
-        u32Temp &= ~(uint32_t)(SCG_FIRCCSR_TRUP_MASK | SCG_FIRCCSR_TREN_MASK | SCG_FIRCCSR_STEN_MASK);
-        u32Temp |= (uint32_t)(SCG_FIRCCSR_TRUP(pFircConfig->bTrEn) |    /*    configure TRUP and EN together with TREN setting   */
-                              SCG_FIRCCSR_TREN(pFircConfig->bTrEn) |
-                              SCG_FIRCCSR_STEN(pFircConfig->bSten) |
-                              SCG_FIRCCSR_EN(1U));
-        SCG_HWA_SetFircCsr(u32Temp);
+    /* enter the target source at most at twice the current clock */
+    u32CurDiv = u32Div;
+    while ((((u32CurDiv + 1U) * 2U) <= SCG_RAMP_DIVCORE_RANGE) && ((u32SrcFreq / (u32CurDiv + 1U)) > (u32CurFreq * 2U)))
+    {
+        u32CurDiv = ((u32CurDiv + 1U) * 2U) - 1U;
+    }
 
-        u32Temp = FIRC_STABILIZATION_TIMEOUT;
-        /*               Check FIRC valid                       */
-        while ((SCG_HWA_GetFircValid() == false) && (u32Temp > 0U))
+    /* step up to the requested DIVCORE */
+    while ((eStatus == SCG_CLOCK_VALID) && (bDone == false))
+    {
+        u32CurCcr = (u32Ccr & ~SCG_CCR_DIVCORE_MASK) | SCG_CCR_DIVCORE(u32CurDiv);
+        if (u32CurCcr != SCG->CCR)
         {
-            u32Temp--;
+            SCG_RampDwell(u32Dwell);
+            eStatus = SCG_SwitchCcr(u32CurCcr, (uint8_t)((u32Ccr & SCG_CCR_SCS_MASK) >> SCG_CCR_SCS_SHIFT));
+            u32Dwell = s_tRamp.u32UpDwell;
         }
-
-        if (u32Temp != 0U)
+        if (u32CurDiv == u32Div)
         {
-            /* Configure CM and lock */
-            u32Temp = SCG->FIRCCSR;
-            u32Temp |= (uint32_t)SCG_FIRCCSR_CM(pFircConfig->bCm);
-            SCG_HWA_SetFircCsr(u32Temp);
-            u32Temp |= (uint32_t)SCG_FIRCCSR_LK(pFircConfig->bLock);
-            SCG_HWA_SetFircCsr(u32Temp);
-
-            eStatus = SCG_CLOCK_VALID;
+            bDone = true;
         }
         else
         {
-            eStatus = SCG_CLOCK_TIMEOUT;
+            u32CurDiv = ((u32CurDiv + 1U) / 2U) - 1U;
         }
+    }
 
-        if (eStatus == SCG_CLOCK_VALID)
-        {
-            /*               Set FIRCDIV                       */
-            /*
-            	DIV setting process:
-            	MCU_FC4150_512K:   Clear FIRCDIV[DIVH_EN] --> Configure FIRCDIV[DIVH] --> Set FIRCDIV[DIVH_EN]
-            	MCU_FC4150_2M:    Clear FIRCDIV[DIVH_EN], wait FIRCDIV[DIVH_ACK] clear
-            					--> Configure FIRCDIV[DIVH]
-            					--> Set FIRCDIV[DIVH_EN], wait FIRCDIV[DIVH_ACK] is set
-            */
-            SCG_HWA_DiableFircDiv();
-            u32Temp = CLOCK_DIV_STABILIZATION_TIMEOUT;
-            while (((SCG->FIRCDIV & (SCG_FIRCDIV_DIVH_ACK_MASK | SCG_FIRCDIV_DIVM_ACK_MASK | SCG_FIRCDIV_DIVL_ACK_MASK)) != 0U) &&
-                    ((u32Temp > 0U)))
-            {
-                u32Temp--;
-            }
-            u32Temp = SCG->FIRCDIV;
-            u32Temp &= ~(uint32_t)(SCG_FIRCDIV_DIVL_MASK | SCG_FIRCDIV_DIVM_MASK | SCG_FIRCDIV_DIVH_MASK);
-            u32Temp |= (uint32_t)((((uint32_t)pFircConfig->eDivH << SCG_FIRCDIV_DIVH_SHIFT) & SCG_FIRCDIV_DIVH_MASK) |
-                                  (((uint32_t)pFircConfig->eDivM << SCG_FIRCDIV_DIVM_SHIFT) & SCG_FIRCDIV_DIVM_MASK) |
-                                  (((uint32_t)pFircConfig->eDivL << SCG_FIRCDIV_DIVL_SHIFT) & SCG_FIRCDIV_DIVL_MASK));
+    return eStatus;
+}
 
-            SCG_HWA_SetFircDiv(u32Temp);
-            SCG_HWA_EnableFircDiv();
-            u32Temp = CLOCK_DIV_STABILIZATION_TIMEOUT;
-            while ((((SCG->FIRCDIV & (uint32_t)SCG_FIRCDIV_DIVL_ACK_MASK) == 0U) ||
-                    ((SCG->FIRCDIV & (uint32_t)SCG_FIRCDIV_DIVM_ACK_MASK) == 0U) ||
-                    ((SCG->FIRCDIV & (uint32_t)SCG_FIRCDIV_DIVH_ACK_MASK) == 0U)) &&
-                    (u32Temp > 0U))
-            {
-                u32Temp--;
-            }
+/**
+ * @brief Predicted state of a source node.
+ */
+static void SCG_PredictSrc(SCG_ClockInfoType *pNode, bool bEnable, uint32_t u32Freq)
+{
+    if (bEnable == true)
+    {
+        pNode->eClkStatus = SCG_CLOCK_VALID;
+        pNode->u32Freq = u32Freq;
+    }
+    else
+    {
+        pNode->eClkStatus = SCG_CLOCK_DISABLE;
+        pNode->u32Freq = 0U;
+    }
+}
 
-            /*   For clock autotrim, set TREN to True together with TRUP to True   */
-            if (pFircConfig->bTrEn == true)
-            {
-                /*   set FIRCTCFG trim configuration    */
-                if (pFircConfig->u8TrimSrc == SCG_IRC_TRIMSRC_FOSC)
-                {
-                    /*   Trim clock source choose FOSC   */
-                    u16TrimDiv = (uint16_t)(s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].u32Freq / 1000000U - 1U);
-                }
-                else if (pFircConfig->u8TrimSrc == SCG_IRC_TRIMSRC_SOSC)
-                {
-                    /*   Trim clock source choose SOSC   */
-                    u16TrimDiv = 0U;
-                }
-                else
-                {
-                    /*   do nothing   */
-                    u16TrimDiv = 0U;
-                }
-                /* Setting the SAMPLE bit and enabling DELAY means more sampling time and longer calibration time,
-                 * which leads to more accurate calibration. */
-                u32Temp = (uint32_t)(SCG_FIRCTCFG_TRIMSRC(pFircConfig->u8TrimSrc) |
-                                     SCG_FIRCTCFG_TRIMDIV(u16TrimDiv) |
-                                     SCG_FIRCTCFG_SAMPLE_MASK |
-                                     SCG_FIRCTCFG_DELAY_MASK);
-                SCG_HWA_SetFircTcfg(u32Temp);
-            }
-            else
-            {
-                /*   Trim disabled, just using IC internal IRC trim value */
-            }
+/**
+ * @brief Predicted state of an async divider output, same rule as the SCG_SetXxxClockStatus functions.
+ */
+static void SCG_PredictDiv(SCG_ClockInfoType *pNode, const SCG_ClockInfoType *pSrc, SCG_AsyncClockDivType eDiv)
+{
+    SCG_PredictSrc(pNode, (pSrc->eClkStatus == SCG_CLOCK_VALID) && (eDiv != SCG_ASYNCCLOCKDIV_DISABLE),
+                   SCG_CalcAsyncDivFreq(pSrc->u32Freq, (uint32_t)eDiv));
+}
 
-        }
-        else
-        {
-            SCG_HWA_DisableFirc();
-        }
+/**
+ * @brief Clock node feeding the system clock, SCG_END_OF_CLOCKS for an unknown source.
+ */
+static SCG_ClkSrcType SCG_GetSysSrcNode(SCG_ClockSrcType eSrc)
+{
+    SCG_ClkSrcType eNode;
+
+    switch (eSrc)
+    {
+    case SCG_CLOCK_SRC_FOSC:
+        eNode = SCG_FOSC_CLK;
+        break;
+    case SCG_CLOCK_SRC_FIRC:
+        eNode = SCG_FIRC_CLK;
+        break;
+    case SCG_CLOCK_SRC_PLL0:
+        eNode = SCG_PLL0_CLK;
+        break;
+    default:
+        eNode = SCG_END_OF_CLOCKS;
+        break;
     }
-    else
+
+    return eNode;
+}
+
+/**
+ * @brief Predicted PLL0 nodes, the frequency follows SCG_SetPll0ClockStatus, the limit check follows SCG_SetPLL0.
+ * @return SCG_WHATIF_xxx violations
+ */
+static uint32_t SCG_PredictPll0(SCG_ClockSequenceType *pTree, const SCG_Pll0Type *pPll0)
+{
+    uint32_t u32Violation = 0U;
+    bool bFircSrc = (pPll0->eSrc == SCG_PLL0SOURCE_FIRC);
+    const SCG_ClockInfoType *pSrc = &pTree->tClockInfo[(bFircSrc == true) ? SCG_FIRC_CLK : SCG_FOSC_CLK];
+    uint32_t u32Freq = 0U;
+
+    if (pPll0->bEnable == true)
     {
-        /* if core clock source if from fosc, must switch core clock source first */
-        if ((s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_FIRC) ||
-                (s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_PLL0_FIRC))
+        if (pSrc->eClkStatus != SCG_CLOCK_VALID)
         {
-            eStatus = SCG_CLOCK_SEQUENCE_ERROR;
+            u32Violation |= SCG_WHATIF_PLL0_SRC_DISABLED;
         }
         else
         {
-            eStatus = SCG_CLOCK_DISABLE;
-            SCG_HWA_DisableFirc();
-
-            u32Temp = CLOCK_OFF_STABILIZATION_TIMEOUT;
-            while ((SCG_HWA_GetFircValid() == true) && (u32Temp > 0U))
+            if (SCG_CalcPll0InRange(SCG_CalcPll0Freq(pSrc->u32Freq, bFircSrc, (uint32_t)pPll0->ePrediv, (uint32_t)pPll0->eMult),
+                                    bFircSrc) == false)
             {
-                u32Temp--;
+                u32Violation |= SCG_WHATIF_PLL0_RANGE;
             }
+            u32Freq = SCG_CalcPll0NodeFreq(pSrc->u32Freq, (uint32_t)pPll0->ePrediv, (uint32_t)pPll0->eMult);
         }
     }
 
-    if(true == pFircConfig->bCm)
+    SCG_PredictSrc(&pTree->tClockInfo[SCG_PLL0_CLK], (pPll0->bEnable == true) && (u32Violation == 0U), u32Freq);
+    SCG_PredictDiv(&pTree->tClockInfo[SCG_PLL0DIVH_CLK], &pTree->tClockInfo[SCG_PLL0_CLK], pPll0->eDivH);
+    SCG_PredictDiv(&pTree->tClockInfo[SCG_PLL0DIVM_CLK], &pTree->tClockInfo[SCG_PLL0_CLK], pPll0->eDivM);
+
+    return u32Violation;
+}
+
+/**
+ * @brief Predicted CORE/BUS/SLOW nodes for a source and CCR dividers.
+ * @return SCG_WHATIF_xxx violations
+ */
+static uint32_t SCG_PredictSysClk(SCG_ClockSequenceType *pTree, SCG_ClkSrcType eNode, uint32_t u32DivCore,
+                                  uint32_t u32DivBus, uint32_t u32DivSlow)
+{
+    uint32_t u32Violation = 0U;
+    SCG_CalcSysFreqType tSysFreq = {0U, 0U, 0U};
+
+    if ((eNode == SCG_END_OF_CLOCKS) || (pTree->tClockInfo[eNode].eClkStatus != SCG_CLOCK_VALID))
+    {
+        u32Violation = SCG_WHATIF_SYSCLK_SRC_DISABLED;
+    }
+    else
     {
-        s_FircClkErrNotify = pFircConfig->pFircClockErrorNotify;
+        if (SCG_CalcSysClk(pTree->tClockInfo[eNode].u32Freq, u32DivCore, u32DivBus, u32DivSlow, &tSysFreq) == false)
+        {
+            u32Violation = SCG_WHATIF_SYSCLK_RANGE;
+        }
+        pTree->tClockInfo[SCG_CORE_CLK].eClkStatus = SCG_CLOCK_VALID;
+        pTree->tClockInfo[SCG_CORE_CLK].u32Freq = tSysFreq.u32CoreFreq;
+        pTree->tClockInfo[SCG_BUS_CLK].eClkStatus = SCG_CLOCK_VALID;
+        pTree->tClockInfo[SCG_BUS_CLK].u32Freq = tSysFreq.u32BusFreq;
+        pTree->tClockInfo[SCG_SLOW_CLK].eClkStatus = SCG_CLOCK_VALID;
+        pTree->tClockInfo[SCG_SLOW_CLK].u32Freq = tSysFreq.u32SlowFreq;
     }
 
+    return u32Violation;
+}
 
-    SCG_SetFircClockStatus();
+/**
+ * @brief Predicted CLKOUT node, same mapping as SCG_SetClockOutStatus.
+ */
+static void SCG_PredictClkOut(SCG_ClockSequenceType *pTree, SCG_ClockoutSrcType eClkOutSrc)
+{
+    SCG_ClkSrcType eNode;
 
-    return eStatus;
+    switch (eClkOutSrc)
+    {
+    case SCG_CLOCKOUT_SRC_FOSC:
+        eNode = SCG_FOSC_CLK;
+        break;
+    case SCG_CLOCKOUT_SRC_SIRC:
+        eNode = SCG_SIRC_CLK;
+        break;
+    case SCG_CLOCKOUT_SRC_FIRC:
+        eNode = SCG_FIRC_CLK;
+        break;
+    case SCG_CLOCKOUT_SRC_SOSC:
+        eNode = SCG_SOSC_CLK;
+        break;
+    case SCG_CLOCKOUT_SRC_PLL0:
+        eNode = SCG_PLL0_CLK;
+        break;
+    case SCG_CLOCKOUT_SRC_SIRC32K:
+        eNode = SCG_SIRC32K_CLK;
+        break;
+    default:
+        /* SCG_CLOCKOUT_SRC_OFF and reserved values */
+        eNode = SCG_END_OF_CLOCKS;
+        break;
+    }
+
+    if (eNode != SCG_END_OF_CLOCKS)
+    {
+        pTree->tClockInfo[SCG_SCG_CLKOUT_CLK] = pTree->tClockInfo[eNode];
+    }
+    else
+    {
+        pTree->tClockInfo[SCG_SCG_CLKOUT_CLK].eClkStatus =
+            (eClkOutSrc == SCG_CLOCKOUT_SRC_OFF) ? SCG_CLOCK_DISABLE : SCG_CLOCK_UNDEFINE;
+        pTree->tClockInfo[SCG_SCG_CLKOUT_CLK].u32Freq = 0U;
+    }
 }
 
 /**
- * \brief Set PLL0 configuration.
- * \param pPll0Config: pointer to the PLL0Type structure data instance, which defined PLL0 initial information.
- * \return true or false. PLL0 would wait for PLL0 valid in while loop within pre-dinfined limited time
- *         to check the PLL0 valid or not. If PLL0 still not valid(this may happen if external Fast OSC not placed),
- *         it would return fail. PLL0 would check the status of input clock source(FIRC or FOSC), if it is not valid, it would return false.
+ * @brief Disable PLL0, FOSC, SOSC and SIRC32K back to back, then wait once until all of them are off.
+ *        PLL0 is disabled first as FOSC may still be its reference, sources already off are skipped.
+ *        The teardown therefore costs the slowest source instead of the sum of all of them.
  */
-SCG_StatusType SCG_SetPLL0(SCG_Pll0Type *pPll0Config)
+static void SCG_TeardownClockSources(void)
 {
-    SCG_StatusType eStatus;
-    uint32_t u32Freq;
     uint32_t u32Temp;
-    uint32_t u32Index;
+    bool bPll0On;
+    bool bFoscOn;
+    bool bSoscOn;
+    bool bSirc32kOn;
 
     /* if run clock is none, the function will init s_tClockSequenceInfo buffer first */
     SCG_InitClockSrcStatus();
 
+    /* the source feeding the core clock must be switched away first, same rule as SCG_SetPLL0/SCG_SetFOSC */
+    bPll0On = ((SCG->PLL0CSR & SCG_PLL0CSR_EN_MASK) != 0U) &&
+              (s_tClockSequenceInfo.eRunClock != SCG_RUNCLOCK_PLL0_FIRC) &&
+              (s_tClockSequenceInfo.eRunClock != SCG_RUNCLOCK_PLL0_FOSC);
+    bFoscOn = ((SCG->FOSCCSR & SCG_FOSCCSR_EN_MASK) != 0U) &&
+              (s_tClockSequenceInfo.eRunClock != SCG_RUNCLOCK_FOSC) &&
+              (s_tClockSequenceInfo.eRunClock != SCG_RUNCLOCK_PLL0_FOSC);
+    bSoscOn = ((SCG->SOSCCSR & SCG_SOSCCSR_EN_MASK) != 0U);
+    bSirc32kOn = ((SCG->SIRC32KCSR & SCG_SIRC32KCSR_EN_MASK) != 0U);
+
+    if (bPll0On == true)
+    {
+        SCG_HWA_UnlockPll0();
+        SCG_HWA_DisablePll0();
+    }
 
-    /* if core clock source if from fosc, must switch core clock source first */
-    if ((s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_PLL0_FIRC) ||
-            (s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_PLL0_FOSC))
+    if (bFoscOn == true)
     {
-        eStatus = SCG_CLOCK_SEQUENCE_ERROR;
+        SCG_HWA_DisableFosc();
     }
-    else
+
+    if (bSoscOn == true)
     {
-        if (true == pPll0Config->bEnable)
-        {
-            switch (pPll0Config->eSrc)
-            {
-            case SCG_PLL0SOURCE_FOSC:
-            {
-                if (s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].eClkStatus == SCG_CLOCK_VALID)
-                {
-                    u32Freq = s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].u32Freq;
-                    u32Freq = u32Freq / (pPll0Config->ePrediv + 1U)  * (pPll0Config->eMult + 16U);
-                    u32Freq = u32Freq / 2U;
-                    if ((u32Freq >= PLL0_CLK_MAX) || (u32Freq <= PLL0_CLK_MIN))
-                    {
-                        eStatus = SCG_CLOCK_PARAM_INVALID;
-                    }
-                    else
-                    {
-                        eStatus = SCG_CLOCK_VALID;
-                    }
-                }
-                else
-                {
-                    eStatus = SCG_CLOCK_ERROR;
-                }
-            }
-            break;
+        SCG_HWA_DisableSosc();
+    }
 
-            case SCG_PLL0SOURCE_FIRC:
-            {
-                if (s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].eClkStatus == SCG_CLOCK_VALID)
-                {
-                    /*   PLL0 input is FIRC clock/2      */
-                    u32Freq = s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].u32Freq / 2U;
-                    u32Freq = u32Freq / (pPll0Config->ePrediv + 1U)  * (pPll0Config->eMult + 16U);
-                    u32Freq = u32Freq / 2U;
-                    if ((u32Freq > PLL0_CLK_MAX) || (u32Freq < PLL0_CLK_MIN))
-                    {
-                        eStatus = SCG_CLOCK_PARAM_INVALID;
-                    }
-                    else
-                    {
-                        eStatus = SCG_CLOCK_VALID;
-                    }
-                }
-                else
-                {
-                    eStatus = SCG_CLOCK_ERROR;
-                }
-            }
-            break;
+    if (bSirc32kOn == true)
+    {
+        SCG_HWA_SetSirc32kCsr((uint32_t)(SCG_SIRC32KCSR_LK(0U) | SCG_SIRC32KCSR_EN(0U)));
+    }
 
-            default:
-                eStatus = SCG_CLOCK_ERROR;
-                break;
-            }
+    /* wait on the combined "all off" condition once */
+    u32Temp = CLOCK_OFF_STABILIZATION_TIMEOUT;
+    while ((((bPll0On == true) && (SCG_HWA_GetPll0Locked() == true)) ||
+            ((bFoscOn == true) && (SCG_HWA_GetFoscValid() == true)) ||
+            ((bSoscOn == true) && (SCG_HWA_GetSoscValid() == true)) ||
+            ((bSirc32kOn == true) && (SCG_HWA_GetSirc32kValid() == true))) &&
+            (u32Temp > 0U))
+    {
+        u32Temp--;
+    }
 
-            if (eStatus == SCG_CLOCK_VALID)
-            {
-                if (SCG_PLL0PREDIV_BY2 == pPll0Config->ePrediv)
-                {
-                    u32Temp =  SCG_PLL0CFG_PREDIV(SCG_PLL0PREDIV_BY4) | SCG_PLL0CFG_MULT(pPll0Config->eMult) |
-                               SCG_PLL0CFG_SOURCE(pPll0Config->eSrc) ;
-                    SCG_HWA_SetPll0Cfg(u32Temp);
-                    u32Temp = SCG_PLL0CSR_EN_MASK;
-                    SCG_HWA_SetPll0Csr(u32Temp);
-                    for (u32Index = 0; u32Index < 200; u32Index++)
-                    {
-                    	__asm("nop");
-                    }
-
-                    SCG_HWA_SetPll0Csr(0U);
-                    u32Temp =  SCG_PLL0CFG_PREDIV(pPll0Config->ePrediv) | SCG_PLL0CFG_MULT(pPll0Config->eMult) |
-                               SCG_PLL0CFG_SOURCE(pPll0Config->eSrc) ;
-                    SCG_HWA_SetPll0Cfg(u32Temp);
-                }
-                else
-                {
-                    u32Temp =  SCG_PLL0CFG_PREDIV(pPll0Config->ePrediv) | SCG_PLL0CFG_MULT(pPll0Config->eMult) |
-                               SCG_PLL0CFG_SOURCE(pPll0Config->eSrc) ;
-                    SCG_HWA_SetPll0Cfg(u32Temp);
-                }
+    /* set PLL0, FOSC, SOSC and SIRC32K configuration information */
+    SCG_SetPll0ClockStatus();
+    SCG_SetFoscClockStatus(0U);
+    SCG_SetSoscClockStatus(0U);
+    SCG_SetSirc32kClockStatus();
+}
 
-                u32Temp = SCG_PLL0CSR_EN(pPll0Config->bEnable)  | SCG_PLL0CSR_STEN(pPll0Config->bSten);
-                SCG_HWA_SetPll0Csr(u32Temp);
+/**
+ * @brief Reset the retained startup history if it does not hold a valid image,
+ *        which is the case after power on.
+ */
+static void SCG_CheckStartupHistory(void)
+{
+    if ((s_tStartupHistory.u32Magic != SCG_STARTUP_MAGIC) ||
+            (s_tStartupHistory.u32Crc != SCG_CalcCrc32((const uint8_t *)&s_tStartupHistory,
+                                                       (uint32_t)offsetof(SCG_StartupHistoryType, u32Crc))))
+    {
+        (void)memset(&s_tStartupHistory, 0, sizeof(s_tStartupHistory));
+        s_tStartupHistory.u32Magic = SCG_STARTUP_MAGIC;
+        s_tStartupHistory.u32Crc = SCG_CalcCrc32((const uint8_t *)&s_tStartupHistory,
+                                                 (uint32_t)offsetof(SCG_StartupHistoryType, u32Crc));
+    }
+}
 
-                /*               Wait till PLL0 valid                       */
-                u32Temp = PLL0_STABILIZATION_TIMEOUT;
-                while ((SCG_HWA_GetPll0Locked() == false) && (u32Temp > 0U))
-                {
-                    u32Temp--;
-                }
+static uint32_t SCG_GetStartupMax(uint8_t u8Slot)
+{
+    uint32_t u32Max = 0U;
+    uint8_t u8Index;
 
-                if (u32Temp != 0U)
-                {
-                    u32Temp = SCG->PLL0CSR;
-                    /* Configure CM CMRE and lock */
-                    u32Temp |= SCG_PLL0CSR_CM(pPll0Config->bCm);
-                    SCG_HWA_SetPll0Csr(u32Temp);
-                    u32Temp |= SCG_PLL0CSR_CMRE(pPll0Config->bCmre) | SCG_PLL0CSR_LK(pPll0Config->bLock);
-                    SCG_HWA_SetPll0Csr(u32Temp);
+    for (u8Index = 0U; u8Index < s_tStartupHistory.au8Count[u8Slot]; u8Index++)
+    {
+        if (s_tStartupHistory.au32Sample[u8Slot][u8Index] > u32Max)
+        {
+            u32Max = s_tStartupHistory.au32Sample[u8Slot][u8Index];
+        }
+    }
 
-                    eStatus = SCG_CLOCK_VALID;
-                }
-                else
-                {
-                    eStatus = SCG_CLOCK_TIMEOUT;
-                }
+    return u32Max;
+}
 
-                if (eStatus == SCG_CLOCK_VALID)
-                {
-                    /*
-                        DIV setting process:
-                        MCU_FC4150_512K:   Clear PLL0DIV[DIVH_EN] --> Configure PLL0DIV[DIVH] --> Set PLL0DIV[DIVH_EN]
-                        MCU_FC4150_2M:    Clear PLL0DIV[DIVH_EN], wait PLL0DIV[DIVH_ACK] clear
-                                        --> Configure FIRCDIV[DIVH]
-                                        --> Set PLL0DIV[DIVH_EN], wait PLL0DIV[DIVH_ACK] is set
-                    */
-                    SCG_HWA_DiablePll0Div();
-                    u32Temp = CLOCK_DIV_STABILIZATION_TIMEOUT;
-                    while (((SCG->PLL0DIV & (SCG_PLL0DIV_DIVL_ACK_MASK | SCG_PLL0DIV_DIVM_ACK_MASK | SCG_PLL0DIV_DIVH_ACK_MASK)) != 0U) &&
-                            (u32Temp > 0U))
-                    {
-                        u32Temp--;
-                    }
-                    u32Temp = SCG->PLL0DIV;
-                    u32Temp &= ~(uint32_t)(SCG_PLL0DIV_DIVL_MASK | SCG_PLL0DIV_DIVM_MASK | SCG_PLL0DIV_DIVH_MASK);
-                    u32Temp = (uint32_t)((((uint32_t)pPll0Config->eDivH << SCG_PLL0DIV_DIVH_SHIFT) & SCG_PLL0DIV_DIVH_MASK) |
-                                         (((uint32_t)pPll0Config->eDivM << SCG_PLL0DIV_DIVM_SHIFT) & SCG_PLL0DIV_DIVM_MASK) |
-                                         (((uint32_t)pPll0Config->eDivL << SCG_PLL0DIV_DIVL_SHIFT) & SCG_PLL0DIV_DIVL_MASK));
-                    SCG_HWA_SetPll0Div(u32Temp);
-
-                    SCG_HWA_EnablePll0Div();
-                    u32Temp = CLOCK_DIV_STABILIZATION_TIMEOUT;
-                    while ((((SCG->PLL0DIV & (uint32_t)SCG_PLL0DIV_DIVL_ACK_MASK) == 0U) ||
-                            ((SCG->PLL0DIV & (uint32_t)SCG_PLL0DIV_DIVM_ACK_MASK) == 0U) ||
-                            ((SCG->PLL0DIV & (uint32_t)SCG_PLL0DIV_DIVH_ACK_MASK) == 0U)) &&
-                            (u32Temp > 0U))
-                    {
-                        u32Temp--;
-                    }
+static uint32_t SCG_GetStartupMean(uint8_t u8Slot)
+{
+    uint32_t u32Sum = 0U;
+    uint8_t u8Index;
 
-                }
-            }
-        }
-        else
-        {
-            eStatus = SCG_CLOCK_DISABLE;
-            /* Unlock PLL0 */
-            SCG_HWA_UnlockPll0();
-            /* Disable PLL0 */
-            SCG_HWA_DisablePll0();
+    for (u8Index = 0U; u8Index < s_tStartupHistory.au8Count[u8Slot]; u8Index++)
+    {
+        u32Sum += s_tStartupHistory.au32Sample[u8Slot][u8Index];
+    }
 
-            u32Temp = CLOCK_OFF_STABILIZATION_TIMEOUT;
-            while ((SCG_HWA_GetPll0Locked() == true) && (u32Temp > 0U))
-            {
-                u32Temp--;
-            }
-        }
+    return (s_tStartupHistory.au8Count[u8Slot] != 0U) ? (u32Sum / s_tStartupHistory.au8Count[u8Slot]) : 0U;
+}
+
+/**
+ * @brief Startup deadline of a source in SCG_GET_CYCLES() ticks, derived from the retained history
+ *        with margin and capped at the fixed worst case timeout. Without enough history the fixed
+ *        timeout is used. Blocking waits divide it by SCG_WAIT_LOOP_CYCLES to get their loop count.
+ * @param u32Timeout: fixed timeout in wait loops
+ */
+static uint32_t SCG_GetStartupDeadline(uint8_t u8Slot, uint32_t u32Timeout)
+{
+    uint32_t u32Deadline = u32Timeout * SCG_WAIT_LOOP_CYCLES;
 
-        if((true == pPll0Config->bCm) && (false == pPll0Config->bCmre))
+    SCG_CheckStartupHistory();
+    if (s_tStartupHistory.au8Count[u8Slot] >= SCG_STARTUP_HISTORY_MIN)
+    {
+        u32Deadline = (SCG_GetStartupMax(u8Slot) * SCG_STARTUP_MARGIN_MUL) + SCG_STARTUP_MARGIN_ADD;
+        if (u32Deadline > (u32Timeout * SCG_WAIT_LOOP_CYCLES))
         {
-            s_Pll0ClkErrNotify = pPll0Config->pPll0ClockErrorNotify;
+            u32Deadline = u32Timeout * SCG_WAIT_LOOP_CYCLES;
         }
     }
 
-    /* set PLL0 configuration information */
-    SCG_SetPll0ClockStatus();
-    return eStatus;
+    return u32Deadline;
 }
 
 /**
- * \brief Set system run time clock and related CORE/BUS/SLOW clock.
- * \param pSysClkConfig: pointer to the clockCtrlType structure data instance,
- *        which defined for system clock selection.
- * \return true or false. This function would check the clock source status before set it system clock,
- *         if the chosen clock source is invalid, it would return false.
+ * @brief Record an observed startup time in the retained history.
+ *        A timeout keeps the history, so a dead oscillator costs the learned deadline and not the
+ *        fixed timeout on every boot, and is reported as degradation like a startup well above the
+ *        mean. SCG_ClearStartupHistory gives a slow but working oscillator the fixed timeout back.
+ *        A startup measured as 0 ticks means SCG_GET_CYCLES() is not running, nothing is learned
+ *        then and the deadlines stay at the fixed timeouts.
+ * @param u8Slot: SCG_STARTUP_FOSC, SCG_STARTUP_SOSC or SCG_STARTUP_PLL0
+ * @param u32Observed: SCG_GET_CYCLES() ticks from enable until valid, or the deadline on timeout
+ * @param bTimeout: the source did not become valid before the deadline
  */
-SCG_StatusType SCG_SetClkCtrl(SCG_ClockCtrlType *pSysClkConfig)
+static void SCG_RecordStartup(uint8_t u8Slot, uint32_t u32Observed, bool bTimeout)
 {
-    SCG_StatusType eStatus;
-    uint32_t u32Temp, u32Freq, u32FreqCore, u32FreqBus, u32FreqSlow;
-
-    /* if run clock is none, the function will init s_tClockSequenceInfo buffer first */
-    SCG_InitClockSrcStatus();
+    uint32_t u32Mean;
+    bool bDegraded;
 
-    switch (pSysClkConfig->eSrc)
-    {
-    case SCG_CLOCK_SRC_FOSC:
+    if ((bTimeout == true) || (u32Observed != 0U))
     {
-        if (s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].eClkStatus == SCG_CLOCK_VALID)
+        SCG_CheckStartupHistory();
+        u32Mean = SCG_GetStartupMean(u8Slot);
+        bDegraded = (bTimeout == true) ||
+                    ((s_tStartupHistory.au8Count[u8Slot] >= SCG_STARTUP_HISTORY_MIN) &&
+                     ((u32Observed * 100U) > (u32Mean * SCG_STARTUP_DEGRADE_PCT)));
+
+        if (bTimeout == false)
         {
-            /*   PLL0 input is FIRC clock/2      */
-            u32Freq = s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].u32Freq;
-            u32FreqCore =  u32Freq / (pSysClkConfig->eDivCore + 1U);
-            u32FreqBus =  u32FreqCore / (pSysClkConfig->eDivBus + 1U);
-            u32FreqSlow =  u32FreqCore / (pSysClkConfig->eDivSlow + 1U);
-            if ((u32FreqCore > SYS_CORE_CLK_MAX) || (u32FreqBus > SYS_BUS_CLK_MAX) || (u32FreqSlow > SYS_SLOW_CLK_MAX))
-            {
-                eStatus = SCG_CLOCK_PARAM_INVALID;
-            }
-            else
+            s_tStartupHistory.au32Sample[u8Slot][s_tStartupHistory.au8Next[u8Slot]] = u32Observed;
+            s_tStartupHistory.au8Next[u8Slot] = (uint8_t)((s_tStartupHistory.au8Next[u8Slot] + 1U) % SCG_STARTUP_HISTORY_LEN);
+            if (s_tStartupHistory.au8Count[u8Slot] < SCG_STARTUP_HISTORY_LEN)
             {
-                eStatus = SCG_CLOCK_VALID;
+                s_tStartupHistory.au8Count[u8Slot]++;
             }
         }
-        else
+
+        if (bDegraded == true)
         {
-            eStatus = SCG_CLOCK_ERROR;
+            s_tStartupHistory.au8Degraded[u8Slot] = 1U;
         }
-    }
-    break;
+        s_tStartupHistory.u32Crc = SCG_CalcCrc32((const uint8_t *)&s_tStartupHistory,
+                                                 (uint32_t)offsetof(SCG_StartupHistoryType, u32Crc));
 
-    case SCG_CLOCK_SRC_FIRC:
-    {
-        if (s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].eClkStatus == SCG_CLOCK_VALID)
+        if ((bDegraded == true) && (s_pStartupDegradeNotify != NULL))
         {
-            /*   PLL0 input is FIRC clock/2      */
-            u32Freq = s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].u32Freq;
-            u32FreqCore =  u32Freq / (pSysClkConfig->eDivCore + 1U);
-            u32FreqBus =  u32FreqCore / (pSysClkConfig->eDivBus + 1U);
-            u32FreqSlow =  u32FreqCore / (pSysClkConfig->eDivSlow + 1U);
-            if ((u32FreqCore > SYS_CORE_CLK_MAX) || (u32FreqBus > SYS_BUS_CLK_MAX) || (u32FreqSlow > SYS_SLOW_CLK_MAX))
-            {
-                eStatus = SCG_CLOCK_PARAM_INVALID;
-            }
-            else
-            {
-                eStatus = SCG_CLOCK_VALID;
-            }
+            s_pStartupDegradeNotify(s_eStartupNode[u8Slot], u32Observed, u32Mean);
         }
-        else
+    }
+}
+
+/**
+ * @brief Finish the pending async job: record the error notify callbacks and the clock node
+ *        status, the completion callback is delivered by the next SCG_PollAsync.
+ */
+static void SCG_FinishAsync(void)
+{
+    switch (s_tAsyncJob.eKind)
+    {
+    case SCG_ASYNCJOB_SOSC:
+    {
+        if ((true == s_tAsyncJob.uCfg.tSosc.bCm) && (false == s_tAsyncJob.uCfg.tSosc.bCmre))
         {
-            eStatus = SCG_CLOCK_ERROR;
+            SCG_SetMonitorNotify(SCG_SOSC_CLK, s_tAsyncJob.uCfg.tSosc.pSoscClockErrorNotify);
         }
+        /* set SOSC configuration information */
+        SCG_SetSoscClockStatus(s_tAsyncJob.uCfg.tSosc.u32XtalFreq);
     }
     break;
 
-    case SCG_CLOCK_SRC_PLL0:
+    case SCG_ASYNCJOB_FOSC:
     {
-        if (s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].eClkStatus == SCG_CLOCK_VALID)
-        {
-            /*   PLL0 input is FIRC clock/2      */
-            u32Freq = s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].u32Freq;
-            u32FreqCore = u32Freq / (pSysClkConfig->eDivCore + 1U);
-            u32FreqBus = u32FreqCore / (pSysClkConfig->eDivBus + 1U);
-            u32FreqSlow = u32FreqCore / (pSysClkConfig->eDivSlow + 1U);
-            if ((u32FreqCore > SYS_CORE_CLK_MAX) || (u32FreqBus > SYS_BUS_CLK_MAX) || (u32FreqSlow > SYS_SLOW_CLK_MAX))
-            {
-                eStatus = SCG_CLOCK_PARAM_INVALID;
-            }
-            else
-            {
-                eStatus = SCG_CLOCK_VALID;
-            }
-        }
-        else
+        if ((true == s_tAsyncJob.uCfg.tFosc.bCm) && (false == s_tAsyncJob.uCfg.tFosc.bCmre))
         {
-            eStatus = SCG_CLOCK_ERROR;
+            SCG_SetMonitorNotify(SCG_FOSC_CLK, s_tAsyncJob.uCfg.tFosc.pFoscClockErrorNotify);
         }
+        /* set FOSC configuration information */
+        SCG_SetFoscClockStatus(s_tAsyncJob.uCfg.tFosc.u32XtalFreq);
     }
     break;
 
-    default:
-        eStatus = SCG_CLOCK_ERROR;
-        break;
+    case SCG_ASYNCJOB_PLL0:
+    {
+        /* PLL0 feeding the core is left untouched, keep its notify as well */
+        if ((s_tAsyncJob.eStatus != SCG_CLOCK_SEQUENCE_ERROR) &&
+                (true == s_tAsyncJob.uCfg.tPll0.bCm) && (false == s_tAsyncJob.uCfg.tPll0.bCmre))
+        {
+            SCG_SetMonitorNotify(SCG_PLL0_CLK, s_tAsyncJob.uCfg.tPll0.pPll0ClockErrorNotify);
+        }
+        /* set PLL0 configuration information */
+        SCG_SetPll0ClockStatus();
+    }
+    break;
+
+    default:
+        /* clock control jobs update the clock tree when they are started */
+        break;
+    }
+
+    s_tAsyncJob.ePhase = SCG_ASYNC_DONE;
+}
+
+/**
+ * @brief Enter a wait phase of the async job, called with interrupts masked.
+ * @param ePhase: wait phase
+ * @param u32Deadline: deadline in SCG_GET_CYCLES() ticks
+ */
+static void SCG_ArmAsync(SCG_AsyncPhaseType ePhase, uint32_t u32Deadline)
+{
+    s_tAsyncJob.ePhase = ePhase;
+    s_tAsyncJob.u32Start = SCG_GET_CYCLES();
+    s_tAsyncJob.u32Deadline = u32Deadline;
+    s_tAsyncJob.u32Budget = u32Deadline / SCG_WAIT_LOOP_CYCLES;
+}
+
+/**
+ * @brief Check the deadline of the current wait phase, called with interrupts masked.
+ *        The phase expires when SCG_GET_CYCLES() passed the deadline. The poll budget is only a
+ *        backstop for a cycle counter that is not running, every poll takes longer than one loop.
+ * @return true when the phase has expired
+ */
+static bool SCG_IsAsyncExpired(void)
+{
+    bool bExpired = false;
+
+    if (((SCG_GET_CYCLES() - s_tAsyncJob.u32Start) >= s_tAsyncJob.u32Deadline) || (s_tAsyncJob.u32Budget == 0U))
+    {
+        bExpired = true;
+    }
+    else
+    {
+        s_tAsyncJob.u32Budget--;
+    }
+
+    return bExpired;
+}
+
+/**
+ * @brief Start the SOSC job stored in s_tAsyncJob, called with interrupts masked.
+ */
+static void SCG_StartSosc(void)
+{
+    const SCG_SoscType *pSoscConfig = &s_tAsyncJob.uCfg.tSosc;
+    uint32_t u32Temp;
+
+    if (SCG_IsSoscConfigured(pSoscConfig) == true)
+    {
+        /* requested configuration already in effect */
+        s_tAsyncJob.eStatus = (pSoscConfig->bEnable == true) ? SCG_CLOCK_VALID : SCG_CLOCK_DISABLE;
+        SCG_FinishAsync();
+    }
+    else if (pSoscConfig->bEnable == true)
+    {
+        /* configure recommend value */
+        u32Temp = SCG_GetSoscCfgValue();
+        SCG_HWA_SetSoscCfg(u32Temp);
+
+        u32Temp = SCG->SOSCCSR;
+        /* unlock SOSC CSR register */
+        u32Temp &= ~(uint32_t)SCG_SOSCCSR_LK_MASK;
+        SCG_HWA_SetSoscCcr(u32Temp);
+
+        /* Enable SOSC and configure bypass configuration */
+        u32Temp &= ~(uint32_t)SCG_SOSCCSR_BYPASS_MASK;
+        u32Temp |= SCG_SOSCCSR_EN(1U) | SCG_SOSCCSR_BYPASS(pSoscConfig->bBypass);
+        SCG_HWA_SetSoscCcr(u32Temp);
+
+        SCG_ArmAsync(SCG_ASYNC_SOSC_VALID, SCG_GetStartupDeadline(SCG_STARTUP_SOSC, SOSC_STABILIZATION_TIMEOUT));
+    }
+    else
+    {
+        SCG_HWA_DisableSosc();
+        s_tAsyncJob.eStatus = SCG_CLOCK_DISABLE;
+        SCG_ArmAsync(SCG_ASYNC_SOSC_OFF, CLOCK_OFF_STABILIZATION_TIMEOUT * SCG_WAIT_LOOP_CYCLES);
+    }
+}
+
+/**
+ * @brief Start the FOSC job stored in s_tAsyncJob, called with interrupts masked.
+ */
+static void SCG_StartFosc(void)
+{
+    const SCG_FoscType *pFoscConfig = &s_tAsyncJob.uCfg.tFosc;
+    uint32_t u32Temp;
+
+    if (SCG_IsFoscConfigured(pFoscConfig) == true)
+    {
+        /* requested configuration already in effect */
+        s_tAsyncJob.eStatus = (pFoscConfig->bEnable == true) ? SCG_CLOCK_VALID : SCG_CLOCK_DISABLE;
+        SCG_FinishAsync();
+    }
+    else if (pFoscConfig->bEnable == true)
+    {
+        u32Temp = SCG_GetFoscCfgValue(pFoscConfig->bBypass);
+        SCG_HWA_SetFoscCfg(u32Temp);
+
+        u32Temp = SCG->FOSCCSR;
+        u32Temp &= ~(uint32_t)SCG_FOSCCSR_LK_MASK;
+        SCG_HWA_SetFoscCsr(u32Temp);
+
+        /* configure stop enable and enable FOSC */
+        u32Temp &= ~(uint32_t)SCG_FOSCCSR_STEN_MASK;
+        u32Temp |= SCG_FOSCCSR_EN(1U) | SCG_FOSCCSR_STEN(pFoscConfig->bSten);
+        SCG_HWA_SetFoscCsr(u32Temp);
+
+        SCG_ArmAsync(SCG_ASYNC_FOSC_VALID, SCG_GetStartupDeadline(SCG_STARTUP_FOSC, FOSC_STABILIZATION_TIMEOUT));
+    }
+    /* if core clock source if from fosc, must switch core clock source first */
+    else if ((s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_FOSC) ||
+             (s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_PLL0_FOSC))
+    {
+        s_tAsyncJob.eStatus = SCG_CLOCK_SEQUENCE_ERROR;
+        SCG_FinishAsync();
+    }
+    else
+    {
+        SCG_HWA_DisableFosc();
+        s_tAsyncJob.eStatus = SCG_CLOCK_DISABLE;
+        SCG_ArmAsync(SCG_ASYNC_FOSC_OFF, CLOCK_OFF_STABILIZATION_TIMEOUT * SCG_WAIT_LOOP_CYCLES);
+    }
+}
+
+/**
+ * @brief Start the PLL0 job stored in s_tAsyncJob, called with interrupts masked.
+ */
+static void SCG_StartPll0(void)
+{
+    const SCG_Pll0Type *pPll0Config = &s_tAsyncJob.uCfg.tPll0;
+    SCG_StatusType eStatus;
+    uint32_t u32Freq;
+    uint32_t u32Temp;
+
+    if (SCG_IsPll0Configured(pPll0Config) == true)
+    {
+        /* requested configuration already in effect, also allowed while PLL0 is the core clock */
+        s_tAsyncJob.eStatus = (pPll0Config->bEnable == true) ? SCG_CLOCK_VALID : SCG_CLOCK_DISABLE;
+        SCG_FinishAsync();
+    }
+    /* if core clock source if from fosc, must switch core clock source first */
+    else if ((s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_PLL0_FIRC) ||
+             (s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_PLL0_FOSC))
+    {
+        s_tAsyncJob.eStatus = SCG_CLOCK_SEQUENCE_ERROR;
+        SCG_FinishAsync();
+    }
+    else if (true == pPll0Config->bEnable)
+    {
+        switch (pPll0Config->eSrc)
+        {
+        case SCG_PLL0SOURCE_FOSC:
+        {
+            if (s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].eClkStatus == SCG_CLOCK_VALID)
+            {
+                u32Freq = SCG_CalcPll0Freq(s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].u32Freq, false,
+                                           (uint32_t)pPll0Config->ePrediv, (uint32_t)pPll0Config->eMult);
+                if (SCG_CalcPll0InRange(u32Freq, false) == false)
+                {
+                    eStatus = SCG_CLOCK_PARAM_INVALID;
+                }
+                else
+                {
+                    eStatus = SCG_CLOCK_VALID;
+                }
+            }
+            else
+            {
+                eStatus = SCG_CLOCK_ERROR;
+            }
+        }
+        break;
+
+        case SCG_PLL0SOURCE_FIRC:
+        {
+            if (s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].eClkStatus == SCG_CLOCK_VALID)
+            {
+                /*   PLL0 input is FIRC clock/2      */
+                u32Freq = SCG_CalcPll0Freq(s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].u32Freq, true,
+                                           (uint32_t)pPll0Config->ePrediv, (uint32_t)pPll0Config->eMult);
+                if (SCG_CalcPll0InRange(u32Freq, true) == false)
+                {
+                    eStatus = SCG_CLOCK_PARAM_INVALID;
+                }
+                else
+                {
+                    eStatus = SCG_CLOCK_VALID;
+                }
+            }
+            else
+            {
+                eStatus = SCG_CLOCK_ERROR;
+            }
+        }
+        break;
+
+        default:
+            eStatus = SCG_CLOCK_ERROR;
+            break;
+        }
+
+        if (eStatus == SCG_CLOCK_VALID)
+        {
+            SCG_SeqWritePll0Cfg((uint32_t)pPll0Config->eSrc, (uint32_t)pPll0Config->ePrediv, (uint32_t)pPll0Config->eMult);
+
+            u32Temp = SCG_PLL0CSR_EN(pPll0Config->bEnable)  | SCG_PLL0CSR_STEN(pPll0Config->bSten);
+            SCG_HWA_SetPll0Csr(u32Temp);
+
+            SCG_ArmAsync(SCG_ASYNC_PLL0_LOCK, SCG_GetStartupDeadline(SCG_STARTUP_PLL0, PLL0_STABILIZATION_TIMEOUT));
+        }
+        else
+        {
+            s_tAsyncJob.eStatus = eStatus;
+            SCG_FinishAsync();
+        }
+    }
+    else
+    {
+        s_tAsyncJob.eStatus = SCG_CLOCK_DISABLE;
+        /* Unlock PLL0 */
+        SCG_HWA_UnlockPll0();
+        /* Disable PLL0 */
+        SCG_HWA_DisablePll0();
+
+        SCG_ArmAsync(SCG_ASYNC_PLL0_OFF, CLOCK_OFF_STABILIZATION_TIMEOUT * SCG_WAIT_LOOP_CYCLES);
+    }
+}
+
+/**
+ * @brief Advance the pending async job by one poll, called with interrupts masked.
+ *        Every wait phase checks its condition once, the deadlines are based on the time since the
+ *        phase started so they do not depend on the poll rate. Divider ACK waits never fail, same as before.
+ */
+static void SCG_StepAsync(void)
+{
+    uint32_t u32Temp;
+    bool bExpired;
+    bool bDone;
+
+    bExpired = SCG_IsAsyncExpired();
+
+    switch (s_tAsyncJob.ePhase)
+    {
+    case SCG_ASYNC_SOSC_VALID:
+    {
+        if (SCG_HWA_GetSoscValid() == true)
+        {
+            SCG_RecordStartup(SCG_STARTUP_SOSC, SCG_GET_CYCLES() - s_tAsyncJob.u32Start, false);
+            u32Temp = SCG->SOSCCSR;
+            /* Configure CM CMRE and lock  */
+            u32Temp |= SCG_SOSCCSR_CM(s_tAsyncJob.uCfg.tSosc.bCm);
+            SCG_HWA_SetSoscCcr(u32Temp);
+
+            u32Temp &= ~(uint32_t)SCG_SOSCCSR_CMRE_MASK;
+            u32Temp |= SCG_SOSCCSR_CMRE(s_tAsyncJob.uCfg.tSosc.bCmre) |
+                       SCG_SOSCCSR_LK(s_tAsyncJob.uCfg.tSosc.bLock);
+            SCG_HWA_SetSoscCcr(u32Temp);
+
+            s_tAsyncJob.eStatus = SCG_CLOCK_VALID;
+            SCG_FinishAsync();
+        }
+        else if (bExpired == true)
+        {
+            SCG_RecordStartup(SCG_STARTUP_SOSC, s_tAsyncJob.u32Deadline, true);
+            s_tAsyncJob.eStatus = SCG_CLOCK_TIMEOUT;
+            SCG_FinishAsync();
+        }
+    }
+    break;
+
+    case SCG_ASYNC_FOSC_VALID:
+    {
+        if (SCG_HWA_GetFoscValid() == true)
+        {
+            SCG_RecordStartup(SCG_STARTUP_FOSC, SCG_GET_CYCLES() - s_tAsyncJob.u32Start, false);
+            u32Temp = SCG->FOSCCSR;
+            /* Configure CM CMRE and lock */
+            u32Temp |= SCG_FOSCCSR_CM(s_tAsyncJob.uCfg.tFosc.bCm);
+            SCG_HWA_SetFoscCsr(u32Temp);
+
+            u32Temp &= ~(uint32_t)SCG_FOSCCSR_CMRE_MASK;
+            u32Temp |= SCG_FOSCCSR_CMRE(s_tAsyncJob.uCfg.tFosc.bCmre) | SCG_FOSCCSR_LK(s_tAsyncJob.uCfg.tFosc.bLock);
+            SCG_HWA_SetFoscCsr(u32Temp);
+
+            s_tAsyncJob.eStatus = SCG_CLOCK_VALID;
+
+            /*
+                DIV setting process:
+                MCU_FC4150_512K:   Clear FOSCDIV[DIVH_EN] --> Configure FOSCDIV[DIVH] --> Set FOSCDIV[DIVH_EN]
+                MCU_FC4150_2M:    Clear FOSCDIV[DIVH_EN], wait FOSCDIV[DIVH_ACK] clear
+                                --> Configure FIRCDIV[DIVH]
+                                --> Set FOSCDIV[DIVH_EN], wait FOSCDIV[DIVH_ACK] is set
+            */
+            SCG_HWA_DiableFoscDiv();
+            SCG_ArmAsync(SCG_ASYNC_FOSC_DIV_OFF, CLOCK_DIV_STABILIZATION_TIMEOUT * SCG_WAIT_LOOP_CYCLES);
+        }
+        else if (bExpired == true)
+        {
+            SCG_RecordStartup(SCG_STARTUP_FOSC, s_tAsyncJob.u32Deadline, true);
+            s_tAsyncJob.eStatus = SCG_CLOCK_TIMEOUT;
+            SCG_FinishAsync();
+        }
+    }
+    break;
+
+    case SCG_ASYNC_FOSC_DIV_OFF:
+    {
+        if ((SCG_SeqIsDivAck(2U, (uint32_t)(SCG_FOSCDIV_DIVH_ACK_MASK | SCG_FOSCDIV_DIVM_ACK_MASK | SCG_FOSCDIV_DIVL_ACK_MASK), false) == true) ||
+                (bExpired == true))
+        {
+            u32Temp = SCG->FOSCDIV;
+            u32Temp &= ~(uint32_t)(SCG_FOSCDIV_DIVL_MASK | SCG_FOSCDIV_DIVM_MASK | SCG_FOSCDIV_DIVH_MASK);
+            u32Temp |= ((((uint32_t)s_tAsyncJob.uCfg.tFosc.eDivH << SCG_FOSCDIV_DIVH_SHIFT) & SCG_FOSCDIV_DIVH_MASK) |
+                        (((uint32_t)s_tAsyncJob.uCfg.tFosc.eDivM << SCG_FOSCDIV_DIVM_SHIFT) & SCG_FOSCDIV_DIVM_MASK) |
+                        (((uint32_t)s_tAsyncJob.uCfg.tFosc.eDivL << SCG_FOSCDIV_DIVL_SHIFT) & SCG_FOSCDIV_DIVL_MASK));
+            SCG_HWA_SetFoscDiv(u32Temp) ;
+
+            SCG_HWA_EnableFoscDiv();
+            SCG_ArmAsync(SCG_ASYNC_FOSC_DIV_ON, CLOCK_DIV_STABILIZATION_TIMEOUT * SCG_WAIT_LOOP_CYCLES);
+        }
+    }
+    break;
+
+    case SCG_ASYNC_FOSC_DIV_ON:
+    {
+        u32Temp = (uint32_t)(SCG_FOSCDIV_DIVH_ACK_MASK | SCG_FOSCDIV_DIVM_ACK_MASK | SCG_FOSCDIV_DIVL_ACK_MASK);
+        if ((SCG_SeqIsDivAck(2U, u32Temp, true) == true) || (bExpired == true))
+        {
+            SCG_FinishAsync();
+        }
+    }
+    break;
+
+    case SCG_ASYNC_PLL0_LOCK:
+    {
+        if (SCG_HWA_GetPll0Locked() == true)
+        {
+            SCG_RecordStartup(SCG_STARTUP_PLL0, SCG_GET_CYCLES() - s_tAsyncJob.u32Start, false);
+            u32Temp = SCG->PLL0CSR;
+            /* Configure CM CMRE and lock */
+            u32Temp |= SCG_PLL0CSR_CM(s_tAsyncJob.uCfg.tPll0.bCm);
+            SCG_HWA_SetPll0Csr(u32Temp);
+            u32Temp |= SCG_PLL0CSR_CMRE(s_tAsyncJob.uCfg.tPll0.bCmre) | SCG_PLL0CSR_LK(s_tAsyncJob.uCfg.tPll0.bLock);
+            SCG_HWA_SetPll0Csr(u32Temp);
+
+            s_tAsyncJob.eStatus = SCG_CLOCK_VALID;
+
+            /*
+                DIV setting process:
+                MCU_FC4150_512K:   Clear PLL0DIV[DIVH_EN] --> Configure PLL0DIV[DIVH] --> Set PLL0DIV[DIVH_EN]
+                MCU_FC4150_2M:    Clear PLL0DIV[DIVH_EN], wait PLL0DIV[DIVH_ACK] clear
+                                --> Configure FIRCDIV[DIVH]
+                                --> Set PLL0DIV[DIVH_EN], wait PLL0DIV[DIVH_ACK] is set
+            */
+            SCG_HWA_DiablePll0Div();
+            SCG_ArmAsync(SCG_ASYNC_PLL0_DIV_OFF, CLOCK_DIV_STABILIZATION_TIMEOUT * SCG_WAIT_LOOP_CYCLES);
+        }
+        else if (bExpired == true)
+        {
+            SCG_RecordStartup(SCG_STARTUP_PLL0, s_tAsyncJob.u32Deadline, true);
+            s_tAsyncJob.eStatus = SCG_CLOCK_TIMEOUT;
+            SCG_FinishAsync();
+        }
+    }
+    break;
+
+    case SCG_ASYNC_PLL0_DIV_OFF:
+    {
+        if ((SCG_SeqIsDivAck(3U, (uint32_t)(SCG_PLL0DIV_DIVL_ACK_MASK | SCG_PLL0DIV_DIVM_ACK_MASK | SCG_PLL0DIV_DIVH_ACK_MASK), false) == true) ||
+                (bExpired == true))
+        {
+            u32Temp = (uint32_t)((((uint32_t)s_tAsyncJob.uCfg.tPll0.eDivH << SCG_PLL0DIV_DIVH_SHIFT) & SCG_PLL0DIV_DIVH_MASK) |
+                                 (((uint32_t)s_tAsyncJob.uCfg.tPll0.eDivM << SCG_PLL0DIV_DIVM_SHIFT) & SCG_PLL0DIV_DIVM_MASK) |
+                                 (((uint32_t)s_tAsyncJob.uCfg.tPll0.eDivL << SCG_PLL0DIV_DIVL_SHIFT) & SCG_PLL0DIV_DIVL_MASK));
+            SCG_HWA_SetPll0Div(u32Temp);
+
+            SCG_HWA_EnablePll0Div();
+            SCG_ArmAsync(SCG_ASYNC_PLL0_DIV_ON, CLOCK_DIV_STABILIZATION_TIMEOUT * SCG_WAIT_LOOP_CYCLES);
+        }
+    }
+    break;
+
+    case SCG_ASYNC_PLL0_DIV_ON:
+    {
+        u32Temp = (uint32_t)(SCG_PLL0DIV_DIVH_ACK_MASK | SCG_PLL0DIV_DIVM_ACK_MASK | SCG_PLL0DIV_DIVL_ACK_MASK);
+        if ((SCG_SeqIsDivAck(3U, u32Temp, true) == true) || (bExpired == true))
+        {
+            SCG_FinishAsync();
+        }
+    }
+    break;
+
+    case SCG_ASYNC_SOSC_OFF:
+    case SCG_ASYNC_FOSC_OFF:
+    case SCG_ASYNC_PLL0_OFF:
+    {
+        if (s_tAsyncJob.ePhase == SCG_ASYNC_SOSC_OFF)
+        {
+            bDone = (SCG_HWA_GetSoscValid() == false);
+        }
+        else if (s_tAsyncJob.ePhase == SCG_ASYNC_FOSC_OFF)
+        {
+            bDone = (SCG_HWA_GetFoscValid() == false);
+        }
+        else
+        {
+            bDone = (SCG_HWA_GetPll0Locked() == false);
+        }
+
+        /* disable status is reported even if the clock is still running at the deadline */
+        if ((bDone == true) || (bExpired == true))
+        {
+            SCG_FinishAsync();
+        }
+    }
+    break;
+
+    default:
+        /* SCG_ASYNC_IDLE and SCG_ASYNC_DONE have nothing to advance */
+        break;
+    }
+}
+
+/**
+ * @brief Claim the async job slot for a new job.
+ * @return false if another job is still pending or its completion is not delivered yet
+ */
+static bool SCG_ClaimAsync(SCG_AsyncJobKindType eKind, SCG_AsyncDoneCallBackType pDone, void *pContext)
+{
+    bool bResult;
+
+    if (s_tAsyncJob.ePhase != SCG_ASYNC_IDLE)
+    {
+        bResult = false;
+    }
+    else
+    {
+        s_tAsyncJob.eKind = eKind;
+        s_tAsyncJob.pDone = pDone;
+        s_tAsyncJob.pContext = pContext;
+        s_tAsyncJob.eStatus = SCG_CLOCK_ERROR;
+        s_tAsyncJob.u32Budget = 0U;
+        bResult = true;
+    }
+
+    return bResult;
+}
+
+/**
+ * @brief Completion callback of the blocking setters, pContext is their SCG_AsyncWaitType.
+ */
+static void SCG_AsyncWaitDone(SCG_StatusType eStatus, void *pContext)
+{
+    SCG_AsyncWaitType *pWait = (SCG_AsyncWaitType *)pContext;
+
+    pWait->eStatus = eStatus;
+    pWait->bDone = true;
+}
+
+/**
+ * @brief Drive the async job of a blocking setter to completion.
+ *        The result is taken from the completion, so it is the right one even when SCG_IRQHandler
+ *        or another context delivers the job.
+ * @param pWait: wait record passed as pContext of SCG_AsyncWaitDone when the job was started
+ * @return result of the job
+ */
+static SCG_StatusType SCG_AsyncWait(const SCG_AsyncWaitType *pWait)
+{
+    while (pWait->bDone == false)
+    {
+        (void)SCG_PollAsync();
+    }
+
+    return pWait->eStatus;
+}
+
+/**
+ * @brief Build s_tClockSequenceInfo from the SCG registers.
+ * @param u32FoscFreq: FOSC crystal frequency, UNKNOWN_CLOCK if not known
+ * @param u32SoscFreq: SOSC crystal frequency, UNKNOWN_CLOCK if not known
+ */
+static void SCG_ReadClockTree(uint32_t u32FoscFreq, uint32_t u32SoscFreq)
+{
+    /* check if FIRC is valid, then set s_tScgClockInfo[SCG_FIRC_CLK] to valid value */
+    SCG_SetFircClockStatus();
+
+    /* check if SIRC is valid, then set s_tScgClockInfo[SCG_SIRC_CLK] to valid value */
+    SCG_SetSircClockStatus();
+
+    /* check if FOSC is valid, then set s_tScgClockInfo[SCG_FOSC_CLK] to valid value */
+    SCG_SetFoscClockStatus(u32FoscFreq);
+
+    /* check if SIRC32K is valid, then set s_tScgClockInfo[SCG_SIRC32K_CLK] to valid value */
+    SCG_SetSirc32kClockStatus();
+
+    /* check if SOSC is valid, then set s_tScgClockInfo[SCG_SOSC_CLK] to valid value */
+    SCG_SetSoscClockStatus(u32SoscFreq);
+
+    /* check if PLL0 is valid, then set s_tScgClockInfo[SCG_PLL0_CLK] to valid value */
+    SCG_SetPll0ClockStatus();
+
+    /* check clock out configuration */
+    SCG_SetClockOutStatus();
+
+    /* check core clock configuration */
+    SCG_SetCoreClockStatus();
+}
+
+/**
+ * @brief Hash of the SCG status and configuration registers the clock tree is derived from.
+ */
+static uint32_t SCG_GetAuditHash(void)
+{
+    uint32_t au32Reg[13U];
+
+    au32Reg[0U] = SCG->FIRCCSR;
+    au32Reg[1U] = SCG->FIRCDIV;
+    au32Reg[2U] = SCG->SIRCCSR;
+    au32Reg[3U] = SCG->SIRCDIV;
+    au32Reg[4U] = SCG->SIRC32KCSR;
+    au32Reg[5U] = SCG->FOSCCSR;
+    au32Reg[6U] = SCG->FOSCDIV;
+    au32Reg[7U] = SCG->SOSCCSR;
+    au32Reg[8U] = SCG->PLL0CSR;
+    au32Reg[9U] = SCG->PLL0DIV;
+    au32Reg[10U] = SCG->PLL0CFG;
+    au32Reg[11U] = SCG->CSR;
+    au32Reg[12U] = SCG->CLKOUTCFG;
+
+    return SCG_CalcHashWords(au32Reg, 13U);
+}
+
+/**
+ * @brief Exact frequency of a root source or of PLL0, from the root frequencies of the clock tree.
+ *        Other nodes and sources that are not valid give 0.
+ */
+static void SCG_GetExactSrcFreq(SCG_ClkSrcType eNode, SCG_CalcFreqType *pFreq)
+{
+    SCG_ClkSrcType eRef;
+
+    pFreq->u64Num = 0U;
+    pFreq->u32Den = 1U;
+    switch (eNode)
+    {
+    case SCG_FIRC_CLK:
+    case SCG_SIRC_CLK:
+    case SCG_SIRC32K_CLK:
+    case SCG_FOSC_CLK:
+    case SCG_SOSC_CLK:
+        if (s_tClockSequenceInfo.tClockInfo[eNode].eClkStatus == SCG_CLOCK_VALID)
+        {
+            pFreq->u64Num = s_tClockSequenceInfo.tClockInfo[eNode].u32Freq;
+        }
+        break;
+    case SCG_PLL0_CLK:
+        eRef = (SCG_HWA_GetPll0Src() == SCG_PLL0SOURCE_FIRC) ? SCG_FIRC_CLK : SCG_FOSC_CLK;
+        if ((s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].eClkStatus == SCG_CLOCK_VALID) &&
+                (s_tClockSequenceInfo.tClockInfo[eRef].eClkStatus == SCG_CLOCK_VALID))
+        {
+            pFreq->u64Num = s_tClockSequenceInfo.tClockInfo[eRef].u32Freq;
+            SCG_CalcFreqScale(pFreq, (uint32_t)SCG_HWA_GetPll0Mult() + 16U,
+                              2U * ((uint32_t)SCG_HWA_GetPll0Prediv() + 1U));
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Exact frequency of any clock node, following its path from the root source through the
+ *        PLL0, async divider and CCR settings currently in the registers.
+ */
+static void SCG_GetExactFreq(SCG_ClkSrcType eNode, SCG_CalcFreqType *pFreq)
+{
+    SCG_ClkSrcType eSrc = eNode;
+    uint8_t u8SrcIdx;
+    uint8_t u8Out;
+    uint32_t u32Div = 0U;
+
+    switch (eNode)
+    {
+    case SCG_SCG_CLKOUT_CLK:
+        switch ((SCG_ClockoutSrcType)SCG_HWA_GetClkOutCfg())
+        {
+        case SCG_CLOCKOUT_SRC_FOSC:
+            eSrc = SCG_FOSC_CLK;
+            break;
+        case SCG_CLOCKOUT_SRC_SIRC:
+            eSrc = SCG_SIRC_CLK;
+            break;
+        case SCG_CLOCKOUT_SRC_FIRC:
+            eSrc = SCG_FIRC_CLK;
+            break;
+        case SCG_CLOCKOUT_SRC_SOSC:
+            eSrc = SCG_SOSC_CLK;
+            break;
+        case SCG_CLOCKOUT_SRC_PLL0:
+            eSrc = SCG_PLL0_CLK;
+            break;
+        case SCG_CLOCKOUT_SRC_SIRC32K:
+            eSrc = SCG_SIRC32K_CLK;
+            break;
+        default:
+            eSrc = SCG_END_OF_CLOCKS;
+            break;
+        }
+        SCG_GetExactSrcFreq(eSrc, pFreq);
+        break;
+    case SCG_CORE_CLK:
+    case SCG_BUS_CLK:
+    case SCG_SLOW_CLK:
+        switch (SCG_HWA_GetSysClkSrc())
+        {
+        case SCG_CLOCK_SRC_FIRC:
+            eSrc = SCG_FIRC_CLK;
+            break;
+        case SCG_CLOCK_SRC_FOSC:
+            eSrc = SCG_FOSC_CLK;
+            break;
+        case SCG_CLOCK_SRC_PLL0:
+            eSrc = SCG_PLL0_CLK;
+            break;
+        default:
+            eSrc = SCG_END_OF_CLOCKS;
+            break;
+        }
+        SCG_GetExactSrcFreq(eSrc, pFreq);
+        SCG_CalcFreqScale(pFreq, 1U, (uint32_t)SCG_HWA_GetSysClkDivCore() + 1U);
+        if (eNode == SCG_BUS_CLK)
+        {
+            SCG_CalcFreqScale(pFreq, 1U, (uint32_t)SCG_HWA_GetSysClkDivBus() + 1U);
+        }
+        else if (eNode == SCG_SLOW_CLK)
+        {
+            SCG_CalcFreqScale(pFreq, 1U, (uint32_t)SCG_HWA_GetSysClkDivSlow() + 1U);
+        }
+        else
+        {
+            /* core clock */
+        }
+        break;
+    default:
+        for (u8SrcIdx = 0U; u8SrcIdx < 4U; u8SrcIdx++)
+        {
+            for (u8Out = 0U; u8Out < 3U; u8Out++)
+            {
+                if ((eNode != SCG_END_OF_CLOCKS) && (s_eAsyncDivNode[u8SrcIdx][u8Out] == eNode))
+                {
+                    eSrc = s_eAsyncDivSrc[u8SrcIdx];
+                    u32Div = (SCG_SeqGetDivReg(u8SrcIdx) & s_tSeqDivField[u8SrcIdx][u8Out].u32DivMask) >>
+                             s_tSeqDivField[u8SrcIdx][u8Out].u32DivShift;
+                }
+            }
+        }
+        SCG_GetExactSrcFreq(eSrc, pFreq);
+        if (eSrc != eNode)
+        {
+            /* async divider output, DIV n divides by 2^(n-1) and 0 disables the output */
+            SCG_CalcFreqScale(pFreq, (u32Div == 0U) ? 0U : 1U, (u32Div == 0U) ? 1U : (1UL << (u32Div - 1U)));
+        }
+        break;
+    }
+}
+
+/**
+ * @brief Switch the NVM clock source, the old source is disabled before the new one is enabled.
+ * @param u32ClkOutCfg: CLKOUTCFG value with the NVMCLK bits cleared
+ * @param u32NvmClk: NVMCLK bits to enable
+ */
+static void SCG_WriteNvmClk(uint32_t u32ClkOutCfg, uint32_t u32NvmClk)
+{
+    SCG_HWA_SetClkOutCfg(u32ClkOutCfg);
+    SCG_HWA_SetClkOutCfg(u32ClkOutCfg | u32NvmClk);
+}
+
+/* ################################################################################## */
+/* ################################ Global Functions ################################ */
+
+/**
+ * @brief Description SCG module maintains a list of SCG clock frequency and status.
+ *  Which defined in global data instance as SCG_ClockInfoType s_tScgClockInfo[SCG_END_OF_CLOCKS],
+ *  the nodes start unknown and are read from the registers on their first access.
+ *  This function reads all nodes not read yet, APIs that only need some nodes probe just those.
+ */
+void SCG_InitClockSrcStatus(void)
+{
+    SCG_ProbeClocks(SCG_PROBE_ALL);
+}
+
+/**
+ * @brief Set SOSC configuration.
+ * @param pSoscConfig: pointer to the soccType structure variable, which defined SOSC initial information.
+ * @return true or false. SOSC would wait for SOSC valid in while loop within pre-dinfined limited time to check the SOSC valid or not.
+ *         If SOSC still not valid(this may happen if external Slow OSC not placed),  it would return fail
+ * @note Returns without touching the hardware when the requested configuration is already in effect.
+ */
+SCG_StatusType SCG_SetSOSC(SCG_SoscType *pSoscConfig)
+{
+    SCG_AsyncWaitType tWait = {false, SCG_CLOCK_ERROR};
+
+    while (SCG_SetSOSCAsync(pSoscConfig, SCG_AsyncWaitDone, &tWait) == false)
+    {
+        /* finish the pending async job first */
+        (void)SCG_PollAsync();
+    }
+
+    return SCG_AsyncWait(&tWait);
+}
+
+/**
+ * \brief Set FOSC configuration
+ *
+ * \param pFoscConfig: pointer to the FOSCType structure data instance, which defined FOSC initial information.
+ * \return  true or false. FOSCwould wait for FOSC valid in while loop within pre-dinfined limited time to check the FOSC valid or not.
+ *          If FOSC still not valid(this may happen if external Fast OSC not placed),  it would return fail.
+ * \note Returns without touching the hardware when the requested configuration is already in effect.
+ */
+SCG_StatusType SCG_SetFOSC(SCG_FoscType *pFoscConfig)
+{
+    SCG_AsyncWaitType tWait = {false, SCG_CLOCK_ERROR};
+
+    while (SCG_SetFOSCAsync(pFoscConfig, SCG_AsyncWaitDone, &tWait) == false)
+    {
+        /* finish the pending async job first */
+        (void)SCG_PollAsync();
+    }
+
+    return SCG_AsyncWait(&tWait);
+}
+
+/**
+ * \brief Set SIRC configuration.
+ * \param pSircConfig: pointer to the SIRCType structure data instance, which defined SIRC initial information
+ * \return true or false. SIRCwould wait for SIRC valid in while loop within pre-dinfined limited time
+ *         to check the SIRC valid or not. If SOSC still not valid,  it would return fail.
+ * \note Returns without touching the hardware when the requested configuration is already in effect.
+ */
+SCG_StatusType SCG_SetSIRC(SCG_SircType *pSircConfig)
+{
+    SCG_StatusType eStatus;
+    uint32_t u32Temp;
+
+    /* probe only the clock nodes this function reads */
+    SCG_ProbeClocks(SCG_PROBE_SIRC);
+
+    if (SCG_IsSircConfigured(pSircConfig) == true)
+    {
+        /* requested configuration already in effect */
+        eStatus = SCG_CLOCK_VALID;
+    }
+    else
+    {
+        u32Temp = SCG->SIRCCSR;
+        u32Temp &= ~(uint32_t)(SCG_SIRCCSR_CM_MASK | SCG_SIRCCSR_LK_MASK | SCG_SIRCCSR_TRUP_MASK |
+                               SCG_SIRCCSR_TREN_MASK | SCG_SIRCCSR_LPEN_MASK |
+                               SCG_SIRCCSR_STEN_MASK);
+        u32Temp |= (uint32_t)(SCG_SIRCCSR_CM(pSircConfig->bCm) | SCG_SIRCCSR_LK(pSircConfig->bLock) |
+                              SCG_SIRCCSR_TRUP(pSircConfig->bTrEn) |
+                              SCG_SIRCCSR_TREN(pSircConfig->bTrEn) |
+                              SCG_SIRCCSR_LPEN(pSircConfig->bLpen) |
+                              SCG_SIRCCSR_STEN(pSircConfig->bSten));
+        SCG_HWA_SetSircCsr(u32Temp);
+
+        /*               Check SIRC valid                       */
+        u32Temp = SIRC_STABILIZATION_TIMEOUT;
+        while ((SCG_HWA_GetSircValid() == false) && (u32Temp > 0U))
+        {
+            u32Temp--;
+        }
+
+        if (u32Temp != 0U)
+        {
+            eStatus = SCG_CLOCK_VALID;
+        }
+        else
+        {
+            eStatus = SCG_CLOCK_TIMEOUT;
+        }
+
+        if (eStatus == SCG_CLOCK_VALID)
+        {
+            /*
+                DIV setting process:
+                MCU_FC4150_512K:   Clear SIRCDIV[DIVH_EN] --> Configure SIRCDIV[DIVH] --> Set SIRCDIV[DIVH_EN]
+                MCU_FC4150_2M:    Clear SIRCDIV[DIVH_EN], wait SIRCDIV[DIVH_ACK] clear
+                                --> Configure FIRCDIV[DIVH]
+                                --> Set SIRCDIV[DIVH_EN], wait SIRCDIV[DIVH_ACK] is set
+            */
+            SCG_HWA_DiableSircDiv();
+            (void)SCG_SeqWaitDivAck(1U, (uint32_t)(SCG_SIRCDIV_DIVH_ACK_MASK | SCG_SIRCDIV_DIVM_ACK_MASK |
+                                      SCG_SIRCDIV_DIVL_ACK_MASK), false);
+            u32Temp = SCG->SIRCDIV;
+            u32Temp &= ~(uint32_t)(SCG_SIRCDIV_DIVL_MASK | SCG_SIRCDIV_DIVM_MASK | SCG_SIRCDIV_DIVH_MASK);
+            u32Temp |= (uint32_t)((((uint32_t)pSircConfig->eDivH << SCG_SIRCDIV_DIVH_SHIFT) & SCG_SIRCDIV_DIVH_MASK) |
+                                  (((uint32_t)pSircConfig->eDivM << SCG_SIRCDIV_DIVM_SHIFT) & SCG_SIRCDIV_DIVM_MASK) |
+                                  (((uint32_t)pSircConfig->eDivL << SCG_SIRCDIV_DIVL_SHIFT) & SCG_SIRCDIV_DIVL_MASK));
+            SCG_HWA_SetSircDiv(u32Temp);
+            SCG_HWA_EnableSircDiv();
+            (void)SCG_SeqWaitDivAck(1U, (uint32_t)(SCG_SIRCDIV_DIVH_ACK_MASK | SCG_SIRCDIV_DIVM_ACK_MASK |
+                                      SCG_SIRCDIV_DIVL_ACK_MASK), true);
+
+            /*   SIRC  configuration SIRCTCFG    */
+            if (pSircConfig->bTrEn == false)
+            {
+                /*   Trim enalbe disabled, just using IC internal IRC trim value */
+            }
+            else
+            {
+                /*   set SIRCTCFG trim configuration    */
+                u32Temp = SCG_GetSircTcfgValue(pSircConfig);
+                SCG_HWA_SetSircTcfg(u32Temp);
+            }
+
+        }
+    }
+
+    if(true == pSircConfig->bCm)
+    {
+        SCG_SetMonitorNotify(SCG_SIRC_CLK, pSircConfig->pSircClockErrorNotify);
+    }
+
+    /* set SIRC configuration information */
+    SCG_SetSircClockStatus();
+
+    return eStatus;
+}
+
+/**
+ * \brief Set SIRC32K configuration.
+ * \param pSirc32kConfig: pointer to the Sirc32kType structure data instance, which defined SIRC32K initial information
+ * \return true or false.
+ */
+SCG_StatusType SCG_SetSIRC32K(SCG_Sirc32kType *pSirc32kConfig)
+{
+    SCG_StatusType eStatus;
+    uint32_t u32Temp = 0U;
+
+    /* probe only the clock nodes this function reads */
+    SCG_ProbeClocks(SCG_PROBE_SIRC32K);
+
+    u32Temp = (uint32_t)(SCG_SIRC32KCSR_LK(pSirc32kConfig->bLock) | SCG_SIRC32KCSR_EN(pSirc32kConfig->bEn));
+    SCG_HWA_SetSirc32kCsr(u32Temp);
+
+    /*               Check SIRC valid                       */
+    u32Temp = SIRC_STABILIZATION_TIMEOUT;
+    while ((SCG_HWA_GetSirc32kValid() == false) && (u32Temp > 0U))
+    {
+        u32Temp--;
+    }
+
+    if (u32Temp == 0U)
+    {
+        eStatus = SCG_CLOCK_TIMEOUT;
+    }
+    else
+    {
+        eStatus = SCG_CLOCK_VALID;
+    }
+
+    /* set SIRC32K configuration information */
+    SCG_SetSirc32kClockStatus();
+
+    return eStatus;
+}
+
+/**
+ * \brief Set FIRC configuration.
+ * \param pFircConfig: pointer to the FIRCType structure data instance, which defined FIRC initial information.
+ * \return true or false. FIRCwould wait for FIRC valid in while loop within pre-dinfined limited time
+ *         to check the FIRC valid or not. If FIRC still not valid,  it would return fail.
+ * \note Returns without touching the hardware when the requested configuration is already in effect.
+ */
+SCG_StatusType SCG_SetFIRC(SCG_FircType *pFircConfig)
+{
+    SCG_StatusType eStatus;
+    uint32_t u32Temp;
+
+    /* probe only the clock nodes this function reads */
+    SCG_ProbeClocks(SCG_PROBE_FIRC | SCG_PROBE_CORE);
+
+    /*            Set FIRCCSR           */
+    if (SCG_IsFircConfigured(pFircConfig) == true)
+    {
+        /* requested configuration already in effect */
+        eStatus = (pFircConfig->bEnable == true) ? SCG_CLOCK_VALID : SCG_CLOCK_DISABLE;
+    }
+    else if (pFircConfig->bEnable == true)
+    {
+        SCG_HWA_SetFircCfg(SCG_FIRCCFG_CLKEN(3U));
+
+        u32Temp = SCG->FIRCCSR;
+        u32Temp &= ~(uint32_t)(SCG_FIRCCSR_TRUP_MASK | SCG_FIRCCSR_TREN_MASK | SCG_FIRCCSR_STEN_MASK);
+        u32Temp |= (uint32_t)(SCG_FIRCCSR_TRUP(pFircConfig->bTrEn) |    /*    configure TRUP and EN together with TREN setting   */
+                              SCG_FIRCCSR_TREN(pFircConfig->bTrEn) |
+                              SCG_FIRCCSR_STEN(pFircConfig->bSten) |
+                              SCG_FIRCCSR_EN(1U));
+        SCG_HWA_SetFircCsr(u32Temp);
+
+        u32Temp = FIRC_STABILIZATION_TIMEOUT;
+        /*               Check FIRC valid                       */
+        while ((SCG_HWA_GetFircValid() == false) && (u32Temp > 0U))
+        {
+            u32Temp--;
+        }
+
+        if (u32Temp != 0U)
+        {
+            /* Configure CM and lock */
+            u32Temp = SCG->FIRCCSR;
+            u32Temp |= (uint32_t)SCG_FIRCCSR_CM(pFircConfig->bCm);
+            SCG_HWA_SetFircCsr(u32Temp);
+            u32Temp |= (uint32_t)SCG_FIRCCSR_LK(pFircConfig->bLock);
+            SCG_HWA_SetFircCsr(u32Temp);
+
+            eStatus = SCG_CLOCK_VALID;
+        }
+        else
+        {
+            eStatus = SCG_CLOCK_TIMEOUT;
+        }
+
+        if (eStatus == SCG_CLOCK_VALID)
+        {
+            /*               Set FIRCDIV                       */
+            /*
+            	DIV setting process:
+            	MCU_FC4150_512K:   Clear FIRCDIV[DIVH_EN] --> Configure FIRCDIV[DIVH] --> Set FIRCDIV[DIVH_EN]
+            	MCU_FC4150_2M:    Clear FIRCDIV[DIVH_EN], wait FIRCDIV[DIVH_ACK] clear
+            					--> Configure FIRCDIV[DIVH]
+            					--> Set FIRCDIV[DIVH_EN], wait FIRCDIV[DIVH_ACK] is set
+            */
+            SCG_HWA_DiableFircDiv();
+            (void)SCG_SeqWaitDivAck(0U, (uint32_t)(SCG_FIRCDIV_DIVH_ACK_MASK | SCG_FIRCDIV_DIVM_ACK_MASK |
+                                      SCG_FIRCDIV_DIVL_ACK_MASK), false);
+            u32Temp = SCG->FIRCDIV;
+            u32Temp &= ~(uint32_t)(SCG_FIRCDIV_DIVL_MASK | SCG_FIRCDIV_DIVM_MASK | SCG_FIRCDIV_DIVH_MASK);
+            u32Temp |= (uint32_t)((((uint32_t)pFircConfig->eDivH << SCG_FIRCDIV_DIVH_SHIFT) & SCG_FIRCDIV_DIVH_MASK) |
+                                  (((uint32_t)pFircConfig->eDivM << SCG_FIRCDIV_DIVM_SHIFT) & SCG_FIRCDIV_DIVM_MASK) |
+                                  (((uint32_t)pFircConfig->eDivL << SCG_FIRCDIV_DIVL_SHIFT) & SCG_FIRCDIV_DIVL_MASK));
+
+            SCG_HWA_SetFircDiv(u32Temp);
+            SCG_HWA_EnableFircDiv();
+            (void)SCG_SeqWaitDivAck(0U, (uint32_t)(SCG_FIRCDIV_DIVH_ACK_MASK | SCG_FIRCDIV_DIVM_ACK_MASK |
+                                      SCG_FIRCDIV_DIVL_ACK_MASK), true);
+
+            /*   For clock autotrim, set TREN to True together with TRUP to True   */
+            if (pFircConfig->bTrEn == true)
+            {
+                /*   set FIRCTCFG trim configuration    */
+                u32Temp = SCG_GetFircTcfgValue(pFircConfig);
+                SCG_HWA_SetFircTcfg(u32Temp);
+            }
+            else
+            {
+                /*   Trim disabled, just using IC internal IRC trim value */
+            }
+
+        }
+        else
+        {
+            SCG_HWA_DisableFirc();
+        }
+    }
+    else
+    {
+        /* if core clock source if from fosc, must switch core clock source first */
+        if ((s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_FIRC) ||
+                (s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_PLL0_FIRC))
+        {
+            eStatus = SCG_CLOCK_SEQUENCE_ERROR;
+        }
+        else
+        {
+            eStatus = SCG_CLOCK_DISABLE;
+            SCG_HWA_DisableFirc();
+
+            u32Temp = CLOCK_OFF_STABILIZATION_TIMEOUT;
+            while ((SCG_HWA_GetFircValid() == true) && (u32Temp > 0U))
+            {
+                u32Temp--;
+            }
+        }
+    }
+
+    if(true == pFircConfig->bCm)
+    {
+        SCG_SetMonitorNotify(SCG_FIRC_CLK, pFircConfig->pFircClockErrorNotify);
+    }
+
+
+    SCG_SetFircClockStatus();
+
+    return eStatus;
+}
+
+/**
+ * \brief Set PLL0 configuration.
+ * \param pPll0Config: pointer to the PLL0Type structure data instance, which defined PLL0 initial information.
+ * \return true or false. PLL0 would wait for PLL0 valid in while loop within pre-dinfined limited time
+ *         to check the PLL0 valid or not. If PLL0 still not valid(this may happen if external Fast OSC not placed),
+ *         it would return fail. PLL0 would check the status of input clock source(FIRC or FOSC), if it is not valid, it would return false.
+ * \note Returns without touching the hardware when the requested configuration is already in effect.
+ */
+SCG_StatusType SCG_SetPLL0(SCG_Pll0Type *pPll0Config)
+{
+    SCG_AsyncWaitType tWait = {false, SCG_CLOCK_ERROR};
+
+    while (SCG_SetPLL0Async(pPll0Config, SCG_AsyncWaitDone, &tWait) == false)
+    {
+        /* finish the pending async job first */
+        (void)SCG_PollAsync();
+    }
+
+    return SCG_AsyncWait(&tWait);
+}
+
+/**
+ * \brief Apply the system clock configuration, shared by SCG_SetClkCtrl and SCG_SetClkCtrlAsync.
+ */
+static SCG_StatusType SCG_ApplyClkCtrl(const SCG_ClockCtrlType *pSysClkConfig)
+{
+    SCG_StatusType eStatus;
+    uint32_t u32Temp;
+    uint32_t u32OldCoreFreq;
+    uint32_t u32SrcFreq = 0U;
+    uint32_t u32Primask;
+
+    /* the requested source is probed below */
+    SCG_ProbeClocks(SCG_PROBE_CORE);
+
+    if (SCG_IsClkCtrlConfigured(pSysClkConfig) == true)
+    {
+        /* requested configuration already in effect */
+        eStatus = SCG_CLOCK_VALID;
+    }
+    else
+    {
+        switch (pSysClkConfig->eSrc)
+        {
+        case SCG_CLOCK_SRC_FOSC:
+        {
+            SCG_ProbeRootNode(SCG_FOSC_CLK);
+            if (s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].eClkStatus == SCG_CLOCK_VALID)
+            {
+                u32SrcFreq = s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].u32Freq;
+                if (SCG_CalcSysClk(u32SrcFreq, (uint32_t)pSysClkConfig->eDivCore,
+                                   (uint32_t)pSysClkConfig->eDivBus, (uint32_t)pSysClkConfig->eDivSlow, NULL) == false)
+                {
+                    eStatus = SCG_CLOCK_PARAM_INVALID;
+                }
+                else
+                {
+                    eStatus = SCG_CLOCK_VALID;
+                }
+            }
+            else
+            {
+                eStatus = SCG_CLOCK_ERROR;
+            }
+        }
+        break;
+
+        case SCG_CLOCK_SRC_FIRC:
+        {
+            SCG_ProbeRootNode(SCG_FIRC_CLK);
+            if (s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].eClkStatus == SCG_CLOCK_VALID)
+            {
+                u32SrcFreq = s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].u32Freq;
+                if (SCG_CalcSysClk(u32SrcFreq, (uint32_t)pSysClkConfig->eDivCore,
+                                   (uint32_t)pSysClkConfig->eDivBus, (uint32_t)pSysClkConfig->eDivSlow, NULL) == false)
+                {
+                    eStatus = SCG_CLOCK_PARAM_INVALID;
+                }
+                else
+                {
+                    eStatus = SCG_CLOCK_VALID;
+                }
+            }
+            else
+            {
+                eStatus = SCG_CLOCK_ERROR;
+            }
+        }
+        break;
+
+        case SCG_CLOCK_SRC_PLL0:
+        {
+            SCG_ProbeClocks(SCG_PROBE_PLL0);
+            if (s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].eClkStatus == SCG_CLOCK_VALID)
+            {
+                u32SrcFreq = s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].u32Freq;
+                if (SCG_CalcSysClk(u32SrcFreq, (uint32_t)pSysClkConfig->eDivCore,
+                                   (uint32_t)pSysClkConfig->eDivBus, (uint32_t)pSysClkConfig->eDivSlow, NULL) == false)
+                {
+                    eStatus = SCG_CLOCK_PARAM_INVALID;
+                }
+                else
+                {
+                    eStatus = SCG_CLOCK_VALID;
+                }
+            }
+            else
+            {
+                eStatus = SCG_CLOCK_ERROR;
+            }
+        }
+        break;
+
+        default:
+            eStatus = SCG_CLOCK_ERROR;
+            break;
+        }
+
+        SCG_ENTER_CRITICAL(u32Primask);
+        u32OldCoreFreq = s_tClockSequenceInfo.tClockInfo[SCG_CORE_CLK].u32Freq;
+
+        if (eStatus == SCG_CLOCK_VALID)
+        {
+            u32Temp = (uint32_t)((uint32_t)SCG_CCR_SYSCLK_CME(pSysClkConfig->bSysClkMonitor) |
+                                 (uint32_t)SCG_CCR_SCS(pSysClkConfig->eSrc) |
+                                 (uint32_t)SCG_CCR_DIVCORE(pSysClkConfig->eDivCore) |
+                                 (uint32_t)SCG_CCR_DIVBUS(pSysClkConfig->eDivBus)  |
+                                 (uint32_t)SCG_CCR_DIVSLOW(pSysClkConfig->eDivSlow));
+            if ((s_tRamp.bEnable == true) && (u32OldCoreFreq != UNKNOWN_CLOCK) && (u32OldCoreFreq != 0U))
+            {
+                eStatus = SCG_RampCcr(u32Temp, u32SrcFreq, u32OldCoreFreq);
+            }
+            else
+            {
+                eStatus = SCG_SwitchCcr(u32Temp, (uint8_t)pSysClkConfig->eSrc);
+            }
+        }
+
+        /* set core clock configuration information */
+        SCG_SetCoreClockStatus();
+
+        /* rescale the tick timer in the same critical section as the CCR switch */
+        SCG_RescaleTimebase(u32OldCoreFreq);
+        SCG_EXIT_CRITICAL(u32Primask);
+    }
+
+    return eStatus;
+}
+
+/**
+ * \brief Set system run time clock and related CORE/BUS/SLOW clock.
+ * \param pSysClkConfig: pointer to the clockCtrlType structure data instance,
+ *        which defined for system clock selection.
+ * \return true or false. This function would check the clock source status before set it system clock,
+ *         if the chosen clock source is invalid, it would return false.
+ * \note Returns without touching the hardware when the requested configuration is already in effect.
+ */
+SCG_StatusType SCG_SetClkCtrl(SCG_ClockCtrlType *pSysClkConfig)
+{
+    SCG_AsyncWaitType tWait = {false, SCG_CLOCK_ERROR};
+
+    while (SCG_SetClkCtrlAsync(pSysClkConfig, SCG_AsyncWaitDone, &tWait) == false)
+    {
+        /* finish the pending async job first */
+        (void)SCG_PollAsync();
+    }
+
+    return SCG_AsyncWait(&tWait);
+}
+
+/**
+ * \brief  Switch system clock source during run time.
+ * \param eClock: target clock source user want to switch.
+ * \return true or false. This function check if the clock source is in proper range.
+ */
+SCG_StatusType SCG_SwitchClkCtrlSrc(SCG_ClockSrcType eClock)
+{
+    SCG_StatusType eStatus = SCG_CLOCK_ERROR;
+    uint32_t u32Temp;
+    uint32_t u32OldCoreFreq;
+    uint32_t u32Primask;
+
+    /* the requested source is probed below */
+    SCG_ProbeClocks(SCG_PROBE_CORE);
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    u32OldCoreFreq = s_tClockSequenceInfo.tClockInfo[SCG_CORE_CLK].u32Freq;
+
+    switch (eClock)
+    {
+    case SCG_CLOCK_SRC_FOSC:
+    {
+        SCG_ProbeRootNode(SCG_FOSC_CLK);
+        if (s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].eClkStatus == SCG_CLOCK_VALID)
+        {
+            u32Temp = SCG->CCR;
+            u32Temp &= ~SCG_CCR_SCS_MASK;
+            u32Temp |= SCG_CCR_SCS(eClock);
+            eStatus = SCG_SwitchCcr(u32Temp, (uint8_t)eClock);
+        }
+    }
+    break;
+
+    case SCG_CLOCK_SRC_FIRC:
+    {
+        SCG_ProbeRootNode(SCG_FIRC_CLK);
+        if (s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].eClkStatus == SCG_CLOCK_VALID)
+        {
+            u32Temp = SCG->CCR;
+            u32Temp &= ~SCG_CCR_SCS_MASK;
+            u32Temp |= SCG_CCR_SCS(eClock);
+            eStatus = SCG_SwitchCcr(u32Temp, (uint8_t)eClock);
+        }
+    }
+    break;
+
+    case SCG_CLOCK_SRC_PLL0:
+    {
+        SCG_ProbeClocks(SCG_PROBE_PLL0);
+        if (s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].eClkStatus == SCG_CLOCK_VALID)
+        {
+            u32Temp = SCG->CCR;
+            u32Temp &= ~SCG_CCR_SCS_MASK;
+            u32Temp |= SCG_CCR_SCS(eClock);
+            eStatus = SCG_SwitchCcr(u32Temp, (uint8_t)eClock);
+        }
+    }
+    break;
+
+    default:
+        /* do nothing */
+        break;
+    }
+
+    if (eStatus == SCG_CLOCK_VALID)
+    {
+        /* set core clock configuration information */
+        SCG_SetCoreClockStatus();
+
+        /* rescale the tick timer in the same critical section as the CCR switch */
+        SCG_RescaleTimebase(u32OldCoreFreq);
+    }
+    SCG_EXIT_CRITICAL(u32Primask);
+
+    return eStatus;
+}
+
+/**
+ * \brief Report the clock source status and frequency configured in MCU run time.
+ *        The clock frequency and status would change by clock set function.
+ * \param eScgClockName: the clock source to query
+ * \param pFrequency: frequency variable point to get the frequency value
+ * \return true or false. This indicate the clock source status invalid or request clock source out of
+ *         range.
+ */
+SCG_StatusType SCG_GetScgClockFreq(SCG_ClkSrcType eScgClockName,  uint32_t *pFrequency)
+{
+    SCG_StatusType eStatus;
+    if (eScgClockName >= SCG_END_OF_CLOCKS)
+    {
+        eStatus = SCG_CLOCK_PARAM_INVALID;
+        *pFrequency = 0U;
+    }
+    else
+    {
+        SCG_ProbeClocks(SCG_GetProbeGroup(eScgClockName));
+        eStatus = s_tClockSequenceInfo.tClockInfo[eScgClockName].eClkStatus;
+        *pFrequency = s_tClockSequenceInfo.tClockInfo[eScgClockName].u32Freq;
+    }
+    return eStatus;
+}
+
+/**
+ * \brief Report the exact frequency of a clock node as the reduced fraction u64Num / u32Den Hz.
+ *        SCG_GetScgClockFreq truncates to whole Hz, this variant keeps the fractional part of
+ *        PLL0 and divider outputs, e.g. for baud rate or timer error budgets.
+ * \param eScgClockName: the clock source to query
+ * \param pFreq: exact frequency, 0 / 1 unless the node is valid
+ * \return the same status as SCG_GetScgClockFreq
+ */
+SCG_StatusType SCG_GetScgClockFreqExact(SCG_ClkSrcType eScgClockName, SCG_CalcFreqType *pFreq)
+{
+    SCG_StatusType eStatus;
+
+    pFreq->u64Num = 0U;
+    pFreq->u32Den = 1U;
+    if (eScgClockName >= SCG_END_OF_CLOCKS)
+    {
+        eStatus = SCG_CLOCK_PARAM_INVALID;
+    }
+    else
+    {
+        SCG_ProbeClocks(SCG_GetProbeGroup(eScgClockName));
+        eStatus = s_tClockSequenceInfo.tClockInfo[eScgClockName].eClkStatus;
+        if (eStatus == SCG_CLOCK_VALID)
+        {
+            SCG_GetExactFreq(eScgClockName, pFreq);
+        }
+    }
+    return eStatus;
+}
+
+/**
+ * \brief  Set clock out source in SCG. it set SCG_CLKOUTCFG [CLKOUTSEL].
+ * \param pSysClkConfig: pointer to the clockCtrlType structure data instance,
+ *        which defined for system clock selection.
+ */
+void SCG_SetClkOut(SCG_ClockCtrlType *pSysClkConfig)
+{
+    uint32_t u32Temp;
+    uint32_t u32NvmClk;
+    uint32_t u32Primask;
+
+    SCG_ClockoutSrcType eClockOutSrc = SCG_CLOCKOUT_SRC_PLL0;
+    SCG_NvmClkSrcType eNvmClockSrc = SCG_NVMCLK_SRC_FIRC;
+    eClockOutSrc = pSysClkConfig->eClkOutSrc;
+    eNvmClockSrc = pSysClkConfig->eNvmClkSrc;
+
+    if (eNvmClockSrc == SCG_NVMCLK_SRC_FIRC)
+    {
+        u32NvmClk = SCG_CLKOUTCFG_NVMCLK_FIRC_MASK;
+    }
+    else
+    {
+        u32NvmClk = SCG_CLKOUTCFG_NVMCLK_SIRC_MASK;
+    }
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    /* while the NVM clock boost is held, the configured source takes effect on its release */
+    if (s_tNvmBoost.u32Count != 0U)
+    {
+        s_tNvmBoost.u32SavedNvmClk = u32NvmClk;
+        u32NvmClk = SCG_CLKOUTCFG_NVMCLK_FIRC_MASK;
+    }
+
+    /*   disable as NVMCLK source first time
+         set clock out source together, then enable configured NVMCLK source */
+    u32Temp = SCG->CLKOUTCFG;
+    u32Temp &= ~(SCG_CLKOUTCFG_CLKOUTSEL_MASK | SCG_NVMCLK_MASK);
+    u32Temp |= (uint32_t)(SCG_CLKOUTCFG_CLKOUTSEL(eClockOutSrc));
+    SCG_WriteNvmClk(u32Temp, u32NvmClk);
+    SCG_EXIT_CRITICAL(u32Primask);
+
+    /* set clock out configuration information */
+    SCG_SetClockOutStatus();
+
+}
+
+/**
+ * @brief Switch the NVM clock to FIRC, the faster NVMCLK source, for bulk flash program and erase.
+ *        Calls nest, the source selected before the first call is restored by the matching last
+ *        SCG_ReleaseNvmClockBoost. SCG_SetClkOut calls in between only update the source to
+ *        restore. Call it while no flash command is running and keep FIRC enabled until release.
+ * @return SCG_CLOCK_VALID if the boost is held, SCG_CLOCK_DISABLE if FIRC is not valid; release
+ *         only after SCG_CLOCK_VALID
+ */
+SCG_StatusType SCG_AcquireNvmClockBoost(void)
+{
+    SCG_StatusType eStatus = SCG_CLOCK_VALID;
+    uint32_t u32Temp;
+    uint32_t u32Primask;
+
+    /* probe only the clock nodes this function reads */
+    SCG_ProbeClocks(SCG_PROBE_FIRC);
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    if (s_tNvmBoost.u32Count == 0U)
+    {
+        if (s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].eClkStatus != SCG_CLOCK_VALID)
+        {
+            eStatus = SCG_CLOCK_DISABLE;
+        }
+        else
+        {
+            u32Temp = SCG->CLKOUTCFG;
+            s_tNvmBoost.u32SavedNvmClk = u32Temp & SCG_NVMCLK_MASK;
+            if (s_tNvmBoost.u32SavedNvmClk != SCG_CLKOUTCFG_NVMCLK_FIRC_MASK)
+            {
+                SCG_WriteNvmClk(u32Temp & ~SCG_NVMCLK_MASK, SCG_CLKOUTCFG_NVMCLK_FIRC_MASK);
+            }
+        }
+    }
+    if (eStatus == SCG_CLOCK_VALID)
+    {
+        s_tNvmBoost.u32Count++;
+    }
+    SCG_EXIT_CRITICAL(u32Primask);
+
+    return eStatus;
+}
+
+/**
+ * @brief Release one SCG_AcquireNvmClockBoost, the last release restores the previous NVM clock.
+ *        Call it while no flash command is running.
+ */
+void SCG_ReleaseNvmClockBoost(void)
+{
+    uint32_t u32Temp;
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    if (s_tNvmBoost.u32Count != 0U)
+    {
+        s_tNvmBoost.u32Count--;
+        if ((s_tNvmBoost.u32Count == 0U) && (s_tNvmBoost.u32SavedNvmClk != SCG_CLKOUTCFG_NVMCLK_FIRC_MASK))
+        {
+            u32Temp = SCG->CLKOUTCFG & ~SCG_NVMCLK_MASK;
+            SCG_WriteNvmClk(u32Temp, s_tNvmBoost.u32SavedNvmClk);
+        }
+    }
+    SCG_EXIT_CRITICAL(u32Primask);
+}
+
+/**
+ * @brief Clock source De-init
+ *        Switch the core clock back to FIRC, then disable PLL0, FOSC, SOSC and SIRC32K in parallel.
+ *        The clock tree is audited first: after a clock monitor failover the core already runs
+ *        from FIRC while the tree still shows the lost source feeding it, and the teardown would
+ *        keep that source enabled.
+ *
+ * @return SCG_StatusType function status
+ */
+SCG_StatusType SCG_Deinit(void)
+{
+    SCG_StatusType eStatusVal = SCG_CLOCK_VALID;
+    SCG_FircType tFircCfg =
+    {
+        .bEnable = true,
+        .bLock = false,
+        .bCm = false,
+        .bTrEn = false,
+        .bSten = false,
+        .u8TrimSrc = 0U,
+        .eDivL = SCG_ASYNCCLOCKDIV_BY4,
+        .eDivM = SCG_ASYNCCLOCKDIV_BY2,
+        .eDivH = SCG_ASYNCCLOCKDIV_BY1
+    };
+
+    (void)SCG_Audit();
+
+    if (SCG_HWA_GetSysClkSrc() != (uint8_t)SCG_CLOCK_SRC_FIRC)
+    {
+        eStatusVal = SCG_SwitchClkCtrlSrc(SCG_CLOCK_SRC_FIRC);
+        if (SCG_CLOCK_ERROR == eStatusVal)
+        {
+            eStatusVal = SCG_SetFIRC(&tFircCfg);
+            if (SCG_CLOCK_TIMEOUT != eStatusVal)
+            {
+                eStatusVal = SCG_SwitchClkCtrlSrc(SCG_CLOCK_SRC_FIRC);
+            }
+        }
+    }
+
+    if (SCG_CLOCK_VALID == eStatusVal)
+    {
+        /* Disable all clock source */
+        SCG_TeardownClockSources();
+    }
+
+    return eStatusVal;
+}
+
+/**
+ * @brief Slot of a clock node in s_eMonitorNode.
+ * @return 5U if the node has no clock monitor
+ */
+static uint8_t SCG_GetMonitorSlot(SCG_ClkSrcType eNode)
+{
+    uint8_t u8Slot = 0U;
+
+    while ((u8Slot < 5U) && (s_eMonitorNode[u8Slot] != eNode))
+    {
+        u8Slot++;
+    }
+
+    return u8Slot;
+}
+
+/**
+ * @brief Install the clock error notification of a monitored source.
+ * @param eNode: clock node from s_eMonitorNode, ignored if it has no slot
+ * @param pNotify: notification called from SCG_IRQHandler
+ */
+static void SCG_SetMonitorNotify(SCG_ClkSrcType eNode, SCG_CLockError_CallBackType pNotify)
+{
+    uint8_t u8Slot = SCG_GetMonitorSlot(eNode);
+
+    if (u8Slot < 5U)
+    {
+        s_pClkErrNotify[u8Slot] = pNotify;
+    }
+}
+
+/**
+ * @brief Read the CSR of a monitored source.
+ * @param eNode: clock node from s_eMonitorNode
+ * @param pCsr: CSR value read
+ * @return true if the clock error flag is set
+ */
+static bool SCG_ReadMonitorErr(SCG_ClkSrcType eNode, uint32_t *pCsr)
+{
+    uint32_t u32ErrMask;
+
+    switch (eNode)
+    {
+    case SCG_PLL0_CLK:
+        *pCsr = SCG->PLL0CSR;
+        u32ErrMask = SCG_PLL0CSR_ERR_MASK;
+        break;
+    case SCG_FOSC_CLK:
+        *pCsr = SCG->FOSCCSR;
+        u32ErrMask = SCG_FOSCCSR_ERR_MASK;
+        break;
+    case SCG_SOSC_CLK:
+        *pCsr = SCG->SOSCCSR;
+        u32ErrMask = SCG_SOSCCSR_ERR_MASK;
+        break;
+    case SCG_FIRC_CLK:
+        *pCsr = SCG->FIRCCSR;
+        u32ErrMask = SCG_FIRCCSR_ERR_MASK;
+        break;
+    default:
+        *pCsr = SCG->SIRCCSR;
+        u32ErrMask = SCG_SIRCCSR_ERR_MASK;
+        break;
+    }
+
+    return ((*pCsr & u32ErrMask) != 0U);
+}
+
+/**
+ * @brief Clear the clock error flag of a monitored source, ERR is write 1 to clear so the CSR value
+ *        read by SCG_ReadMonitorErr is written back as is.
+ */
+static void SCG_ClearMonitorErr(SCG_ClkSrcType eNode, uint32_t u32Csr)
+{
+    switch (eNode)
+    {
+    case SCG_PLL0_CLK:
+        SCG_HWA_SetPll0Csr(u32Csr);
+        break;
+    case SCG_FOSC_CLK:
+        SCG_HWA_SetFoscCsr(u32Csr);
+        break;
+    case SCG_SOSC_CLK:
+        SCG_HWA_SetSoscCcr(u32Csr);
+        break;
+    case SCG_FIRC_CLK:
+        SCG_HWA_SetFircCsr(u32Csr);
+        break;
+    default:
+        SCG_HWA_SetSircCsr(u32Csr);
+        break;
+    }
+}
+
+/**
+ * @brief Count a clock monitor event and update its timestamps, called from SCG_IRQHandler.
+ * @param u8Slot: index in s_tMonitorStats
+ */
+static void SCG_RecordMonitorEvent(uint8_t u8Slot)
+{
+    SCG_ClockMonitorStatsType *pStats = &s_tMonitorStats[u8Slot];
+    uint32_t u32Now = SCG_MONITOR_TIMESTAMP();
+    uint32_t u32Interval;
+
+    if (pStats->u32Count == 0U)
+    {
+        pStats->u32FirstTime = u32Now;
+        pStats->u32MinInterval = 0xFFFFFFFFU;
+    }
+    else
+    {
+        u32Interval = u32Now - pStats->u32LastTime;
+        if (u32Interval < pStats->u32MinInterval)
+        {
+            pStats->u32MinInterval = u32Interval;
+        }
+    }
+    pStats->u32LastTime = u32Now;
+    /* saturate, a flapping clock must not wrap back to a low count */
+    if (pStats->u32Count != 0xFFFFFFFFU)
+    {
+        pStats->u32Count++;
+    }
+}
+
+/**
+ * @brief Clock error interrupt handler
+ *
+ */
+void SCG_IRQHandler(void)
+{
+    uint32_t u32Csr;
+    uint32_t u32Pending = 0U;
+    uint8_t u8Slot;
+
+    /* one read of each monitored CSR, a faulted source is cleared right away with the value just read,
+       nothing is written for a source without error. All flags are cleared before the first
+       notification, so a notification reconfiguring another source is not undone by a stale CSR. */
+    for (u8Slot = 0U; u8Slot < 5U; u8Slot++)
+    {
+        if (SCG_ReadMonitorErr(s_eMonitorNode[u8Slot], &u32Csr) == true)
+        {
+            SCG_ClearMonitorErr(s_eMonitorNode[u8Slot], u32Csr);
+            u32Pending |= (uint32_t)1U << u8Slot;
+        }
+    }
+
+    /* lowest set bit first */
+    while (u32Pending != 0U)
+    {
+        u8Slot = (uint8_t)__CLZ(__RBIT(u32Pending));
+        u32Pending &= u32Pending - 1U;
+        SCG_RecordMonitorEvent(u8Slot);
+        if (NULL != s_pClkErrNotify[u8Slot])
+        {
+            s_pClkErrNotify[u8Slot]();
+        }
+    }
+
+    /* let a pending async job make progress */
+    (void)SCG_PollAsync();
+}
+
+/**
+ * @brief Precompute the idle clock register images and set the configured STEN bits.
+ *        The idle CCR image and the resulting CORE/BUS/SLOW nodes are computed once here,
+ *        so SCG_IdleEnter/SCG_IdleExit only copy images.
+ * @param pIdleCfg: pointer to the idle governor configuration
+ * @return SCG_CLOCK_VALID when the idle clock is usable, SCG_CLOCK_PARAM_INVALID for a source other
+ *         than FIRC or dividers out of range, SCG_CLOCK_ERROR when FIRC is not valid.
+ */
+SCG_StatusType SCG_IdlePrepare(const SCG_IdleCfgType *pIdleCfg)
+{
+    SCG_StatusType eStatus;
+    SCG_CalcSysFreqType tSysFreq;
+    uint32_t u32Temp;
+
+    /* probe only the clock nodes this function reads */
+    SCG_ProbeClocks(SCG_PROBE_FIRC | SCG_PROBE_CORE);
+
+    s_tIdleGovernor.bPrepared = false;
+
+    if (pIdleCfg->tIdleClkCtrl.eSrc != SCG_CLOCK_SRC_FIRC)
+    {
+        eStatus = SCG_CLOCK_PARAM_INVALID;
+    }
+    else if (s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].eClkStatus != SCG_CLOCK_VALID)
+    {
+        eStatus = SCG_CLOCK_ERROR;
+    }
+    else
+    {
+        if (SCG_CalcSysClk(s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].u32Freq, (uint32_t)pIdleCfg->tIdleClkCtrl.eDivCore,
+                           (uint32_t)pIdleCfg->tIdleClkCtrl.eDivBus, (uint32_t)pIdleCfg->tIdleClkCtrl.eDivSlow, &tSysFreq) == false)
+        {
+            eStatus = SCG_CLOCK_PARAM_INVALID;
+        }
+        else
+        {
+            eStatus = SCG_CLOCK_VALID;
+        }
+    }
+
+    if (eStatus == SCG_CLOCK_VALID)
+    {
+        s_tIdleGovernor.u32IdleCcr = (uint32_t)((uint32_t)SCG_CCR_SYSCLK_CME(pIdleCfg->tIdleClkCtrl.bSysClkMonitor) |
+                                                (uint32_t)SCG_CCR_SCS(pIdleCfg->tIdleClkCtrl.eSrc) |
+                                                (uint32_t)SCG_CCR_DIVCORE(pIdleCfg->tIdleClkCtrl.eDivCore) |
+                                                (uint32_t)SCG_CCR_DIVBUS(pIdleCfg->tIdleClkCtrl.eDivBus)  |
+                                                (uint32_t)SCG_CCR_DIVSLOW(pIdleCfg->tIdleClkCtrl.eDivSlow));
+        s_tIdleGovernor.tIdleInfo[0].eClkStatus = SCG_CLOCK_VALID;
+        s_tIdleGovernor.tIdleInfo[0].u32Freq = tSysFreq.u32CoreFreq;
+        s_tIdleGovernor.tIdleInfo[1].eClkStatus = SCG_CLOCK_VALID;
+        s_tIdleGovernor.tIdleInfo[1].u32Freq = tSysFreq.u32BusFreq;
+        s_tIdleGovernor.tIdleInfo[2].eClkStatus = SCG_CLOCK_VALID;
+        s_tIdleGovernor.tIdleInfo[2].u32Freq = tSysFreq.u32SlowFreq;
+
+        /* STEN keeps PLL0 and FOSC running in stop mode, so they do not need to re-lock on wake */
+        if ((pIdleCfg->bPll0Sten == true) && ((SCG->PLL0CSR & SCG_PLL0CSR_EN_MASK) != 0U))
+        {
+            u32Temp = SCG->PLL0CSR;
+            SCG_HWA_UnlockPll0();
+            SCG_HWA_SetPll0Csr((u32Temp & ~(uint32_t)SCG_PLL0CSR_LK_MASK) | SCG_PLL0CSR_STEN(1U));
+            SCG_HWA_SetPll0Csr(u32Temp | SCG_PLL0CSR_STEN(1U));
+        }
+
+        if ((pIdleCfg->bFoscSten == true) && ((SCG->FOSCCSR & SCG_FOSCCSR_EN_MASK) != 0U))
+        {
+            u32Temp = SCG->FOSCCSR;
+            SCG_HWA_SetFoscCsr((u32Temp & ~(uint32_t)SCG_FOSCCSR_LK_MASK) | SCG_FOSCCSR_STEN(1U));
+            SCG_HWA_SetFoscCsr(u32Temp | SCG_FOSCCSR_STEN(1U));
+        }
+
+        s_tIdleGovernor.bPrepared = true;
+    }
+
+    return eStatus;
+}
+
+/**
+ * @brief Drop to the idle clock, execute WFI and restore the run clock on wake.
+ *        Interrupts are masked across the sequence, so the pending wake-up interrupt is served
+ *        after the run clock is back and its latency is bounded by the restore time only.
+ * @return status of the run clock restore, SCG_CLOCK_SEQUENCE_ERROR if SCG_IdlePrepare was not
+ *         successfully called before, in which case only WFI is executed. If the switch to the idle
+ *         clock fails its status is returned and neither the clock tree nor the timebase is touched,
+ *         WFI is not executed.
+ */
+SCG_StatusType SCG_IdleEnter(void)
+{
+    SCG_StatusType eStatus;
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+
+    if ((s_tIdleGovernor.bPrepared == true) && (s_tIdleGovernor.bIdle == false))
+    {
+        /* save the run clock images */
+        s_tIdleGovernor.u32RunCcr = SCG->CCR;
+        s_tIdleGovernor.eRunClock = s_tClockSequenceInfo.eRunClock;
+        s_tIdleGovernor.tRunInfo[0] = s_tClockSequenceInfo.tClockInfo[SCG_CORE_CLK];
+        s_tIdleGovernor.tRunInfo[1] = s_tClockSequenceInfo.tClockInfo[SCG_BUS_CLK];
+        s_tIdleGovernor.tRunInfo[2] = s_tClockSequenceInfo.tClockInfo[SCG_SLOW_CLK];
+
+        eStatus = SCG_SwitchCcr(s_tIdleGovernor.u32IdleCcr, (uint8_t)SCG_CLOCK_SRC_FIRC);
+
+        /* on an update timeout the core still runs on the run clock, the tree must keep saying so */
+        if (eStatus == SCG_CLOCK_VALID)
+        {
+            s_tIdleGovernor.bIdle = true;
+            s_tClockSequenceInfo.eRunClock = SCG_RUNCLOCK_FIRC;
+            s_tClockSequenceInfo.tClockInfo[SCG_CORE_CLK] = s_tIdleGovernor.tIdleInfo[0];
+            s_tClockSequenceInfo.tClockInfo[SCG_BUS_CLK] = s_tIdleGovernor.tIdleInfo[1];
+            s_tClockSequenceInfo.tClockInfo[SCG_SLOW_CLK] = s_tIdleGovernor.tIdleInfo[2];
+            SCG_RescaleTimebase(s_tIdleGovernor.tRunInfo[0].u32Freq);
+            SCG_ResidencyUpdate(true);
+
+            __DSB();
+            __WFI();
+
+            eStatus = SCG_IdleExit();
+        }
+    }
+    else
+    {
+        __DSB();
+        __WFI();
+        eStatus = SCG_CLOCK_SEQUENCE_ERROR;
+    }
+
+    SCG_EXIT_CRITICAL(u32Primask);
+
+    return eStatus;
+}
+
+/**
+ * @brief Restore the run clock saved by SCG_IdleEnter, no-op when the governor is not idle.
+ *        If PLL0 did not re-lock in time the core stays on the idle clock, the call can be retried.
+ * @return SCG_CLOCK_VALID when running on the saved run clock, SCG_CLOCK_TIMEOUT otherwise.
+ */
+SCG_StatusType SCG_IdleExit(void)
+{
+    SCG_StatusType eStatus = SCG_CLOCK_VALID;
+    uint32_t u32Primask;
+    uint32_t u32Temp;
+    uint32_t u32Start;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+
+    if (s_tIdleGovernor.bIdle == true)
+    {
+        u32Start = SCG_GET_CYCLES();
+
+        /* PLL0 re-locks by itself on wake when it was stopped without STEN */
+        if ((s_tIdleGovernor.eRunClock == SCG_RUNCLOCK_PLL0_FIRC) ||
+                (s_tIdleGovernor.eRunClock == SCG_RUNCLOCK_PLL0_FOSC))
+        {
+            u32Temp = PLL0_STABILIZATION_TIMEOUT;
+            while ((SCG_HWA_GetPll0Locked() == false) && (u32Temp > 0U))
+            {
+                u32Temp--;
+            }
+            if (u32Temp == 0U)
+            {
+                eStatus = SCG_CLOCK_TIMEOUT;
+            }
+        }
+
+        if (eStatus == SCG_CLOCK_VALID)
+        {
+            eStatus = SCG_SwitchCcr(s_tIdleGovernor.u32RunCcr,
+                                    (uint8_t)((s_tIdleGovernor.u32RunCcr & SCG_CCR_SCS_MASK) >> SCG_CCR_SCS_SHIFT));
+        }
+
+        if (eStatus == SCG_CLOCK_VALID)
+        {
+            s_tClockSequenceInfo.eRunClock = s_tIdleGovernor.eRunClock;
+            s_tClockSequenceInfo.tClockInfo[SCG_CORE_CLK] = s_tIdleGovernor.tRunInfo[0];
+            s_tClockSequenceInfo.tClockInfo[SCG_BUS_CLK] = s_tIdleGovernor.tRunInfo[1];
+            s_tClockSequenceInfo.tClockInfo[SCG_SLOW_CLK] = s_tIdleGovernor.tRunInfo[2];
+            s_tIdleGovernor.bIdle = false;
+            SCG_RescaleTimebase(s_tIdleGovernor.tIdleInfo[0].u32Freq);
+            SCG_ResidencyUpdate(true);
+
+            u32Temp = SCG_GET_CYCLES() - u32Start;
+            s_tIdleGovernor.tStats.u32IdleCount++;
+            s_tIdleGovernor.tStats.u32LastWakeLatency = u32Temp;
+            if (u32Temp > s_tIdleGovernor.tStats.u32MaxWakeLatency)
+            {
+                s_tIdleGovernor.tStats.u32MaxWakeLatency = u32Temp;
+            }
+        }
+        else
+        {
+            /* stay on the idle clock and report the real hardware state */
+            u32Temp = s_tClockSequenceInfo.tClockInfo[SCG_CORE_CLK].u32Freq;
+            SCG_SetPll0ClockStatus();
+            SCG_SetCoreClockStatus();
+            SCG_RescaleTimebase(u32Temp);
+        }
+    }
+
+    SCG_EXIT_CRITICAL(u32Primask);
+
+    return eStatus;
+}
+
+/**
+ * @brief Get the idle governor statistics.
+ * @param pIdleStats: pointer to the statistics to fill
+ */
+void SCG_GetIdleStats(SCG_IdleStatsType *pIdleStats)
+{
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    *pIdleStats = s_tIdleGovernor.tStats;
+    SCG_EXIT_CRITICAL(u32Primask);
+}
+
+/**
+ * @brief Clear the clock residency statistics and start the accounting from the current clocks.
+ */
+void SCG_ClearResidencyStats(void)
+{
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+
+    SCG_ProbeClocks(SCG_PROBE_CORE);
+
+    (void)memset(&s_tResidency, 0, sizeof(s_tResidency));
+    s_tResidency.u32LastTime = SCG_RESIDENCY_TIMESTAMP();
+    s_tResidency.u32OscOn = SCG_ResidencyGetOscOn();
+    s_tResidency.tStats.u32Current = SCG_ResidencyFindProfile();
+    if (s_tResidency.tStats.u32Current < SCG_RESIDENCY_PROFILES)
+    {
+        s_tResidency.tStats.tProfile[s_tResidency.tStats.u32Current].u32Entries = 1U;
+    }
+    s_tResidency.bEnabled = true;
+
+    SCG_EXIT_CRITICAL(u32Primask);
+}
+
+/**
+ * @brief Get a snapshot of the clock residency statistics, the time up to the call is included.
+ *        Must be called at least once per wrap period of SCG_RESIDENCY_TIMESTAMP().
+ * @param pStats: pointer to the statistics to fill
+ * @return SCG_CLOCK_SEQUENCE_ERROR if SCG_ClearResidencyStats was never called
+ */
+SCG_StatusType SCG_GetResidencyStats(SCG_ResidencyStatsType *pStats)
+{
+    SCG_StatusType eStatus = SCG_CLOCK_VALID;
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+
+    if (s_tResidency.bEnabled == true)
+    {
+        SCG_ResidencyUpdate(false);
+        *pStats = s_tResidency.tStats;
+    }
+    else
+    {
+        eStatus = SCG_CLOCK_SEQUENCE_ERROR;
+    }
+
+    SCG_EXIT_CRITICAL(u32Primask);
+
+    return eStatus;
+}
+
+/**
+ * @brief Reprogram a single async divider of FIRC, SIRC, FOSC or PLL0.
+ *        Only the selected divider is gated, reprogrammed and re-enabled, only its own ACK is polled
+ *        and only its node in s_tClockSequenceInfo is updated, the other two outputs keep running.
+ * @param eSrc: SCG_FIRC_CLK, SCG_SIRC_CLK, SCG_FOSC_CLK or SCG_PLL0_CLK
+ * @param eWhich: divider output to change
+ * @param eDiv: new divider value
+ * @return SCG_CLOCK_VALID on success, SCG_CLOCK_PARAM_INVALID for an unsupported source or output,
+ *         SCG_CLOCK_ERROR if the source is not valid, SCG_CLOCK_TIMEOUT if the ACK handshake failed.
+ *         The node follows the divider register in every case, a divider that was written and enabled
+ *         stays VALID with its new frequency even when its ACK timed out.
+ */
+SCG_StatusType SCG_SetAsyncDivider(SCG_ClkSrcType eSrc, SCG_AsyncDivSelType eWhich, SCG_AsyncClockDivType eDiv)
+{
+    SCG_StatusType eStatus;
+    const SCG_SeqDivFieldType *pField;
+    SCG_ClkSrcType eNode;
+    uint32_t u32DivRegVal;
+    uint8_t u8SrcIdx;
+
+    /* probe only the clock nodes this function reads */
+    SCG_ProbeClocks(SCG_GetProbeGroup(eSrc));
+
+    u8SrcIdx = 0U;
+    while ((u8SrcIdx < 4U) && (s_eAsyncDivSrc[u8SrcIdx] != eSrc))
+    {
+        u8SrcIdx++;
+    }
+
+    if ((u8SrcIdx >= 4U) || ((uint32_t)eWhich > (uint32_t)SCG_ASYNCDIV_L))
+    {
+        eStatus = SCG_CLOCK_PARAM_INVALID;
+    }
+    else if (s_tClockSequenceInfo.tClockInfo[eSrc].eClkStatus != SCG_CLOCK_VALID)
+    {
+        eStatus = SCG_CLOCK_ERROR;
+    }
+    else
+    {
+        pField = &s_tSeqDivField[u8SrcIdx][eWhich];
+
+        /* gate only the selected divider and wait for its own ACK to clear */
+        u32DivRegVal = SCG_SeqGetDivReg(u8SrcIdx) & ~pField->u32EnMask;
+        SCG_SeqSetDivReg(u8SrcIdx, u32DivRegVal);
+        (void)SCG_SeqWaitDivAck(u8SrcIdx, pField->u32AckMask, false);
+
+        u32DivRegVal &= ~pField->u32DivMask;
+        u32DivRegVal |= ((uint32_t)eDiv << pField->u32DivShift) & pField->u32DivMask;
+        SCG_SeqSetDivReg(u8SrcIdx, u32DivRegVal);
+
+        u32DivRegVal |= pField->u32EnMask;
+        SCG_SeqSetDivReg(u8SrcIdx, u32DivRegVal);
+        eStatus = (SCG_SeqWaitDivAck(u8SrcIdx, pField->u32AckMask, true) == true) ? SCG_CLOCK_VALID : SCG_CLOCK_TIMEOUT;
+
+        /* update only the node of the changed divider, from the register as SCG_SetXxxClockStatus does */
+        eNode = s_eAsyncDivNode[u8SrcIdx][eWhich];
+        if (eNode != SCG_END_OF_CLOCKS)
+        {
+            u32DivRegVal = SCG_SeqGetDivReg(u8SrcIdx);
+            s_tClockSequenceInfo.tClockInfo[eNode].eClkStatus = ((u32DivRegVal & pField->u32EnMask) != 0U) ?
+                                                               SCG_CLOCK_VALID : SCG_CLOCK_DISABLE;
+            if (eWhich == SCG_ASYNCDIV_H)
+            {
+                s_tClockSequenceInfo.tClockInfo[eNode].u32Freq = SCG_CALCULATE_DIVH_FREQ(s_tClockSequenceInfo.tClockInfo[eSrc].u32Freq, u32DivRegVal);
+            }
+            else if (eWhich == SCG_ASYNCDIV_M)
+            {
+                s_tClockSequenceInfo.tClockInfo[eNode].u32Freq = SCG_CALCULATE_DIVM_FREQ(s_tClockSequenceInfo.tClockInfo[eSrc].u32Freq, u32DivRegVal);
+            }
+            else
+            {
+                s_tClockSequenceInfo.tClockInfo[eNode].u32Freq = SCG_CALCULATE_DIVL_FREQ(s_tClockSequenceInfo.tClockInfo[eSrc].u32Freq, u32DivRegVal);
+            }
+        }
+    }
+
+    return eStatus;
+}
+
+/**
+ * @brief Register the tick timer rescaled on every core clock change.
+ *        With pTimebaseRescale set to NULL the driver rescales SysTick itself when it is enabled and
+ *        clocked from the core clock, u32TickRateHz gives the tick rate to keep.
+ * @param pTimebase: pointer to the timebase configuration, NULL disables the rescaling
+ */
+void SCG_SetTimebase(const SCG_TimebaseType *pTimebase)
+{
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    if (pTimebase != NULL)
+    {
+        s_tTimebase = *pTimebase;
+    }
+    else
+    {
+        s_tTimebase.u32TickRateHz = 0U;
+        s_tTimebase.pTimebaseRescale = NULL;
+    }
+    SCG_EXIT_CRITICAL(u32Primask);
+}
+
+/**
+ * @brief Start an SOSC configuration without waiting for the oscillator.
+ * @param pSoscConfig: pointer to the SOSC configuration, copied before return
+ * @param pDone: completion callback, may be NULL
+ * @param pContext: user pointer passed to pDone
+ * @return false if another async job is still pending, nothing is started in that case
+ */
+bool SCG_SetSOSCAsync(const SCG_SoscType *pSoscConfig, SCG_AsyncDoneCallBackType pDone, void *pContext)
+{
+    bool bResult;
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    bResult = SCG_ClaimAsync(SCG_ASYNCJOB_SOSC, pDone, pContext);
+    if (bResult == true)
+    {
+        s_tAsyncJob.uCfg.tSosc = *pSoscConfig;
+        /* probe only the clock nodes this job reads */
+        SCG_ProbeClocks(SCG_PROBE_SOSC);
+        SCG_StartSosc();
+    }
+    SCG_EXIT_CRITICAL(u32Primask);
+
+    return bResult;
+}
+
+/**
+ * @brief Start an FOSC configuration without waiting for the oscillator and the dividers.
+ * @param pFoscConfig: pointer to the FOSC configuration, copied before return
+ * @param pDone: completion callback, may be NULL
+ * @param pContext: user pointer passed to pDone
+ * @return false if another async job is still pending, nothing is started in that case
+ */
+bool SCG_SetFOSCAsync(const SCG_FoscType *pFoscConfig, SCG_AsyncDoneCallBackType pDone, void *pContext)
+{
+    bool bResult;
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    bResult = SCG_ClaimAsync(SCG_ASYNCJOB_FOSC, pDone, pContext);
+    if (bResult == true)
+    {
+        s_tAsyncJob.uCfg.tFosc = *pFoscConfig;
+        /* probe only the clock nodes this job reads */
+        SCG_ProbeClocks(SCG_PROBE_FOSC | SCG_PROBE_CORE);
+        SCG_StartFosc();
+    }
+    SCG_EXIT_CRITICAL(u32Primask);
+
+    return bResult;
+}
+
+/**
+ * @brief Start a PLL0 configuration without waiting for the lock and the dividers.
+ * @param pPll0Config: pointer to the PLL0 configuration, copied before return
+ * @param pDone: completion callback, may be NULL
+ * @param pContext: user pointer passed to pDone
+ * @return false if another async job is still pending, nothing is started in that case
+ */
+bool SCG_SetPLL0Async(const SCG_Pll0Type *pPll0Config, SCG_AsyncDoneCallBackType pDone, void *pContext)
+{
+    bool bResult;
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    bResult = SCG_ClaimAsync(SCG_ASYNCJOB_PLL0, pDone, pContext);
+    if (bResult == true)
+    {
+        s_tAsyncJob.uCfg.tPll0 = *pPll0Config;
+        /* probe only the clock nodes this job reads */
+        SCG_ProbeClocks(SCG_PROBE_FIRC | SCG_PROBE_FOSC | SCG_PROBE_PLL0 | SCG_PROBE_CORE);
+        SCG_StartPll0();
+    }
+    SCG_EXIT_CRITICAL(u32Primask);
+
+    return bResult;
+}
+
+/**
+ * @brief Switch the system clock as an async job.
+ *        The CCR switch and the tick timer rescale are done within this call so they stay atomic,
+ *        only the completion callback is deferred to SCG_PollAsync.
+ * @param pSysClkConfig: pointer to the system clock configuration
+ * @param pDone: completion callback, may be NULL
+ * @param pContext: user pointer passed to pDone
+ * @return false if another async job is still pending, nothing is started in that case
+ */
+bool SCG_SetClkCtrlAsync(const SCG_ClockCtrlType *pSysClkConfig, SCG_AsyncDoneCallBackType pDone, void *pContext)
+{
+    bool bResult;
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    bResult = SCG_ClaimAsync(SCG_ASYNCJOB_CLKCTRL, pDone, pContext);
+    if (bResult == true)
+    {
+        s_tAsyncJob.eStatus = SCG_ApplyClkCtrl(pSysClkConfig);
+        SCG_FinishAsync();
+    }
+    SCG_EXIT_CRITICAL(u32Primask);
+
+    return bResult;
+}
+
+/**
+ * @brief Advance the pending async job by one step and deliver its completion.
+ *        Call from the scheduler idle loop or a periodic task, SCG_IRQHandler calls it as well.
+ *        The completion callback runs with interrupts enabled and may start the next job.
+ * @return true while a job is pending
+ */
+bool SCG_PollAsync(void)
+{
+    bool bPending;
+    bool bDeliver = false;
+    SCG_StatusType eStatus = SCG_CLOCK_ERROR;
+    SCG_AsyncDoneCallBackType pDone = NULL;
+    void *pContext = NULL;
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    if (s_tAsyncJob.ePhase == SCG_ASYNC_DONE)
+    {
+        eStatus = s_tAsyncJob.eStatus;
+        pDone = s_tAsyncJob.pDone;
+        pContext = s_tAsyncJob.pContext;
+        s_tAsyncJob.ePhase = SCG_ASYNC_IDLE;
+        bDeliver = true;
+    }
+    else
+    {
+        SCG_StepAsync();
+    }
+    bPending = (s_tAsyncJob.ePhase != SCG_ASYNC_IDLE);
+    SCG_EXIT_CRITICAL(u32Primask);
+
+    if ((bDeliver == true) && (pDone != NULL))
+    {
+        pDone(eStatus, pContext);
+    }
+
+    return bPending;
+}
+
+/**
+ * @brief Apply a clock plan image generated by tools/scg_plan_gen straight from flash or NVM.
+ *        Only magic, version, reserved flags, CRC and the system clock source index are checked, the
+ *        range checks were done by the generator with the same fc4xxx_driver_scg_calc.c logic before
+ *        it sealed the image. FIRC dividers, FOSC, PLL0 and CCR are programmed
+ *        in this order, the oscillator and lock waits keep their timeouts.
+ *        The plan carries no clock error callbacks, monitors with CMRE cleared report through the
+ *        notify callbacks registered by the setters.
+ * @param pPlan: pointer to the stored plan image
+ * @return SCG_CLOCK_VALID on success, SCG_CLOCK_PARAM_INVALID for a corrupted or foreign image,
+ *         SCG_CLOCK_SEQUENCE_ERROR if the core is not on FIRC or an async job is pending,
+ *         SCG_CLOCK_TIMEOUT or SCG_CLOCK_ERROR if a source or the CCR switch failed.
+ */
+SCG_StatusType SCG_ApplyStoredPlan(const SCG_ClockPlanType *pPlan)
+{
+    SCG_StatusType eStatus = SCG_CLOCK_VALID;
+    uint32_t u32Temp;
+    uint32_t u32Deadline;
+    uint32_t u32Start;
+    uint32_t u32OldCoreFreq;
+    uint32_t u32Primask;
+    uint16_t u16Flags;
+
+    /* if run clock is none, the function will init s_tClockSequenceInfo buffer first */
+    SCG_InitClockSrcStatus();
+
+    if ((SCG_CalcIsPlanIntact(pPlan) == false) || (pPlan->u8SysSrc > (uint8_t)SCG_PLAN_SRC_PLL0))
+    {
+        eStatus = SCG_CLOCK_PARAM_INVALID;
+    }
+    /* the plan reprograms FOSC and PLL0, so the core must run from FIRC */
+    else if ((s_tClockSequenceInfo.eRunClock != SCG_RUNCLOCK_FIRC) || (s_tAsyncJob.ePhase != SCG_ASYNC_IDLE))
+    {
+        eStatus = SCG_CLOCK_SEQUENCE_ERROR;
+    }
+    else
+    {
+        u16Flags = pPlan->u16Flags;
+
+        SCG_SeqWriteDivs(SCG_SEQ_DIV_FIRC, pPlan->au8FircDiv);
+        SCG_SetFircClockStatus();
+
+        if ((u16Flags & SCG_PLAN_FLAG_FOSC_EN) != 0U)
+        {
+            SCG_SeqStartPlanFosc(pPlan, SCG_GetFoscCfgValue((u16Flags & SCG_PLAN_FLAG_FOSC_BYPASS) != 0U));
+
+            u32Deadline = SCG_GetStartupDeadline(SCG_STARTUP_FOSC, FOSC_STABILIZATION_TIMEOUT);
+            u32Start = SCG_GET_CYCLES();
+            u32Temp = u32Deadline / SCG_WAIT_LOOP_CYCLES;
+            while ((SCG_HWA_GetFoscValid() == false) && (u32Temp > 0U))
+            {
+                u32Temp--;
+            }
+            SCG_RecordStartup(SCG_STARTUP_FOSC, (u32Temp == 0U) ? u32Deadline : (SCG_GET_CYCLES() - u32Start), (u32Temp == 0U));
+
+            if (u32Temp == 0U)
+            {
+                eStatus = SCG_CLOCK_TIMEOUT;
+            }
+            else
+            {
+                SCG_SeqFinishPlanFosc(pPlan);
+            }
+
+            /* set FOSC configuration information */
+            SCG_SetFoscClockStatus(pPlan->u32FoscFreq);
+        }
+
+        if ((eStatus == SCG_CLOCK_VALID) && ((u16Flags & SCG_PLAN_FLAG_PLL0_EN) != 0U))
+        {
+            SCG_SeqStartPlanPll0(pPlan);
+
+            u32Deadline = SCG_GetStartupDeadline(SCG_STARTUP_PLL0, PLL0_STABILIZATION_TIMEOUT);
+            u32Start = SCG_GET_CYCLES();
+            u32Temp = u32Deadline / SCG_WAIT_LOOP_CYCLES;
+            while ((SCG_HWA_GetPll0Locked() == false) && (u32Temp > 0U))
+            {
+                u32Temp--;
+            }
+            SCG_RecordStartup(SCG_STARTUP_PLL0, (u32Temp == 0U) ? u32Deadline : (SCG_GET_CYCLES() - u32Start), (u32Temp == 0U));
+
+            if (u32Temp == 0U)
+            {
+                eStatus = SCG_CLOCK_TIMEOUT;
+            }
+            else
+            {
+                SCG_SeqFinishPlanPll0(pPlan);
+            }
+
+            /* set PLL0 configuration information */
+            SCG_SetPll0ClockStatus();
+        }
+
+        if (eStatus == SCG_CLOCK_VALID)
+        {
+            SCG_ENTER_CRITICAL(u32Primask);
+            u32OldCoreFreq = s_tClockSequenceInfo.tClockInfo[SCG_CORE_CLK].u32Freq;
+
+            eStatus = SCG_SwitchCcr(SCG_SeqPlanCcr(pPlan), (uint8_t)s_eSeqPlanSysSrc[pPlan->u8SysSrc]);
+
+            /* set core clock configuration information */
+            SCG_SetCoreClockStatus();
+            SCG_RescaleTimebase(u32OldCoreFreq);
+            SCG_EXIT_CRITICAL(u32Primask);
+        }
+    }
+
+    return eStatus;
+}
+
+/**
+ * @brief Adopt the clocks brought up by SCG_EarlyBoot, once .data and .bss are initialised.
+ *        The clock tree is read from the registers, FOSC takes the crystal frequency of the plan.
+ * @param pPlan: plan passed to SCG_EarlyBoot, NULL if the early bring-up was skipped
+ * @return SCG_CLOCK_VALID if the system clock runs from the source of the plan, SCG_CLOCK_ERROR
+ *         if the early bring-up did not complete
+ */
+SCG_StatusType SCG_EarlyBootHandoff(const SCG_ClockPlanType *pPlan)
+{
+    SCG_StatusType eStatus = SCG_CLOCK_VALID;
+    uint32_t u32FoscFreq = UNKNOWN_CLOCK;
+    uint32_t u32Primask;
+
+    if ((pPlan != NULL) && ((pPlan->u16Flags & SCG_PLAN_FLAG_FOSC_EN) != 0U))
+    {
+        u32FoscFreq = pPlan->u32FoscFreq;
+    }
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    SCG_ReadClockTree(u32FoscFreq, (uint32_t)UNKNOWN_CLOCK);
+    SCG_EXIT_CRITICAL(u32Primask);
+
+    if ((pPlan != NULL) && ((pPlan->u8SysSrc > (uint8_t)SCG_PLAN_SRC_PLL0) ||
+                            (SCG_HWA_GetSysClkSrc() != (uint8_t)s_eSeqPlanSysSrc[pPlan->u8SysSrc])))
+    {
+        eStatus = SCG_CLOCK_ERROR;
+    }
+
+    return eStatus;
+}
+
+/**
+ * @brief Register the startup degradation warning callback.
+ *        The callback runs in the context of the setter or SCG_PollAsync, with interrupts masked.
+ * @param pNotify: callback, NULL to disable the warning
+ */
+void SCG_SetStartupDegradeNotify(SCG_StartupDegradeCallBackType pNotify)
+{
+    s_pStartupDegradeNotify = pNotify;
+}
+
+/**
+ * @brief Get the retained startup statistics of a source.
+ * @param eSrc: SCG_FOSC_CLK, SCG_SOSC_CLK or SCG_PLL0_CLK
+ * @param pStats: pointer to the statistics to fill
+ * @return SCG_CLOCK_VALID, SCG_CLOCK_PARAM_INVALID for another source
+ */
+SCG_StatusType SCG_GetStartupStats(SCG_ClkSrcType eSrc, SCG_StartupStatsType *pStats)
+{
+    SCG_StatusType eStatus = SCG_CLOCK_PARAM_INVALID;
+    uint32_t au32Timeout[3U] = {FOSC_STABILIZATION_TIMEOUT, SOSC_STABILIZATION_TIMEOUT, PLL0_STABILIZATION_TIMEOUT};
+    uint32_t u32Primask;
+    uint8_t u8Slot;
+
+    for (u8Slot = 0U; u8Slot < 3U; u8Slot++)
+    {
+        if (s_eStartupNode[u8Slot] == eSrc)
+        {
+            SCG_ENTER_CRITICAL(u32Primask);
+            SCG_CheckStartupHistory();
+            pStats->u32Samples = s_tStartupHistory.au8Count[u8Slot];
+            pStats->u32Max = SCG_GetStartupMax(u8Slot);
+            pStats->u32Mean = SCG_GetStartupMean(u8Slot);
+            pStats->u32Last = (pStats->u32Samples != 0U) ?
+                              s_tStartupHistory.au32Sample[u8Slot][(s_tStartupHistory.au8Next[u8Slot] + SCG_STARTUP_HISTORY_LEN - 1U) % SCG_STARTUP_HISTORY_LEN] : 0U;
+            pStats->u32Deadline = SCG_GetStartupDeadline(u8Slot, au32Timeout[u8Slot]);
+            pStats->bDegraded = (s_tStartupHistory.au8Degraded[u8Slot] != 0U);
+            SCG_EXIT_CRITICAL(u32Primask);
+            eStatus = SCG_CLOCK_VALID;
+        }
+    }
+
+    return eStatus;
+}
+
+/**
+ * @brief Clear the retained startup history and the degradation flags, e.g. after a crystal change.
+ */
+void SCG_ClearStartupHistory(void)
+{
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    s_tStartupHistory.u32Magic = 0U;
+    SCG_CheckStartupHistory();
+    SCG_EXIT_CRITICAL(u32Primask);
+}
+
+/**
+ * @brief Set the FOSC oscillator tuning used by the next FOSC enable.
+ *        A running FOSC is not reprogrammed, disable and enable it again to apply the new values.
+ * @param pTune: pointer to the tuning, NULL restores SCG_FOSC_TUNE_DEFAULT
+ */
+void SCG_SetFoscTuning(const SCG_FoscTuneType *pTune)
+{
+    static const SCG_FoscTuneType tDefault = SCG_FOSC_TUNE_DEFAULT;
+
+    s_tFoscTune = (pTune != NULL) ? *pTune : tDefault;
+}
+
+/**
+ * @brief Set the SOSC oscillator tuning used by the next SOSC enable.
+ *        A running SOSC is not reprogrammed, disable and enable it again to apply the new values.
+ * @param pTune: pointer to the tuning, NULL restores SCG_SOSC_TUNE_DEFAULT
+ */
+void SCG_SetSoscTuning(const SCG_SoscTuneType *pTune)
+{
+    static const SCG_SoscTuneType tDefault = SCG_SOSC_TUNE_DEFAULT;
+
+    s_tSoscTune = (pTune != NULL) ? *pTune : tDefault;
+}
+
+/**
+ * @brief Measure the FOSC time to valid for a list of tuning candidates.
+ *        For every candidate FOSC is disabled, reconfigured and enabled, and the SCG_GET_CYCLES()
+ *        ticks until FOSC valid are stored. The startup history is not updated.
+ *        Afterwards the tuning in effect before the sweep is restored and FOSC is configured by
+ *        SCG_SetFOSC(pFoscConfig). Margin is not measured: a candidate close to failing on one board
+ *        may fail on another, confirm the chosen setting over temperature and supply.
+ * @param pFoscConfig: FOSC configuration used for the sweep and applied afterwards
+ * @param pTune: array of u32Count tuning candidates
+ * @param pResult: array of u32Count results
+ * @param u32Count: number of candidates
+ * @return status of the final SCG_SetFOSC, SCG_CLOCK_SEQUENCE_ERROR if FOSC feeds the core or PLL0
+ *         or an async job is pending
+ */
+SCG_StatusType SCG_SweepFoscTuning(SCG_FoscType *pFoscConfig, const SCG_FoscTuneType *pTune,
+                                   SCG_OscSweepResultType *pResult, uint32_t u32Count)
+{
+    SCG_StatusType eStatus;
+    SCG_FoscTuneType tSaved;
+    uint32_t u32Index;
+    uint32_t u32Temp;
+    uint32_t u32Start;
+
+    /* if run clock is none, the function will init s_tClockSequenceInfo buffer first */
+    SCG_InitClockSrcStatus();
+
+    if ((s_tAsyncJob.ePhase != SCG_ASYNC_IDLE) ||
+            (s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_FOSC) ||
+            (s_tClockSequenceInfo.eRunClock == SCG_RUNCLOCK_PLL0_FOSC) ||
+            (((SCG->PLL0CSR & SCG_PLL0CSR_EN_MASK) != 0U) &&
+             ((SCG->PLL0CFG & SCG_PLL0CFG_SOURCE_MASK) == SCG_PLL0CFG_SOURCE(SCG_PLL0SOURCE_FOSC))))
+    {
+        eStatus = SCG_CLOCK_SEQUENCE_ERROR;
     }
-
-    if (eStatus == SCG_CLOCK_VALID)
+    else
     {
-        u32Temp = (uint32_t)((uint32_t)SCG_CCR_SYSCLK_CME(pSysClkConfig->bSysClkMonitor) |
-                             (uint32_t)SCG_CCR_SCS(pSysClkConfig->eSrc) |
-                             (uint32_t)SCG_CCR_DIVCORE(pSysClkConfig->eDivCore) |
-                             (uint32_t)SCG_CCR_DIVBUS(pSysClkConfig->eDivBus)  |
-                             (uint32_t)SCG_CCR_DIVSLOW(pSysClkConfig->eDivSlow));
-        SCG_HWA_SetCCR(u32Temp);
+        tSaved = s_tFoscTune;
 
-        u32Temp = SCG_CLKSRC_STABILIZATION_TIMEOUT;
-        while ((SCG_HWA_GetSysClkUPRD() == false) && (u32Temp > 0U))
+        for (u32Index = 0U; u32Index < u32Count; u32Index++)
         {
-            u32Temp--;
-        }
+            SCG_HWA_DisableFosc();
+            u32Temp = CLOCK_OFF_STABILIZATION_TIMEOUT;
+            while ((SCG_HWA_GetFoscValid() == true) && (u32Temp > 0U))
+            {
+                u32Temp--;
+            }
 
-        /*   Time out, clock select failed     */
-        if (u32Temp == 0U)
-        {
-            eStatus = SCG_CLOCK_TIMEOUT;
-        }
-        else if (SCG_HWA_GetSysClkSrc() != pSysClkConfig->eSrc)
-        {
-            eStatus = SCG_CLOCK_ERROR;
+            s_tFoscTune = pTune[u32Index];
+            SCG_HWA_SetFoscCfg(SCG_GetFoscCfgValue(pFoscConfig->bBypass));
+
+            u32Temp = SCG->FOSCCSR;
+            u32Temp &= ~(uint32_t)SCG_FOSCCSR_LK_MASK;
+            SCG_HWA_SetFoscCsr(u32Temp);
 
+            u32Start = SCG_GET_CYCLES();
+            SCG_HWA_SetFoscCsr(u32Temp | SCG_FOSCCSR_EN(1U));
+            u32Temp = FOSC_STABILIZATION_TIMEOUT;
+            while ((SCG_HWA_GetFoscValid() == false) && (u32Temp > 0U))
+            {
+                u32Temp--;
+            }
+            pResult[u32Index].u32Cycles = SCG_GET_CYCLES() - u32Start;
+            pResult[u32Index].eStatus = (u32Temp != 0U) ? SCG_CLOCK_VALID : SCG_CLOCK_TIMEOUT;
         }
-        else
+
+        SCG_HWA_DisableFosc();
+        u32Temp = CLOCK_OFF_STABILIZATION_TIMEOUT;
+        while ((SCG_HWA_GetFoscValid() == true) && (u32Temp > 0U))
         {
+            u32Temp--;
         }
-    }
+        s_tFoscTune = tSaved;
 
-    /* set core clock configuration information */
-    SCG_SetCoreClockStatus();
+        eStatus = SCG_SetFOSC(pFoscConfig);
+    }
 
     return eStatus;
 }
 
 /**
- * \brief  Switch system clock source during run time.
- * \param eClock: target clock source user want to switch.
- * \return true or false. This function check if the clock source is in proper range.
+ * @brief Measure the SOSC time to valid for a list of tuning candidates, see SCG_SweepFoscTuning.
+ * @param pSoscConfig: SOSC configuration used for the sweep and applied afterwards
+ * @param pTune: array of u32Count tuning candidates
+ * @param pResult: array of u32Count results
+ * @param u32Count: number of candidates
+ * @return status of the final SCG_SetSOSC, SCG_CLOCK_SEQUENCE_ERROR if an async job is pending
  */
-SCG_StatusType SCG_SwitchClkCtrlSrc(SCG_ClockSrcType eClock)
+SCG_StatusType SCG_SweepSoscTuning(SCG_SoscType *pSoscConfig, const SCG_SoscTuneType *pTune,
+                                   SCG_OscSweepResultType *pResult, uint32_t u32Count)
 {
-    SCG_StatusType eStatus = SCG_CLOCK_ERROR;
+    SCG_StatusType eStatus;
+    SCG_SoscTuneType tSaved;
+    uint32_t u32Index;
     uint32_t u32Temp;
+    uint32_t u32Start;
 
     /* if run clock is none, the function will init s_tClockSequenceInfo buffer first */
     SCG_InitClockSrcStatus();
 
-    switch (eClock)
-    {
-    case SCG_CLOCK_SRC_FOSC:
+    if (s_tAsyncJob.ePhase != SCG_ASYNC_IDLE)
     {
-        if (s_tClockSequenceInfo.tClockInfo[SCG_FOSC_CLK].eClkStatus == SCG_CLOCK_VALID)
-        {
-            u32Temp = SCG->CCR;
-            u32Temp &= ~SCG_CCR_SCS_MASK;
-            u32Temp |= SCG_CCR_SCS(eClock);
-            SCG_HWA_SetCCR(u32Temp);
-            eStatus = SCG_CLOCK_VALID;
-        }
+        eStatus = SCG_CLOCK_SEQUENCE_ERROR;
     }
-    break;
-
-    case SCG_CLOCK_SRC_FIRC:
+    else
     {
-        if (s_tClockSequenceInfo.tClockInfo[SCG_FIRC_CLK].eClkStatus == SCG_CLOCK_VALID)
+        tSaved = s_tSoscTune;
+
+        for (u32Index = 0U; u32Index < u32Count; u32Index++)
         {
-            u32Temp = SCG->CCR;
-            u32Temp &= ~SCG_CCR_SCS_MASK;
-            u32Temp |= SCG_CCR_SCS(eClock);
-            SCG_HWA_SetCCR(u32Temp);
-            eStatus = SCG_CLOCK_VALID;
+            SCG_HWA_DisableSosc();
+            u32Temp = CLOCK_OFF_STABILIZATION_TIMEOUT;
+            while ((SCG_HWA_GetSoscValid() == true) && (u32Temp > 0U))
+            {
+                u32Temp--;
+            }
+
+            s_tSoscTune = pTune[u32Index];
+            SCG_HWA_SetSoscCfg(SCG_GetSoscCfgValue());
+
+            u32Temp = SCG->SOSCCSR;
+            u32Temp &= ~(uint32_t)(SCG_SOSCCSR_LK_MASK | SCG_SOSCCSR_BYPASS_MASK);
+            u32Temp |= SCG_SOSCCSR_BYPASS(pSoscConfig->bBypass);
+            SCG_HWA_SetSoscCcr(u32Temp);
+
+            u32Start = SCG_GET_CYCLES();
+            SCG_HWA_SetSoscCcr(u32Temp | SCG_SOSCCSR_EN(1U));
+            u32Temp = SOSC_STABILIZATION_TIMEOUT;
+            while ((SCG_HWA_GetSoscValid() == false) && (u32Temp > 0U))
+            {
+                u32Temp--;
+            }
+            pResult[u32Index].u32Cycles = SCG_GET_CYCLES() - u32Start;
+            pResult[u32Index].eStatus = (u32Temp != 0U) ? SCG_CLOCK_VALID : SCG_CLOCK_TIMEOUT;
         }
-    }
-    break;
 
-    case SCG_CLOCK_SRC_PLL0:
-    {
-        if (s_tClockSequenceInfo.tClockInfo[SCG_PLL0_CLK].eClkStatus == SCG_CLOCK_VALID)
+        SCG_HWA_DisableSosc();
+        u32Temp = CLOCK_OFF_STABILIZATION_TIMEOUT;
+        while ((SCG_HWA_GetSoscValid() == true) && (u32Temp > 0U))
         {
-            u32Temp = SCG->CCR;
-            u32Temp &= ~SCG_CCR_SCS_MASK;
-            u32Temp |= SCG_CCR_SCS(eClock);
-            SCG_HWA_SetCCR(u32Temp);
-            eStatus = SCG_CLOCK_VALID;
+            u32Temp--;
         }
-    }
-    break;
+        s_tSoscTune = tSaved;
 
-    default:
-        /* do nothing */
-        break;
+        eStatus = SCG_SetSOSC(pSoscConfig);
     }
 
-    if (eStatus == SCG_CLOCK_VALID)
-    {
-        /* set core clock configuration information */
-        SCG_SetCoreClockStatus();
-    }
     return eStatus;
 }
 
 /**
- * \brief Report the clock source status and frequency configured in MCU run time.
- *        The clock frequency and status would change by clock set function.
- * \param eScgClockName: the clock source to query
- * \param pFrequency: frequency variable point to get the frequency value
- * \return true or false. This indicate the clock source status invalid or request clock source out of
- *         range.
+ * @brief Configure the core clock ramp used by SCG_SetClkCtrl and SCG_SetClkCtrlAsync.
+ *        The ramp runs with interrupts masked, the tick timer is rescaled once at the end.
+ *        Both dwells are capped at SCG_RAMP_DWELL_MAX loops to bound the masked time.
+ * @param pRamp: ramp configuration, NULL disables the ramp
  */
-SCG_StatusType SCG_GetScgClockFreq(SCG_ClkSrcType eScgClockName,  uint32_t *pFrequency)
+void SCG_SetRampCfg(const SCG_RampCfgType *pRamp)
 {
-    SCG_StatusType eStatus;
-    if (eScgClockName > SCG_END_OF_CLOCKS)
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    if (pRamp != NULL)
     {
-        eStatus = SCG_CLOCK_PARAM_INVALID;
-        *pFrequency = 0U;
+        s_tRamp = *pRamp;
+        if (s_tRamp.u32UpDwell > SCG_RAMP_DWELL_MAX)
+        {
+            s_tRamp.u32UpDwell = SCG_RAMP_DWELL_MAX;
+        }
+        if (s_tRamp.u32DownDwell > SCG_RAMP_DWELL_MAX)
+        {
+            s_tRamp.u32DownDwell = SCG_RAMP_DWELL_MAX;
+        }
     }
     else
     {
-        eStatus = s_tClockSequenceInfo.tClockInfo[eScgClockName].eClkStatus;
-        *pFrequency = s_tClockSequenceInfo.tClockInfo[eScgClockName].u32Freq;
+        s_tRamp.bEnable = false;
+        s_tRamp.u32UpDwell = 0U;
+        s_tRamp.u32DownDwell = 0U;
     }
-    return eStatus;
+    SCG_EXIT_CRITICAL(u32Primask);
 }
 
 /**
- * \brief  Set clock out source in SCG. it set SCG_CLKOUTCFG [CLKOUTSEL].
- * \param pSysClkConfig: pointer to the clockCtrlType structure data instance,
- *        which defined for system clock selection.
+ * @brief Copy the clock tree maintained by the driver.
+ * @param pTree: pointer to the copy
  */
-void SCG_SetClkOut(SCG_ClockCtrlType *pSysClkConfig)
+void SCG_GetClockTree(SCG_ClockSequenceType *pTree)
 {
-    uint32_t u32Temp;
-
     /* if run clock is none, the function will init s_tClockSequenceInfo buffer first */
     SCG_InitClockSrcStatus();
 
-    SCG_ClockoutSrcType eClockOutSrc = SCG_CLOCKOUT_SRC_PLL0;
-    SCG_NvmClkSrcType eNvmClockSrc = SCG_NVMCLK_SRC_FIRC;
-    eClockOutSrc = pSysClkConfig->eClkOutSrc;
-    eNvmClockSrc = pSysClkConfig->eNvmClkSrc;
-
-    /*   disable as NVMCLK source first time
-         set clock out source together            */
-    u32Temp = SCG->CLKOUTCFG;
-    u32Temp &= ~(SCG_CLKOUTCFG_CLKOUTSEL_MASK | SCG_CLKOUTCFG_NVMCLK_FIRC_MASK | SCG_CLKOUTCFG_NVMCLK_SIRC_MASK);
-    u32Temp |= (uint32_t)(SCG_CLKOUTCFG_CLKOUTSEL(eClockOutSrc));
-    SCG_HWA_SetClkOutCfg(u32Temp);
+    *pTree = s_tClockSequenceInfo;
+}
 
-    /*   enable configured NVMCLK source          */
-    if (eNvmClockSrc == SCG_NVMCLK_SRC_FIRC)
+/**
+ * @brief Predict the clock tree resulting from a set of configurations, without any register access.
+ *        Nodes without a proposal keep their current value. Without pClkCtrl the system clock keeps its
+ *        source and its current CORE/BUS/SLOW ratios, and CLKOUT keeps its current value.
+ *        Predicted frequencies follow what the driver reports after the setters ran, violations follow
+ *        the checks of the setters. A rejected source is predicted disabled.
+ * @param pCurrent: current tree, from SCG_GetClockTree or an earlier prediction
+ * @param pProposal: configurations to evaluate, NULL members are left unchanged
+ * @param pResult: predicted tree, may be the same object as pCurrent
+ * @return SCG_WHATIF_xxx violations, 0 if the setters would accept the proposal
+ */
+uint32_t SCG_EvaluateClockTree(const SCG_ClockSequenceType *pCurrent, const SCG_ClockProposalType *pProposal,
+                               SCG_ClockSequenceType *pResult)
+{
+    uint32_t u32Violation = 0U;
+    SCG_ClockSequenceType tTree = *pCurrent;
+    SCG_ClkSrcType eNode = SCG_END_OF_CLOCKS;
+    uint32_t u32DivCore = 0U;
+    uint32_t u32DivBus = 0U;
+    uint32_t u32DivSlow = 0U;
+    SCG_CalcSysFreqType tSysFreq = {0U, 0U, 0U};
+
+    if (pProposal->pFirc != NULL)
     {
-        u32Temp |= SCG_CLKOUTCFG_NVMCLK_FIRC_MASK;
+        SCG_PredictSrc(&tTree.tClockInfo[SCG_FIRC_CLK], pProposal->pFirc->bEnable, FIRC_CLOCK);
+        SCG_PredictDiv(&tTree.tClockInfo[SCG_FIRCDIVH_CLK], &tTree.tClockInfo[SCG_FIRC_CLK], pProposal->pFirc->eDivH);
+        SCG_PredictDiv(&tTree.tClockInfo[SCG_FIRCDIVM_CLK], &tTree.tClockInfo[SCG_FIRC_CLK], pProposal->pFirc->eDivM);
     }
-    else
+
+    if (pProposal->pSirc != NULL)
     {
-        u32Temp |= SCG_CLKOUTCFG_NVMCLK_SIRC_MASK;
+        SCG_PredictSrc(&tTree.tClockInfo[SCG_SIRC_CLK], true, SIRC_CLOCK);
+        SCG_PredictDiv(&tTree.tClockInfo[SCG_SIRCDIVH_CLK], &tTree.tClockInfo[SCG_SIRC_CLK], pProposal->pSirc->eDivH);
+        SCG_PredictDiv(&tTree.tClockInfo[SCG_SIRCDIVM_CLK], &tTree.tClockInfo[SCG_SIRC_CLK], pProposal->pSirc->eDivM);
     }
-    SCG_HWA_SetClkOutCfg(u32Temp);
 
-    /* set clock out configuration information */
-    SCG_SetClockOutStatus();
+    if (pProposal->pFosc != NULL)
+    {
+        if ((pProposal->pFosc->bEnable == true) && (pProposal->pFosc->u32XtalFreq == 0U))
+        {
+            u32Violation |= SCG_WHATIF_PARAM_INVALID;
+        }
+        SCG_PredictSrc(&tTree.tClockInfo[SCG_FOSC_CLK], (pProposal->pFosc->bEnable == true) &&
+                       (pProposal->pFosc->u32XtalFreq != 0U), pProposal->pFosc->u32XtalFreq);
+        SCG_PredictDiv(&tTree.tClockInfo[SCG_FOSCDIVH_CLK], &tTree.tClockInfo[SCG_FOSC_CLK], pProposal->pFosc->eDivH);
+        SCG_PredictDiv(&tTree.tClockInfo[SCG_FOSCDIVM_CLK], &tTree.tClockInfo[SCG_FOSC_CLK], pProposal->pFosc->eDivM);
+        SCG_PredictDiv(&tTree.tClockInfo[SCG_FOSCDIVL_CLK], &tTree.tClockInfo[SCG_FOSC_CLK], pProposal->pFosc->eDivL);
+    }
 
-}
+    if (pProposal->pSosc != NULL)
+    {
+        if ((pProposal->pSosc->bEnable == true) && (pProposal->pSosc->u32XtalFreq == 0U))
+        {
+            u32Violation |= SCG_WHATIF_PARAM_INVALID;
+        }
+        SCG_PredictSrc(&tTree.tClockInfo[SCG_SOSC_CLK], (pProposal->pSosc->bEnable == true) &&
+                       (pProposal->pSosc->u32XtalFreq != 0U), pProposal->pSosc->u32XtalFreq);
+    }
 
-/**
- * @brief Clock source De-init
- *
- * @return SCG_StatusType function status
- */
-SCG_StatusType SCG_Deinit(void)
-{
-    SCG_StatusType eStatusVal = SCG_CLOCK_VALID;
-    SCG_Pll0Type tPll0Cfg = {
-        .bEnable = false
-    };
-    SCG_FoscType tFoscCfg = {
-        .bEnable = false
-    };
-    SCG_SoscType tSoscCfg = {
-        .bEnable = false
-    };
-    SCG_Sirc32kType tSirc32kCfg = {
-        .bEn = false
-    };
-    SCG_FircType tFircCfg =
+    if (pProposal->pPll0 != NULL)
     {
-        .bEnable = true,
-        .bLock = false,
-        .bCm = false,
-        .bTrEn = false,
-        .bSten = false,
-        .u8TrimSrc = 0U,
-        .eDivL = SCG_ASYNCCLOCKDIV_BY4,
-        .eDivM = SCG_ASYNCCLOCKDIV_BY2,
-        .eDivH = SCG_ASYNCCLOCKDIV_BY1
-    };
+        u32Violation |= SCG_PredictPll0(&tTree, pProposal->pPll0);
+        if ((tTree.eRunClock == SCG_RUNCLOCK_PLL0_FIRC) || (tTree.eRunClock == SCG_RUNCLOCK_PLL0_FOSC))
+        {
+            tTree.eRunClock = (pProposal->pPll0->eSrc == SCG_PLL0SOURCE_FIRC) ? SCG_RUNCLOCK_PLL0_FIRC : SCG_RUNCLOCK_PLL0_FOSC;
+        }
+    }
 
-    if (SCG_HWA_GetSysClkSrc() != (uint8_t)SCG_CLOCK_SRC_FIRC)
+    if (pProposal->pClkCtrl != NULL)
     {
-        eStatusVal = SCG_SwitchClkCtrlSrc(SCG_CLOCK_SRC_FIRC);
-        if (SCG_CLOCK_ERROR == eStatusVal)
+        eNode = SCG_GetSysSrcNode(pProposal->pClkCtrl->eSrc);
+        u32DivCore = (uint32_t)pProposal->pClkCtrl->eDivCore;
+        u32DivBus = (uint32_t)pProposal->pClkCtrl->eDivBus;
+        u32DivSlow = (uint32_t)pProposal->pClkCtrl->eDivSlow;
+        switch (pProposal->pClkCtrl->eSrc)
         {
-            eStatusVal = SCG_SetFIRC(&tFircCfg);
-            if (SCG_CLOCK_TIMEOUT != eStatusVal)
+        case SCG_CLOCK_SRC_FOSC:
+            tTree.eRunClock = SCG_RUNCLOCK_FOSC;
+            break;
+        case SCG_CLOCK_SRC_FIRC:
+            tTree.eRunClock = SCG_RUNCLOCK_FIRC;
+            break;
+        default:
+            /* PLL0 reference: the proposal, else the current run clock, else FOSC */
+            if (pProposal->pPll0 != NULL)
             {
-                eStatusVal = SCG_SwitchClkCtrlSrc(SCG_CLOCK_SRC_FIRC);
+                tTree.eRunClock = (pProposal->pPll0->eSrc == SCG_PLL0SOURCE_FIRC) ? SCG_RUNCLOCK_PLL0_FIRC : SCG_RUNCLOCK_PLL0_FOSC;
+            }
+            else if (tTree.eRunClock != SCG_RUNCLOCK_PLL0_FIRC)
+            {
+                tTree.eRunClock = SCG_RUNCLOCK_PLL0_FOSC;
             }
+            else
+            {
+            }
+            break;
         }
+        u32Violation |= SCG_PredictSysClk(&tTree, eNode, u32DivCore, u32DivBus, u32DivSlow);
+        SCG_PredictClkOut(&tTree, pProposal->pClkCtrl->eClkOutSrc);
     }
-
-    if (SCG_CLOCK_VALID == eStatusVal)
+    else
     {
-        /* Disable all clock source */
-        (void)SCG_SetPLL0(&tPll0Cfg);
-        (void)SCG_SetFOSC(&tFoscCfg);
-        (void)SCG_SetSOSC(&tSoscCfg);
-        (void)SCG_SetSIRC32K(&tSirc32kCfg);
+        /* keep the current source and recover the CCR dividers from the current ratios */
+        switch (pCurrent->eRunClock)
+        {
+        case SCG_RUNCLOCK_FIRC:
+            eNode = SCG_FIRC_CLK;
+            break;
+        case SCG_RUNCLOCK_FOSC:
+            eNode = SCG_FOSC_CLK;
+            break;
+        case SCG_RUNCLOCK_PLL0_FIRC:
+        case SCG_RUNCLOCK_PLL0_FOSC:
+            eNode = SCG_PLL0_CLK;
+            break;
+        default:
+            eNode = SCG_END_OF_CLOCKS;
+            break;
+        }
+
+        tSysFreq.u32CoreFreq = pCurrent->tClockInfo[SCG_CORE_CLK].u32Freq;
+        tSysFreq.u32BusFreq = pCurrent->tClockInfo[SCG_BUS_CLK].u32Freq;
+        tSysFreq.u32SlowFreq = pCurrent->tClockInfo[SCG_SLOW_CLK].u32Freq;
+        if ((eNode != SCG_END_OF_CLOCKS) && (tSysFreq.u32CoreFreq != UNKNOWN_CLOCK) && (tSysFreq.u32CoreFreq != 0U) &&
+                (tSysFreq.u32BusFreq != 0U) && (tSysFreq.u32SlowFreq != 0U))
+        {
+            u32DivCore = (pCurrent->tClockInfo[eNode].u32Freq / tSysFreq.u32CoreFreq) - 1U;
+            u32DivBus = (tSysFreq.u32CoreFreq / tSysFreq.u32BusFreq) - 1U;
+            u32DivSlow = (tSysFreq.u32CoreFreq / tSysFreq.u32SlowFreq) - 1U;
+            u32Violation |= SCG_PredictSysClk(&tTree, eNode, u32DivCore, u32DivBus, u32DivSlow);
+        }
     }
 
-    return eStatusVal;
+    *pResult = tTree;
+
+    return u32Violation;
 }
 
+#ifdef SCG_TRACE_ENABLE
 /**
- * @brief Clock error interrupt handler
- *
+ * @brief Copy the most recent trace entries, oldest first.
+ *        Entries recorded while the copy runs may be torn, dump with the clock APIs idle.
+ * @param pEntry: destination of the entries
+ * @param u32Max: capacity of pEntry
+ * @return number of entries copied
  */
-void SCG_IRQHandler(void)
+uint32_t SCG_TraceDump(SCG_TraceEntryType *pEntry, uint32_t u32Max)
 {
-    if ((true == SCG_HWA_CheckAndClearSircClkErr()) && (NULL != s_SircClkErrNotify))
-    {
-        s_SircClkErrNotify();
-    }
+    uint32_t u32Head = s_u32TraceHead;
+    uint32_t u32Count = (u32Head < SCG_TRACE_LEN) ? u32Head : SCG_TRACE_LEN;
+    uint32_t u32Index;
 
-    if((true == SCG_HWA_CheckAndClearSoscClkErr()) && (NULL != s_SoscClkErrNotify))
+    if (u32Count > u32Max)
     {
-        s_SoscClkErrNotify();
+        u32Count = u32Max;
     }
 
-    if((true == SCG_HWA_CheckAndClearFoscClkErr()) && (NULL != s_FoscClkErrNotify))
+    for (u32Index = 0U; u32Index < u32Count; u32Index++)
     {
-        s_FoscClkErrNotify();
+        pEntry[u32Index] = s_tTraceEntry[(u32Head - u32Count + u32Index) & (SCG_TRACE_LEN - 1U)];
     }
 
-    if((true == SCG_HWA_CheckAndClearPll0ClkErr()) && (NULL != s_Pll0ClkErrNotify) )
-    {
-        s_Pll0ClkErrNotify();
-    }
+    return u32Count;
+}
+
+/**
+ * @brief Discard the recorded trace.
+ */
+void SCG_TraceReset(void)
+{
+    uint32_t u32Primask;
 
-    if((true == SCG_HWA_CheckAndClearFircClkErr()) && (NULL != s_FircClkErrNotify))
+    SCG_ENTER_CRITICAL(u32Primask);
+    s_u32TraceHead = 0U;
+    SCG_EXIT_CRITICAL(u32Primask);
+}
+#endif
+
+/**
+ * @brief Get the clock monitor event statistics of a source.
+ *        Events are counted by SCG_IRQHandler whether or not a notification callback is installed.
+ * @param eSrc: SCG_SIRC_CLK, SCG_SOSC_CLK, SCG_FOSC_CLK, SCG_PLL0_CLK or SCG_FIRC_CLK
+ * @param pStats: statistics output
+ * @return SCG_CLOCK_VALID on success, SCG_CLOCK_PARAM_INVALID for a source without clock monitor
+ */
+SCG_StatusType SCG_GetClockMonitorStats(SCG_ClkSrcType eSrc, SCG_ClockMonitorStatsType *pStats)
+{
+    SCG_StatusType eStatus = SCG_CLOCK_PARAM_INVALID;
+    uint32_t u32Primask;
+    uint8_t u8Slot = SCG_GetMonitorSlot(eSrc);
+
+    if (u8Slot < 5U)
     {
-        s_FircClkErrNotify();
+        SCG_ENTER_CRITICAL(u32Primask);
+        *pStats = s_tMonitorStats[u8Slot];
+        SCG_EXIT_CRITICAL(u32Primask);
+        if (pStats->u32Count == 0U)
+        {
+            pStats->u32MinInterval = 0xFFFFFFFFU;
+        }
+        eStatus = SCG_CLOCK_VALID;
     }
+
+    return eStatus;
+}
+
+/**
+ * @brief Clear the clock monitor event statistics of all sources.
+ */
+void SCG_ClearClockMonitorStats(void)
+{
+    uint32_t u32Primask;
+
+    SCG_ENTER_CRITICAL(u32Primask);
+    (void)memset(s_tMonitorStats, 0, sizeof(s_tMonitorStats));
+    SCG_EXIT_CRITICAL(u32Primask);
+}
+
+/**
+ * @brief Register the callback of SCG_Audit.
+ * @param pNotify: called when the audit found the clock tree changed, NULL to disable
+ */
+void SCG_SetAuditNotify(SCG_AuditNotifyCallBackType pNotify)
+{
+    s_tAudit.pNotify = pNotify;
 }
 
+/**
+ * @brief Check s_tClockSequenceInfo against the hardware.
+ *        The SCG status and configuration registers are hashed and compared with the hash of the
+ *        registers the tree was last built from. Only on mismatch the tree is rebuilt from the
+ *        registers, the tick timer rescaled if the core clock changed and, if any node differs,
+ *        the audit callback called. The first call after a driver clock change rebuilds the tree
+ *        too but finds no difference. Cheap enough for a 1 ms task: 13 register reads on a match.
+ * @return true if the clock tree differed from the hardware
+ */
+bool SCG_Audit(void)
+{
+    SCG_ClockSequenceType tOld;
+    uint32_t u32Hash;
+    uint32_t u32Primask;
+    bool bChanged = false;
+
+    /* if run clock is none, the function will init s_tClockSequenceInfo buffer first */
+    SCG_InitClockSrcStatus();
+
+    u32Hash = SCG_GetAuditHash();
+    if ((s_tAudit.bHashValid == false) || (u32Hash != s_tAudit.u32Hash))
+    {
+        SCG_ENTER_CRITICAL(u32Primask);
+        tOld = s_tClockSequenceInfo;
+        if ((tOld.tClockInfo[SCG_FOSC_CLK].eClkStatus == SCG_CLOCK_VALID) &&
+                (tOld.tClockInfo[SCG_FOSC_CLK].u32Freq != 0U))
+        {
+            s_tAudit.u32FoscFreq = tOld.tClockInfo[SCG_FOSC_CLK].u32Freq;
+        }
+        if ((tOld.tClockInfo[SCG_SOSC_CLK].eClkStatus == SCG_CLOCK_VALID) &&
+                (tOld.tClockInfo[SCG_SOSC_CLK].u32Freq != 0U))
+        {
+            s_tAudit.u32SoscFreq = tOld.tClockInfo[SCG_SOSC_CLK].u32Freq;
+        }
+        SCG_ReadClockTree((s_tAudit.u32FoscFreq != 0U) ? s_tAudit.u32FoscFreq : (uint32_t)UNKNOWN_CLOCK,
+                          (s_tAudit.u32SoscFreq != 0U) ? s_tAudit.u32SoscFreq : (uint32_t)UNKNOWN_CLOCK);
+        /* the registers may have moved while the tree was read, hash them again on the next call */
+        s_tAudit.u32Hash = u32Hash;
+        s_tAudit.bHashValid = (SCG_GetAuditHash() == u32Hash);
+        bChanged = (memcmp(&tOld, &s_tClockSequenceInfo, sizeof(SCG_ClockSequenceType)) != 0);
+        if (tOld.tClockInfo[SCG_CORE_CLK].u32Freq != s_tClockSequenceInfo.tClockInfo[SCG_CORE_CLK].u32Freq)
+        {
+            SCG_RescaleTimebase(tOld.tClockInfo[SCG_CORE_CLK].u32Freq);
+        }
+        SCG_EXIT_CRITICAL(u32Primask);
 
+        if ((bChanged == true) && (s_tAudit.pNotify != NULL))
+        {
+            s_tAudit.pNotify(&tOld, &s_tClockSequenceInfo);
+        }
+    }
 
+    return bChanged;
+}
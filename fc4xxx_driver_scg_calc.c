@@ -0,0 +1,276 @@
+/**
+ * @file fc4xxx_driver_scg_calc.c
+ * @author Flagchip
+ * @brief FC4xxx SCG clock tree arithmetic, limits and clock plan image format
+ * @version 0.1.0B
+ * @date 2023-09-07
+ *
+ * @copyright Copyright (c) 2020-2023 Flagchip Semiconductors Co., Ltd.
+ *
+ */
+
+/********************************************************************************
+*   Revision History:
+*
+*   Version     Date          Initials       CR#          Descriptions
+*   ---------   ----------    ------------   ----------   ---------------
+*   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
+********************************************************************************/
+#include <stddef.h>
+#include "fc4xxx_driver_scg_calc.h"
+
+/* ################################################################################## */
+/* ####################################### Macro #################################### */
+#define SCG_CALC_PREDIV_MAX     7U
+#define SCG_CALC_MULT_MAX       47U
+#define SCG_CALC_ASYNCDIV_MAX   7U
+#define SCG_CALC_SYSDIV_MAX     15U
+#define SCG_CALC_CRC32_POLY     0xEDB88320U
+#define SCG_CALC_FNV_OFFSET     0x811C9DC5U
+#define SCG_CALC_FNV_PRIME      0x01000193U
+
+/* ################################################################################## */
+/* ################################ Local Functions  ################################ */
+
+static bool SCG_CalcIsAsyncDivValid(const uint8_t au8Div[3U])
+{
+    return ((au8Div[0U] <= SCG_CALC_ASYNCDIV_MAX) && (au8Div[1U] <= SCG_CALC_ASYNCDIV_MAX) &&
+            (au8Div[2U] <= SCG_CALC_ASYNCDIV_MAX));
+}
+
+/* floor of src * (mult + 16) / (u32FixedDiv * (prediv + 1)), multiplied before dividing */
+static uint32_t SCG_CalcPll0Scale(uint32_t u32SrcFreq, uint32_t u32FixedDiv, uint32_t u32Prediv, uint32_t u32Mult)
+{
+    return (uint32_t)(((uint64_t)u32SrcFreq * (u32Mult + 16U)) / ((uint64_t)u32FixedDiv * (u32Prediv + 1U)));
+}
+
+static uint64_t SCG_CalcGcd(uint64_t u64A, uint64_t u64B)
+{
+    uint64_t u64Temp;
+
+    while (u64B != 0U)
+    {
+        u64Temp = u64A % u64B;
+        u64A = u64B;
+        u64B = u64Temp;
+    }
+
+    return u64A;
+}
+
+/* ################################################################################## */
+/* ################################ Global Functions ################################ */
+
+uint32_t SCG_CalcPll0Freq(uint32_t u32SrcFreq, bool bFircSrc, uint32_t u32Prediv, uint32_t u32Mult)
+{
+    /*   PLL0 input is FIRC clock/2      */
+    return SCG_CalcPll0Scale(u32SrcFreq, (bFircSrc == true) ? 4U : 2U, u32Prediv, u32Mult);
+}
+
+uint32_t SCG_CalcPll0NodeFreq(uint32_t u32SrcFreq, uint32_t u32Prediv, uint32_t u32Mult)
+{
+    return SCG_CalcPll0Scale(u32SrcFreq, 2U, u32Prediv, u32Mult);
+}
+
+bool SCG_CalcPll0InRange(uint32_t u32Pll0Freq, bool bFircSrc)
+{
+    bool bResult;
+
+    if (bFircSrc == true)
+    {
+        bResult = (u32Pll0Freq <= PLL0_CLK_MAX) && (u32Pll0Freq >= PLL0_CLK_MIN);
+    }
+    else
+    {
+        bResult = (u32Pll0Freq < PLL0_CLK_MAX) && (u32Pll0Freq > PLL0_CLK_MIN);
+    }
+
+    return bResult;
+}
+
+bool SCG_CalcSysClk(uint32_t u32SrcFreq, uint32_t u32DivCore, uint32_t u32DivBus, uint32_t u32DivSlow,
+                    SCG_CalcSysFreqType *pSysFreq)
+{
+    uint32_t u32FreqCore, u32FreqBus, u32FreqSlow;
+
+    u32FreqCore = u32SrcFreq / (u32DivCore + 1U);
+    u32FreqBus = u32FreqCore / (u32DivBus + 1U);
+    u32FreqSlow = u32FreqCore / (u32DivSlow + 1U);
+
+    if (pSysFreq != NULL)
+    {
+        pSysFreq->u32CoreFreq = u32FreqCore;
+        pSysFreq->u32BusFreq = u32FreqBus;
+        pSysFreq->u32SlowFreq = u32FreqSlow;
+    }
+
+    return ((u32FreqCore <= SYS_CORE_CLK_MAX) && (u32FreqBus <= SYS_BUS_CLK_MAX) && (u32FreqSlow <= SYS_SLOW_CLK_MAX));
+}
+
+uint32_t SCG_CalcAsyncDivFreq(uint32_t u32SrcFreq, uint32_t u32Div)
+{
+    uint32_t u32Freq;
+
+    if ((u32Div == 0U) || (u32Div > SCG_CALC_ASYNCDIV_MAX))
+    {
+        u32Freq = 0U;
+    }
+    else
+    {
+        u32Freq = u32SrcFreq >> (u32Div - 1U);
+    }
+
+    return u32Freq;
+}
+
+void SCG_CalcFreqScale(SCG_CalcFreqType *pFreq, uint32_t u32Mul, uint32_t u32Div)
+{
+    uint64_t u64Gcd;
+
+    /* cancel crosswise first so the numerator only grows by what is left of the multiplier */
+    u64Gcd = SCG_CalcGcd(pFreq->u64Num, u32Div);
+    pFreq->u64Num /= u64Gcd;
+    u32Div /= (uint32_t)u64Gcd;
+    u64Gcd = SCG_CalcGcd(u32Mul, pFreq->u32Den);
+    u32Mul /= (uint32_t)u64Gcd;
+    pFreq->u32Den /= (uint32_t)u64Gcd;
+
+    pFreq->u64Num *= u32Mul;
+    pFreq->u32Den *= u32Div;
+    if (pFreq->u64Num == 0U)
+    {
+        pFreq->u32Den = 1U;
+    }
+}
+
+uint64_t SCG_CalcFreqMilliHz(const SCG_CalcFreqType *pFreq)
+{
+    return ((pFreq->u64Num * 1000U) + (pFreq->u32Den / 2U)) / pFreq->u32Den;
+}
+
+uint32_t SCG_CalcCrc32(const uint8_t *pData, uint32_t u32Len)
+{
+    uint32_t u32Crc = 0xFFFFFFFFU;
+    uint32_t u32Index;
+    uint8_t u8Bit;
+
+    for (u32Index = 0U; u32Index < u32Len; u32Index++)
+    {
+        u32Crc ^= (uint32_t)pData[u32Index];
+        for (u8Bit = 0U; u8Bit < 8U; u8Bit++)
+        {
+            if ((u32Crc & 1U) != 0U)
+            {
+                u32Crc = (u32Crc >> 1U) ^ SCG_CALC_CRC32_POLY;
+            }
+            else
+            {
+                u32Crc = u32Crc >> 1U;
+            }
+        }
+    }
+
+    return u32Crc ^ 0xFFFFFFFFU;
+}
+
+uint32_t SCG_CalcHashWords(const uint32_t *pWord, uint32_t u32Count)
+{
+    uint32_t u32Hash = SCG_CALC_FNV_OFFSET;
+    uint32_t u32Index;
+
+    for (u32Index = 0U; u32Index < u32Count; u32Index++)
+    {
+        u32Hash = (u32Hash ^ pWord[u32Index]) * SCG_CALC_FNV_PRIME;
+    }
+
+    return u32Hash;
+}
+
+SCG_CalcResultType SCG_CalcCheckPlan(const SCG_ClockPlanType *pPlan, SCG_CalcSysFreqType *pSysFreq)
+{
+    SCG_CalcResultType eResult = SCG_CALC_OK;
+    bool bFoscEn = ((pPlan->u16Flags & SCG_PLAN_FLAG_FOSC_EN) != 0U);
+    bool bPll0En = ((pPlan->u16Flags & SCG_PLAN_FLAG_PLL0_EN) != 0U);
+    bool bFircSrc;
+    uint32_t u32Pll0Freq = 0U;
+    uint32_t u32Pll0NodeFreq = 0U;
+    uint32_t u32SysFreq;
+
+    if (((pPlan->u16Flags & (uint16_t)~SCG_PLAN_FLAG_MASK) != 0U) ||
+            (pPlan->u8Pll0Src > (uint8_t)SCG_PLAN_SRC_FOSC) || (pPlan->u8SysSrc > (uint8_t)SCG_PLAN_SRC_PLL0) ||
+            (pPlan->u8Pll0Prediv > SCG_CALC_PREDIV_MAX) || (pPlan->u8Pll0Mult > SCG_CALC_MULT_MAX) ||
+            (pPlan->u8DivCore > SCG_CALC_SYSDIV_MAX) || (pPlan->u8DivBus > SCG_CALC_SYSDIV_MAX) ||
+            (pPlan->u8DivSlow > SCG_CALC_SYSDIV_MAX) || (SCG_CalcIsAsyncDivValid(pPlan->au8FircDiv) == false) ||
+            (SCG_CalcIsAsyncDivValid(pPlan->au8FoscDiv) == false) || (SCG_CalcIsAsyncDivValid(pPlan->au8Pll0Div) == false) ||
+            ((bFoscEn == true) && (pPlan->u32FoscFreq == 0U)))
+    {
+        eResult = SCG_CALC_PARAM_INVALID;
+    }
+    else if (bPll0En == true)
+    {
+        bFircSrc = (pPlan->u8Pll0Src == (uint8_t)SCG_PLAN_SRC_FIRC);
+        if ((bFircSrc == false) && (bFoscEn == false))
+        {
+            eResult = SCG_CALC_SRC_DISABLED;
+        }
+        else
+        {
+            u32Pll0Freq = SCG_CalcPll0Freq((bFircSrc == true) ? FIRC_CLOCK : pPlan->u32FoscFreq, bFircSrc,
+                                           pPlan->u8Pll0Prediv, pPlan->u8Pll0Mult);
+            /* the system clock limits apply to the frequency the driver reports for PLL0 */
+            u32Pll0NodeFreq = SCG_CalcPll0NodeFreq((bFircSrc == true) ? FIRC_CLOCK : pPlan->u32FoscFreq,
+                                                   pPlan->u8Pll0Prediv, pPlan->u8Pll0Mult);
+            if (SCG_CalcPll0InRange(u32Pll0Freq, bFircSrc) == false)
+            {
+                eResult = SCG_CALC_PLL0_RANGE;
+            }
+        }
+    }
+    else
+    {
+    }
+
+    if (eResult == SCG_CALC_OK)
+    {
+        switch (pPlan->u8SysSrc)
+        {
+        case (uint8_t)SCG_PLAN_SRC_FOSC:
+            u32SysFreq = pPlan->u32FoscFreq;
+            eResult = (bFoscEn == true) ? SCG_CALC_OK : SCG_CALC_SRC_DISABLED;
+            break;
+        case (uint8_t)SCG_PLAN_SRC_PLL0:
+            u32SysFreq = u32Pll0NodeFreq;
+            eResult = (bPll0En == true) ? SCG_CALC_OK : SCG_CALC_SRC_DISABLED;
+            break;
+        default:
+            u32SysFreq = FIRC_CLOCK;
+            break;
+        }
+
+        if ((eResult == SCG_CALC_OK) &&
+                (SCG_CalcSysClk(u32SysFreq, pPlan->u8DivCore, pPlan->u8DivBus, pPlan->u8DivSlow, pSysFreq) == false))
+        {
+            eResult = SCG_CALC_SYSCLK_RANGE;
+        }
+    }
+
+    return eResult;
+}
+
+void SCG_CalcSealPlan(SCG_ClockPlanType *pPlan)
+{
+    SCG_CalcSysFreqType tSysFreq = {0U, 0U, 0U};
+
+    pPlan->u32Magic = SCG_PLAN_MAGIC;
+    pPlan->u16Version = (uint16_t)SCG_PLAN_VERSION;
+    (void)SCG_CalcCheckPlan(pPlan, &tSysFreq);
+    pPlan->u32CoreFreq = tSysFreq.u32CoreFreq;
+    pPlan->u32Crc = SCG_CalcCrc32((const uint8_t *)pPlan, (uint32_t)offsetof(SCG_ClockPlanType, u32Crc));
+}
+
+bool SCG_CalcIsPlanIntact(const SCG_ClockPlanType *pPlan)
+{
+    return ((pPlan->u32Magic == SCG_PLAN_MAGIC) && (pPlan->u16Version == (uint16_t)SCG_PLAN_VERSION) &&
+            ((pPlan->u16Flags & (uint16_t)~SCG_PLAN_FLAG_MASK) == 0U) &&
+            (pPlan->u32Crc == SCG_CalcCrc32((const uint8_t *)pPlan, (uint32_t)offsetof(SCG_ClockPlanType, u32Crc))));
+}
@@ -0,0 +1,205 @@
+/**
+ * @file fc4xxx_driver_scg_calc.h
+ * @author Flagchip
+ * @brief FC4xxx SCG clock tree arithmetic, limits and clock plan image format
+ * @version 0.1.0B
+ * @date 2023-09-07
+ *
+ * @copyright Copyright (c) 2020-2023 Flagchip Semiconductors Co., Ltd.
+ *
+ */
+
+/********************************************************************************
+*   Revision History:
+*
+*   Version     Date          Initials       CR#          Descriptions
+*   ---------   ----------    ------------   ----------   ---------------
+*   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
+********************************************************************************/
+#ifndef _DRIVER_FC4XXX_DRIVER_SCG_CALC_H_
+#define _DRIVER_FC4XXX_DRIVER_SCG_CALC_H_
+
+/*
+ * This module has no register access and no device header dependency, it is shared by
+ * fc4xxx_driver_scg.c and the host tools so both use the same frequency and limit logic.
+ * Divider, prediv and mult arguments are the raw register field encodings.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* ################################################################################## */
+/* ####################################### Macro #################################### */
+#define FIRC_CLOCK       96000000U
+#define PLL0_CLK_MAX 200000000U
+#define PLL0_CLK_MIN 75000000U
+#define SYS_CORE_CLK_MAX 150000000U
+#define SYS_BUS_CLK_MAX 75000000U
+#define SYS_SLOW_CLK_MAX 37500000U
+
+#define SCG_PLAN_MAGIC                  0x50474353U     /* "SCGP" */
+#define SCG_PLAN_VERSION                1U
+
+/* clock plan flags */
+#define SCG_PLAN_FLAG_FOSC_EN           0x0001U
+#define SCG_PLAN_FLAG_FOSC_BYPASS       0x0002U
+#define SCG_PLAN_FLAG_FOSC_STEN         0x0004U
+#define SCG_PLAN_FLAG_FOSC_CM           0x0008U
+#define SCG_PLAN_FLAG_FOSC_CMRE         0x0010U
+#define SCG_PLAN_FLAG_FOSC_LK           0x0020U
+#define SCG_PLAN_FLAG_PLL0_EN           0x0040U
+#define SCG_PLAN_FLAG_PLL0_STEN         0x0080U
+#define SCG_PLAN_FLAG_PLL0_CM           0x0100U
+#define SCG_PLAN_FLAG_PLL0_CMRE         0x0200U
+#define SCG_PLAN_FLAG_PLL0_LK           0x0400U
+#define SCG_PLAN_FLAG_SYSCLK_CME        0x0800U
+#define SCG_PLAN_FLAG_MASK              0x0FFFU
+
+/* ################################################################################## */
+/* ################################### Type define ################################## */
+
+/**
+ * @brief Clock source codes used by the clock plan, independent of the CCR[SCS] encoding
+ */
+typedef enum
+{
+    SCG_PLAN_SRC_FIRC = 0U,
+    SCG_PLAN_SRC_FOSC,
+    SCG_PLAN_SRC_PLL0
+} SCG_PlanSrcType;
+
+/**
+ * @brief Result of the clock tree checks
+ */
+typedef enum
+{
+    SCG_CALC_OK = 0U,                   /**< configuration is legal */
+    SCG_CALC_PARAM_INVALID,             /**< field encoding out of range */
+    SCG_CALC_SRC_DISABLED,              /**< selected source is not enabled by the plan */
+    SCG_CALC_PLL0_RANGE,                /**< PLL0 output out of PLL0_CLK_MIN..PLL0_CLK_MAX */
+    SCG_CALC_SYSCLK_RANGE               /**< CORE, BUS or SLOW clock above its maximum */
+} SCG_CalcResultType;
+
+/**
+ * @brief System clock frequencies
+ */
+typedef struct
+{
+    uint32_t u32CoreFreq;
+    uint32_t u32BusFreq;
+    uint32_t u32SlowFreq;
+} SCG_CalcSysFreqType;
+
+/**
+ * @brief Exact frequency u64Num / u32Den in Hz, kept reduced by SCG_CalcFreqScale
+ */
+typedef struct
+{
+    uint64_t u64Num;
+    uint32_t u32Den;
+} SCG_CalcFreqType;
+
+/**
+ * @brief Versioned clock plan image, stored in flash or NVM and applied by SCG_ApplyStoredPlan.
+ *        The layout has no padding, the image is little endian on host and target.
+ *        u32Crc is the CRC-32 (IEEE 802.3) of all preceding bytes.
+ */
+typedef struct
+{
+    uint32_t u32Magic;                  /**< SCG_PLAN_MAGIC */
+    uint16_t u16Version;                /**< SCG_PLAN_VERSION */
+    uint16_t u16Flags;                  /**< SCG_PLAN_FLAG_xxx */
+    uint32_t u32FoscFreq;               /**< FOSC crystal frequency in Hz, 0 if FOSC is not enabled */
+    uint32_t u32CoreFreq;               /**< resulting core clock, filled by the generator */
+    uint8_t u8Pll0Src;                  /**< SCG_PLAN_SRC_FIRC or SCG_PLAN_SRC_FOSC */
+    uint8_t u8Pll0Prediv;               /**< PLL0CFG[PREDIV] */
+    uint8_t u8Pll0Mult;                 /**< PLL0CFG[MULT] */
+    uint8_t u8SysSrc;                   /**< SCG_PlanSrcType of the system clock */
+    uint8_t au8FircDiv[3];              /**< FIRCDIV DIVH, DIVM, DIVL */
+    uint8_t u8DivCore;                  /**< CCR[DIVCORE] */
+    uint8_t au8FoscDiv[3];              /**< FOSCDIV DIVH, DIVM, DIVL */
+    uint8_t u8DivBus;                   /**< CCR[DIVBUS] */
+    uint8_t au8Pll0Div[3];              /**< PLL0DIV DIVH, DIVM, DIVL */
+    uint8_t u8DivSlow;                  /**< CCR[DIVSLOW] */
+    uint32_t u32Crc;                    /**< CRC-32 of the bytes above */
+} SCG_ClockPlanType;
+
+/* ################################################################################## */
+/* ################################ Global Functions ################################ */
+
+/**
+ * @brief PLL0 output frequency checked against the PLL0 limits, FIRC input is divided by 2 in front of
+ *        the PLL0. Multiplies before dividing like SCG_CalcPll0NodeFreq, so both are floors of exact values.
+ * @param u32SrcFreq: FIRC or FOSC frequency
+ * @param bFircSrc: true for FIRC source
+ * @param u32Prediv: PLL0CFG[PREDIV]
+ * @param u32Mult: PLL0CFG[MULT]
+ * @return PLL0 frequency in Hz
+ */
+uint32_t SCG_CalcPll0Freq(uint32_t u32SrcFreq, bool bFircSrc, uint32_t u32Prediv, uint32_t u32Mult);
+
+/**
+ * @brief PLL0 node frequency as reported by SCG_SetPll0ClockStatus, src * (mult + 16) / (2 * (prediv + 1))
+ *        for both sources. SCG_SetClkCtrl checks CORE/BUS/SLOW against this value, not against the
+ *        SCG_CalcPll0Freq range check value.
+ * @return floor of the exact frequency in Hz
+ */
+uint32_t SCG_CalcPll0NodeFreq(uint32_t u32SrcFreq, uint32_t u32Prediv, uint32_t u32Mult);
+
+/**
+ * @brief Check the PLL0 output against PLL0_CLK_MIN/PLL0_CLK_MAX.
+ *        The FOSC path excludes both limits, the FIRC path includes them.
+ */
+bool SCG_CalcPll0InRange(uint32_t u32Pll0Freq, bool bFircSrc);
+
+/**
+ * @brief Compute CORE/BUS/SLOW from the system clock source and check their maximums.
+ * @param pSysFreq: filled with the resulting frequencies, may be NULL
+ * @return true if all three clocks are within limits
+ */
+bool SCG_CalcSysClk(uint32_t u32SrcFreq, uint32_t u32DivCore, uint32_t u32DivBus, uint32_t u32DivSlow,
+                    SCG_CalcSysFreqType *pSysFreq);
+
+/**
+ * @brief Output frequency of an async divider, 0 when the divider is disabled.
+ * @param u32Div: DIVH/DIVM/DIVL field, 0 disables, n divides by 2^(n-1)
+ */
+uint32_t SCG_CalcAsyncDivFreq(uint32_t u32SrcFreq, uint32_t u32Div);
+
+/**
+ * @brief Multiply an exact frequency by u32Mul / u32Div without rounding, the result stays reduced.
+ * @param u32Div: must not be 0
+ */
+void SCG_CalcFreqScale(SCG_CalcFreqType *pFreq, uint32_t u32Mul, uint32_t u32Div);
+
+/**
+ * @brief Exact frequency in milli-Hz, rounded to nearest.
+ */
+uint64_t SCG_CalcFreqMilliHz(const SCG_CalcFreqType *pFreq);
+
+/**
+ * @brief CRC-32 (IEEE 802.3, reflected, init and final xor 0xFFFFFFFF).
+ */
+uint32_t SCG_CalcCrc32(const uint8_t *pData, uint32_t u32Len);
+
+/**
+ * @brief FNV-1a style hash of a word array, one xor and multiply per word, for cheap change detection.
+ */
+uint32_t SCG_CalcHashWords(const uint32_t *pWord, uint32_t u32Count);
+
+/**
+ * @brief Validate a clock plan with the same checks as the driver setters.
+ * @param pSysFreq: filled with the resulting system clocks on success, may be NULL
+ */
+SCG_CalcResultType SCG_CalcCheckPlan(const SCG_ClockPlanType *pPlan, SCG_CalcSysFreqType *pSysFreq);
+
+/**
+ * @brief Fill magic, version, u32CoreFreq and the CRC of a validated plan.
+ */
+void SCG_CalcSealPlan(SCG_ClockPlanType *pPlan);
+
+/**
+ * @brief Check magic, version, reserved flags and CRC of a stored plan.
+ */
+bool SCG_CalcIsPlanIntact(const SCG_ClockPlanType *pPlan);
+
+#endif
@@ -0,0 +1,166 @@
+/**
+ * @file fc4xxx_driver_scg_early.c
+ * @author Flagchip
+ * @brief FC4xxx SCG clock bring-up from the reset handler, before .data and .bss are initialised
+ * @version 0.1.0B
+ * @date 2023-09-07
+ *
+ * @copyright Copyright (c) 2020-2023 Flagchip Semiconductors Co., Ltd.
+ *
+ */
+
+/********************************************************************************
+*   Revision History:
+*
+*   Version     Date          Initials       CR#          Descriptions
+*   ---------   ----------    ------------   ----------   ---------------
+*   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
+********************************************************************************/
+/*
+ * This file only uses the stack, the clock plan and const data, so it runs before the startup
+ * code copies .data and zeroes .bss. It is kept apart from fc4xxx_driver_scg.c on purpose: the
+ * register write trace and the SCG_RAMFUNC routines of the driver live in RAM sections that are
+ * not initialised yet. The register sequences come from fc4xxx_driver_scg_seq.h, included here
+ * without the trace wrappers and SCG_SEQ_FUNC placement of the driver, so they are compiled
+ * inline into this file. SCG_EarlyBootHandoff builds the driver state afterwards.
+ */
+#include "fc4xxx_driver_scg.h"
+#include "fc4xxx_driver_scg_ext.h"
+#include "fc4xxx_driver_scg_seq.h"
+
+/* ################################################################################## */
+/* ####################################### Macro #################################### */
+#define SCG_EARLY_FOSC_TIMEOUT      320500U
+#define SCG_EARLY_PLL0_TIMEOUT      320500U
+#define SCG_EARLY_CCR_TIMEOUT       1000U
+
+/* ################################################################################## */
+/* ################################ Local Variables ################################# */
+
+/* FOSCCFG tuning of the early bring-up, SCG_SetFoscTuning is not available before the C runtime */
+static const SCG_FoscTuneType s_tEarlyFoscTune = SCG_FOSC_TUNE_DEFAULT;
+
+/* ################################################################################## */
+/* ################################ Local Functions  ################################ */
+
+static SCG_StatusType SCG_EarlyStartFosc(const SCG_ClockPlanType *pPlan)
+{
+    SCG_StatusType eStatus = SCG_CLOCK_VALID;
+    uint32_t u32Temp;
+
+    SCG_SeqStartPlanFosc(pPlan, SCG_SeqFoscCfgValue((pPlan->u16Flags & SCG_PLAN_FLAG_FOSC_BYPASS) != 0U,
+                                                    &s_tEarlyFoscTune));
+
+    u32Temp = SCG_EARLY_FOSC_TIMEOUT;
+    while ((SCG_HWA_GetFoscValid() == false) && (u32Temp > 0U))
+    {
+        u32Temp--;
+    }
+
+    if (u32Temp == 0U)
+    {
+        eStatus = SCG_CLOCK_TIMEOUT;
+    }
+    else
+    {
+        SCG_SeqFinishPlanFosc(pPlan);
+    }
+
+    return eStatus;
+}
+
+static SCG_StatusType SCG_EarlyStartPll0(const SCG_ClockPlanType *pPlan)
+{
+    SCG_StatusType eStatus = SCG_CLOCK_VALID;
+    uint32_t u32Temp;
+
+    SCG_SeqStartPlanPll0(pPlan);
+
+    u32Temp = SCG_EARLY_PLL0_TIMEOUT;
+    while ((SCG_HWA_GetPll0Locked() == false) && (u32Temp > 0U))
+    {
+        u32Temp--;
+    }
+
+    if (u32Temp == 0U)
+    {
+        eStatus = SCG_CLOCK_TIMEOUT;
+    }
+    else
+    {
+        SCG_SeqFinishPlanPll0(pPlan);
+    }
+
+    return eStatus;
+}
+
+/* ################################################################################## */
+/* ################################ Global Functions ################################ */
+
+/**
+ * @brief Bring up the clocks of a stored clock plan from the reset handler, before .data and .bss
+ *        are initialised, so the C runtime initialisation already runs on the final core clock.
+ *        FIRC dividers, FOSC, PLL0 and CCR are programmed like SCG_ApplyStoredPlan, with the
+ *        default FOSC tuning and the fixed oscillator timeouts; nothing is recorded in the startup
+ *        history. Call SCG_EarlyBootHandoff with the same plan once the C runtime is ready.
+ * @param pPlan: pointer to the plan image in flash
+ * @return SCG_CLOCK_VALID on success, SCG_CLOCK_PARAM_INVALID for a corrupted or foreign image,
+ *         SCG_CLOCK_SEQUENCE_ERROR if the core is not on FIRC,
+ *         SCG_CLOCK_TIMEOUT or SCG_CLOCK_ERROR if a source or the CCR switch failed.
+ */
+SCG_StatusType SCG_EarlyBoot(const SCG_ClockPlanType *pPlan)
+{
+    SCG_StatusType eStatus = SCG_CLOCK_VALID;
+    uint32_t u32Temp;
+    uint8_t u8Scs;
+
+    if ((SCG_CalcIsPlanIntact(pPlan) == false) || (pPlan->u8SysSrc > (uint8_t)SCG_PLAN_SRC_PLL0))
+    {
+        eStatus = SCG_CLOCK_PARAM_INVALID;
+    }
+    /* the plan reprograms FOSC and PLL0, so the core must still run from the reset FIRC */
+    else if (SCG_HWA_GetSysClkSrc() != (uint8_t)SCG_CLOCK_SRC_FIRC)
+    {
+        eStatus = SCG_CLOCK_SEQUENCE_ERROR;
+    }
+    else
+    {
+        SCG_SeqWriteDivs(SCG_SEQ_DIV_FIRC, pPlan->au8FircDiv);
+
+        if ((pPlan->u16Flags & SCG_PLAN_FLAG_FOSC_EN) != 0U)
+        {
+            eStatus = SCG_EarlyStartFosc(pPlan);
+        }
+
+        if ((eStatus == SCG_CLOCK_VALID) && ((pPlan->u16Flags & SCG_PLAN_FLAG_PLL0_EN) != 0U))
+        {
+            eStatus = SCG_EarlyStartPll0(pPlan);
+        }
+
+        if (eStatus == SCG_CLOCK_VALID)
+        {
+            u8Scs = (uint8_t)s_eSeqPlanSysSrc[pPlan->u8SysSrc];
+            SCG_HWA_SetCCR(SCG_SeqPlanCcr(pPlan));
+
+            u32Temp = SCG_EARLY_CCR_TIMEOUT;
+            while ((SCG_HWA_GetSysClkUPRD() == false) && (u32Temp > 0U))
+            {
+                u32Temp--;
+            }
+
+            if (u32Temp == 0U)
+            {
+                eStatus = SCG_CLOCK_TIMEOUT;
+            }
+            else if (SCG_HWA_GetSysClkSrc() != u8Scs)
+            {
+                eStatus = SCG_CLOCK_ERROR;
+            }
+            else
+            {
+            }
+        }
+    }
+
+    return eStatus;
+}
@@ -0,0 +1,584 @@
+/**
+ * @file fc4xxx_driver_scg_ext.h
+ * @author Flagchip
+ * @brief FC4xxx SCG driver extended type definition and API
+ * @version 0.1.0B
+ * @date 2023-09-07
+ *
+ * @copyright Copyright (c) 2020-2023 Flagchip Semiconductors Co., Ltd.
+ *
+ */
+
+/********************************************************************************
+*   Revision History:
+*
+*   Version     Date          Initials       CR#          Descriptions
+*   ---------   ----------    ------------   ----------   ---------------
+*   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
+********************************************************************************/
+#ifndef _DRIVER_FC4XXX_DRIVER_SCG_EXT_H_
+#define _DRIVER_FC4XXX_DRIVER_SCG_EXT_H_
+
+#include "fc4xxx_driver_scg.h"
+#include "fc4xxx_driver_scg_calc.h"
+#include "fc4xxx_driver_scg_trace.h"
+
+/* ################################################################################## */
+/* ####################################### Macro #################################### */
+
+/**
+ * @brief Free running cycle counter used for latency measurement.
+ *        The DWT cycle counter must be enabled by the application, define this macro before
+ *        including the header to use another time base. While it does not run, the startup
+ *        deadlines are not learned and stay at the fixed timeouts.
+ */
+#ifndef SCG_GET_CYCLES
+#define SCG_GET_CYCLES()    (DWT->CYCCNT)
+#endif
+
+/**
+ * @brief SCG_GET_CYCLES() ticks of one iteration of a blocking wait loop. The async jobs take their
+ *        deadlines from the fixed loop timeouts scaled by this value, so they time out after the same
+ *        time whatever the rate SCG_PollAsync is called at.
+ */
+#ifndef SCG_WAIT_LOOP_CYCLES
+#define SCG_WAIT_LOOP_CYCLES    8U
+#endif
+
+/**
+ * @brief Placement of the startup history, the linker script must map the section to RAM
+ *        that is not cleared or initialised by the startup code.
+ */
+#ifndef SCG_RETAINED_ATTR
+#define SCG_RETAINED_ATTR   __attribute__((section(".scg_noinit")))
+#endif
+
+/**
+ * @brief Placement of the clock switching routines (CCR write and UPRD wait, PLL0CFG write,
+ *        async divider EN/ACK sequence). Define SCG_RAMFUNC_ENABLE to put them in .scg_ramfunc,
+ *        the linker script must then load the section to RAM or TCM and the startup code copy it.
+ *        The SCG_HWA_xxx accessors are inline and only end up in the section with optimisation on,
+ *        with SCG_TRACE_ENABLE the trace recorder is placed in the section as well.
+ */
+#ifndef SCG_RAMFUNC
+#ifdef SCG_RAMFUNC_ENABLE
+#define SCG_RAMFUNC         __attribute__((section(".scg_ramfunc"), noinline))
+#else
+#define SCG_RAMFUNC
+#endif
+#endif
+
+/**
+ * @brief Compiler specific parts of the SCG_TRACE_ENABLE recorder, which stores the return address
+ *        of its caller and therefore must not be inlined. Compilers without a return address
+ *        intrinsic record 0 as caller.
+ */
+#ifndef SCG_NOINLINE
+#if defined(__ICCARM__)
+#define SCG_NOINLINE            _Pragma("inline=never")
+#else
+#define SCG_NOINLINE            __attribute__((noinline))
+#endif
+#endif
+
+#ifndef SCG_RETURN_ADDRESS
+#if defined(__CC_ARM)
+#define SCG_RETURN_ADDRESS()    ((uint32_t)__return_address())
+#elif defined(__GNUC__)
+#define SCG_RETURN_ADDRESS()    ((uint32_t)(uintptr_t)__builtin_return_address(0))
+#else
+#define SCG_RETURN_ADDRESS()    0U
+#endif
+#endif
+
+/**
+ * @brief Async divider EN/ACK handshake, selected by part at compile time.
+ *        MCU_FC4150_2M acknowledges every DIVH/DIVM/DIVL enable change and the driver waits for it,
+ *        MCU_FC4150_512K has no ACK and the divider update is done without polling.
+ *        Parts other than MCU_FC4150_512K keep the handshake.
+ */
+#ifndef SCG_DIV_ACK_HANDSHAKE
+#if defined(MCU_FC4150_512K)
+#define SCG_DIV_ACK_HANDSHAKE   0
+#else
+#define SCG_DIV_ACK_HANDSHAKE   1
+#endif
+#endif
+
+/**
+ * @brief Time base of the clock monitor event timestamps, SCG_GET_CYCLES() by default.
+ *        Define it to a slower free running counter (e.g. a millisecond tick) when events minutes
+ *        apart must be compared, the cycle counter wraps after a few tens of seconds.
+ */
+#ifndef SCG_MONITOR_TIMESTAMP
+#define SCG_MONITOR_TIMESTAMP()     SCG_GET_CYCLES()
+#endif
+
+/**
+ * @brief Time base of the clock residency accounting, SCG_GET_CYCLES() by default.
+ *        The cycle counter runs at the core clock and stops in WFI, so the default only gives the
+ *        time of each run profile in its own core cycles. Define it to a free running counter of
+ *        fixed rate to compare profiles, account idle time and sum the oscillator residency.
+ */
+#ifndef SCG_RESIDENCY_TIMESTAMP
+#define SCG_RESIDENCY_TIMESTAMP()   SCG_GET_CYCLES()
+#endif
+
+/**
+ * @brief Number of run profiles tracked by the residency accounting
+ */
+#ifndef SCG_RESIDENCY_PROFILES
+#define SCG_RESIDENCY_PROFILES      8U
+#endif
+
+/**
+ * @brief Oscillators of the residency accounting: FIRC, SIRC, SIRC32K, FOSC, SOSC, PLL0
+ */
+#define SCG_RESIDENCY_OSC_NUM       6U
+
+/**
+ * @brief Upper limit of SCG_RampCfgType dwells in busy loops. The ramp runs with interrupts masked and
+ *        makes at most 9 CCR writes with 8 dwells between them, so the masked time stays below
+ *        9 UPRD waits plus 8 * SCG_RAMP_DWELL_MAX loops.
+ */
+#ifndef SCG_RAMP_DWELL_MAX
+#define SCG_RAMP_DWELL_MAX          2000U
+#endif
+
+/**
+ * @brief Dispatch order of the clock error notifications in SCG_IRQHandler, highest priority first.
+ *        Comma separated list without braces that must name SCG_PLL0_CLK, SCG_FOSC_CLK, SCG_SOSC_CLK,
+ *        SCG_FIRC_CLK and SCG_SIRC_CLK once each, checked at compile time.
+ */
+#ifndef SCG_CLOCK_ERROR_PRIORITY
+#define SCG_CLOCK_ERROR_PRIORITY    SCG_PLL0_CLK, SCG_FOSC_CLK, SCG_SOSC_CLK, SCG_FIRC_CLK, SCG_SIRC_CLK
+#endif
+
+/**
+ * @brief Oscillator tuning applied by SCG_SetFOSC/SCG_SetSOSC when no tuning was set
+ *        FOSC: EOCV 50, GM_SEL 15, ALC_D 1, HYST_D 0
+ *        SOSC: EOCV 64, GM_SEL 3, CURPRG_SF 3, CURPRG_COMP 3
+ */
+#define SCG_FOSC_TUNE_DEFAULT       {50U, 15U, 1U, 0U}
+#define SCG_SOSC_TUNE_DEFAULT       {64U, 3U, 3U, 3U}
+
+/**
+ * @brief Number of retained startup samples per source
+ */
+#define SCG_STARTUP_HISTORY_LEN     8U
+
+/**
+ * @brief Violations reported by SCG_EvaluateClockTree
+ */
+#define SCG_WHATIF_PARAM_INVALID            0x01U   /**< oscillator enabled with a zero frequency */
+#define SCG_WHATIF_PLL0_SRC_DISABLED        0x02U   /**< PLL0 reference is not valid */
+#define SCG_WHATIF_PLL0_RANGE               0x04U   /**< PLL0 output out of range */
+#define SCG_WHATIF_SYSCLK_SRC_DISABLED      0x08U   /**< system clock source is not valid */
+#define SCG_WHATIF_SYSCLK_RANGE             0x10U   /**< CORE, BUS or SLOW above its maximum */
+
+/* ################################################################################## */
+/* ################################### Type define ################################## */
+
+/**
+ * @brief Async divider output selection of FIRC, SIRC, FOSC and PLL0
+ */
+typedef enum
+{
+    SCG_ASYNCDIV_H = 0U,                /**< DIVH output */
+    SCG_ASYNCDIV_M,                     /**< DIVM output */
+    SCG_ASYNCDIV_L                      /**< DIVL output */
+} SCG_AsyncDivSelType;
+
+/**
+ * @brief Tick timer rescale callback, called with interrupts masked right after a core clock change
+ */
+typedef void (*SCG_TimebaseRescaleCallBackType)(uint32_t u32OldCoreFreq, uint32_t u32NewCoreFreq);
+
+/**
+ * @brief Async job completion callback, called from SCG_PollAsync with interrupts enabled
+ */
+typedef void (*SCG_AsyncDoneCallBackType)(SCG_StatusType eStatus, void *pContext);
+
+/**
+ * @brief SCG_Audit notification, pOld is the clock tree before and pNew after the rebuild
+ */
+typedef void (*SCG_AuditNotifyCallBackType)(const SCG_ClockSequenceType *pOld, const SCG_ClockSequenceType *pNew);
+
+/**
+ * @brief Startup degradation warning, u32Observed and u32Baseline are SCG_GET_CYCLES() ticks,
+ *        u32Observed is the deadline when the source timed out
+ */
+typedef void (*SCG_StartupDegradeCallBackType)(SCG_ClkSrcType eSrc, uint32_t u32Observed, uint32_t u32Baseline);
+
+/**
+ * @brief Retained startup statistics of FOSC, SOSC or PLL0, times are in SCG_GET_CYCLES() ticks
+ */
+typedef struct
+{
+    uint32_t u32Samples;                /**< number of samples in the history */
+    uint32_t u32Last;                   /**< last observed startup */
+    uint32_t u32Max;                    /**< slowest startup in the history */
+    uint32_t u32Mean;                   /**< mean startup of the history */
+    uint32_t u32Deadline;               /**< deadline used by the next startup */
+    bool bDegraded;                     /**< a degradation warning was raised since the history was cleared */
+} SCG_StartupStatsType;
+
+/**
+ * @brief FOSC oscillator tuning, FOSCCFG field values
+ */
+typedef struct
+{
+    uint8_t u8Eocv;                     /**< EOCV, oscillator startup count */
+    uint8_t u8GmSel;                    /**< GM_SEL, amplifier transconductance */
+    uint8_t u8AlcD;                     /**< ALC_D, 1 disables the amplitude level control */
+    uint8_t u8HystD;                    /**< HYST_D, 1 disables the comparator hysteresis */
+} SCG_FoscTuneType;
+
+/**
+ * @brief SOSC oscillator tuning, SOSCCFG field values
+ */
+typedef struct
+{
+    uint8_t u8Eocv;                     /**< EOCV, oscillator startup count */
+    uint8_t u8GmSel;                    /**< GM_SEL, amplifier transconductance */
+    uint8_t u8CurprgSf;                 /**< CURPRG_SF, startup current */
+    uint8_t u8CurprgComp;               /**< CURPRG_COMP, comparator current */
+} SCG_SoscTuneType;
+
+/**
+ * @brief Result of one oscillator tuning candidate
+ */
+typedef struct
+{
+    uint32_t u32Cycles;                 /**< SCG_GET_CYCLES() ticks from enable to valid or timeout */
+    SCG_StatusType eStatus;             /**< SCG_CLOCK_VALID or SCG_CLOCK_TIMEOUT */
+} SCG_OscSweepResultType;
+
+/**
+ * @brief Timebase configuration
+ */
+typedef struct
+{
+    uint32_t u32TickRateHz;                             /**< SysTick rate kept across core clock changes */
+    SCG_TimebaseRescaleCallBackType pTimebaseRescale;   /**< user tick timer hook, NULL to rescale SysTick */
+} SCG_TimebaseType;
+
+/**
+ * @brief Core clock ramp configuration, dwell times are busy wait loops
+ */
+typedef struct
+{
+    bool bEnable;                       /**< step DIVCORE instead of switching in one write */
+    uint32_t u32UpDwell;                /**< loops after a step that raises the core clock, SCG_RAMP_DWELL_MAX at most */
+    uint32_t u32DownDwell;              /**< loops after a step that lowers the core clock, SCG_RAMP_DWELL_MAX at most */
+} SCG_RampCfgType;
+
+/**
+ * @brief Proposed configurations evaluated by SCG_EvaluateClockTree, NULL members keep the current nodes
+ */
+typedef struct
+{
+    const SCG_FircType *pFirc;
+    const SCG_SircType *pSirc;
+    const SCG_FoscType *pFosc;
+    const SCG_SoscType *pSosc;
+    const SCG_Pll0Type *pPll0;
+    const SCG_ClockCtrlType *pClkCtrl;  /**< system clock and CLKOUT selection */
+} SCG_ClockProposalType;
+
+/**
+ * @brief Idle governor configuration
+ */
+typedef struct
+{
+    SCG_ClockCtrlType tIdleClkCtrl;     /**< core clock used while idle, eSrc must be SCG_CLOCK_SRC_FIRC */
+    bool bPll0Sten;                     /**< keep PLL0 running in stop mode */
+    bool bFoscSten;                     /**< keep FOSC running in stop mode */
+} SCG_IdleCfgType;
+
+/**
+ * @brief Idle governor statistics, latencies are in SCG_GET_CYCLES() ticks
+ */
+typedef struct
+{
+    uint32_t u32IdleCount;              /**< number of completed idle periods */
+    uint32_t u32LastWakeLatency;        /**< wake to full speed latency of the last idle period */
+    uint32_t u32MaxWakeLatency;         /**< worst wake to full speed latency observed */
+} SCG_IdleStatsType;
+
+/**
+ * @brief Residency of one run profile, a profile is a run clock with its core, bus and slow dividers
+ */
+typedef struct
+{
+    SCG_RunClockType eRunClock;         /**< system clock path */
+    uint8_t u8DivCore;                  /**< CCR DIVCORE */
+    uint8_t u8DivBus;                   /**< CCR DIVBUS */
+    uint8_t u8DivSlow;                  /**< CCR DIVSLOW */
+    uint32_t u32CoreFreq;               /**< core clock frequency of the profile */
+    uint32_t u32Entries;                /**< number of times the profile was entered */
+    uint64_t u64Time;                   /**< time spent in the profile, SCG_RESIDENCY_TIMESTAMP() ticks */
+} SCG_ResidencyProfileType;
+
+/**
+ * @brief Clock residency statistics, times are SCG_RESIDENCY_TIMESTAMP() ticks and switch
+ *        latencies SCG_GET_CYCLES() ticks from the CCR write to UPRD
+ */
+typedef struct
+{
+    uint64_t u64Elapsed;                /**< time since the statistics were cleared */
+    uint64_t u64UnlistedTime;           /**< time in profiles that did not fit in tProfile */
+    uint64_t au64OscTime[SCG_RESIDENCY_OSC_NUM];    /**< time each oscillator was enabled */
+    uint32_t au32OscEnables[SCG_RESIDENCY_OSC_NUM]; /**< number of times each oscillator was enabled */
+    uint32_t u32Transitions;            /**< run profile changes */
+    uint32_t u32LastSwitchCycles;       /**< CCR switch time of the last transition */
+    uint32_t u32MaxSwitchCycles;        /**< worst CCR switch time of a transition */
+    uint64_t u64TotalSwitchCycles;      /**< CCR switch time of all transitions */
+    uint32_t u32Current;                /**< index of the current profile, SCG_RESIDENCY_PROFILES if unlisted */
+    uint32_t u32ProfileNum;             /**< used entries of tProfile */
+    SCG_ResidencyProfileType tProfile[SCG_RESIDENCY_PROFILES];
+} SCG_ResidencyStatsType;
+
+/**
+ * @brief Clock monitor event statistics of one source, times are SCG_MONITOR_TIMESTAMP() values
+ */
+typedef struct
+{
+    uint32_t u32Count;                  /**< clock monitor events since the statistics were cleared */
+    uint32_t u32FirstTime;              /**< time of the first event */
+    uint32_t u32LastTime;               /**< time of the last event */
+    uint32_t u32MinInterval;            /**< shortest time between two events, 0xFFFFFFFF below 2 events */
+} SCG_ClockMonitorStatsType;
+
+/* ################################################################################## */
+/* ################################ Global Functions ################################ */
+
+/**
+ * @brief Reprogram a single async divider, the other two dividers of the source keep running.
+ * @param eSrc: SCG_FIRC_CLK, SCG_SIRC_CLK, SCG_FOSC_CLK or SCG_PLL0_CLK
+ * @param eWhich: divider output to change
+ * @param eDiv: new divider value
+ * @return SCG_CLOCK_VALID on success
+ */
+SCG_StatusType SCG_SetAsyncDivider(SCG_ClkSrcType eSrc, SCG_AsyncDivSelType eWhich, SCG_AsyncClockDivType eDiv);
+
+/**
+ * @brief Register the tick timer rescaled on every core clock change.
+ * @param pTimebase: pointer to the timebase configuration, NULL disables the rescaling
+ */
+void SCG_SetTimebase(const SCG_TimebaseType *pTimebase);
+
+/**
+ * @brief Precompute the idle clock register images and set the configured STEN bits.
+ * @param pIdleCfg: pointer to the idle governor configuration
+ * @return SCG_CLOCK_VALID when the idle clock is usable
+ */
+SCG_StatusType SCG_IdlePrepare(const SCG_IdleCfgType *pIdleCfg);
+
+/**
+ * @brief Drop to the idle clock, execute WFI and restore the run clock on wake.
+ * @return status of the run clock restore
+ */
+SCG_StatusType SCG_IdleEnter(void);
+
+/**
+ * @brief Restore the run clock saved by SCG_IdleEnter, no-op when the governor is not idle.
+ * @return status of the run clock restore
+ */
+SCG_StatusType SCG_IdleExit(void);
+
+/**
+ * @brief Get the idle governor statistics.
+ * @param pIdleStats: pointer to the statistics to fill
+ */
+void SCG_GetIdleStats(SCG_IdleStatsType *pIdleStats);
+
+/**
+ * @brief Clear the clock residency statistics and start the accounting from the current clocks.
+ */
+void SCG_ClearResidencyStats(void);
+
+/**
+ * @brief Get a snapshot of the clock residency statistics, the time up to the call is included.
+ *        Must be called at least once per wrap period of SCG_RESIDENCY_TIMESTAMP().
+ * @param pStats: pointer to the statistics to fill
+ * @return SCG_CLOCK_SEQUENCE_ERROR if SCG_ClearResidencyStats was never called
+ */
+SCG_StatusType SCG_GetResidencyStats(SCG_ResidencyStatsType *pStats);
+
+/**
+ * @brief Start an SOSC configuration, the result is reported through pDone.
+ * @return false if another async job is pending
+ */
+bool SCG_SetSOSCAsync(const SCG_SoscType *pSoscConfig, SCG_AsyncDoneCallBackType pDone, void *pContext);
+
+/**
+ * @brief Start an FOSC configuration, the result is reported through pDone.
+ * @return false if another async job is pending
+ */
+bool SCG_SetFOSCAsync(const SCG_FoscType *pFoscConfig, SCG_AsyncDoneCallBackType pDone, void *pContext);
+
+/**
+ * @brief Start a PLL0 configuration, the result is reported through pDone.
+ * @return false if another async job is pending
+ */
+bool SCG_SetPLL0Async(const SCG_Pll0Type *pPll0Config, SCG_AsyncDoneCallBackType pDone, void *pContext);
+
+/**
+ * @brief Switch the system clock, the result is reported through pDone.
+ * @return false if another async job is pending
+ */
+bool SCG_SetClkCtrlAsync(const SCG_ClockCtrlType *pSysClkConfig, SCG_AsyncDoneCallBackType pDone, void *pContext);
+
+/**
+ * @brief Advance the pending async job, call periodically from the scheduler.
+ * @return true while a job is pending
+ */
+bool SCG_PollAsync(void);
+
+/**
+ * @brief Apply a CRC protected clock plan image, see fc4xxx_driver_scg_calc.h for the format.
+ * @param pPlan: pointer to the plan image in flash or NVM
+ * @return SCG_CLOCK_VALID on success, SCG_CLOCK_PARAM_INVALID if the image is not intact
+ */
+SCG_StatusType SCG_ApplyStoredPlan(const SCG_ClockPlanType *pPlan);
+
+/**
+ * @brief Bring up the clocks of a stored plan from the reset handler, before .data and .bss are
+ *        initialised. Uses only the stack, the plan and const data (fc4xxx_driver_scg_early.c).
+ * @param pPlan: pointer to the plan image in flash
+ * @return SCG_CLOCK_VALID on success, SCG_CLOCK_PARAM_INVALID if the image is not intact,
+ *         SCG_CLOCK_SEQUENCE_ERROR if the core is not on FIRC
+ */
+SCG_StatusType SCG_EarlyBoot(const SCG_ClockPlanType *pPlan);
+
+/**
+ * @brief Build the driver clock tree after SCG_EarlyBoot, once the C runtime is initialised.
+ * @param pPlan: plan passed to SCG_EarlyBoot, NULL if the early bring-up was skipped
+ * @return SCG_CLOCK_VALID if the system clock runs from the source of the plan
+ */
+SCG_StatusType SCG_EarlyBootHandoff(const SCG_ClockPlanType *pPlan);
+
+/**
+ * @brief Register the startup degradation warning callback, NULL disables it.
+ */
+void SCG_SetStartupDegradeNotify(SCG_StartupDegradeCallBackType pNotify);
+
+/**
+ * @brief Get the retained startup statistics of SCG_FOSC_CLK, SCG_SOSC_CLK or SCG_PLL0_CLK.
+ * @return SCG_CLOCK_VALID, SCG_CLOCK_PARAM_INVALID for another source
+ */
+SCG_StatusType SCG_GetStartupStats(SCG_ClkSrcType eSrc, SCG_StartupStatsType *pStats);
+
+/**
+ * @brief Clear the retained startup history. A source that timed out keeps its learned deadline
+ *        until this is called, call it to give a slow oscillator the fixed timeout again.
+ */
+void SCG_ClearStartupHistory(void);
+
+/**
+ * @brief Set the FOSC tuning used by the next FOSC enable, NULL restores the default.
+ */
+void SCG_SetFoscTuning(const SCG_FoscTuneType *pTune);
+
+/**
+ * @brief Set the SOSC tuning used by the next SOSC enable, NULL restores the default.
+ */
+void SCG_SetSoscTuning(const SCG_SoscTuneType *pTune);
+
+/**
+ * @brief Measure the FOSC time to valid of each tuning candidate, then apply pFoscConfig.
+ * @return status of the final SCG_SetFOSC
+ */
+SCG_StatusType SCG_SweepFoscTuning(SCG_FoscType *pFoscConfig, const SCG_FoscTuneType *pTune,
+                                   SCG_OscSweepResultType *pResult, uint32_t u32Count);
+
+/**
+ * @brief Measure the SOSC time to valid of each tuning candidate, then apply pSoscConfig.
+ * @return status of the final SCG_SetSOSC
+ */
+SCG_StatusType SCG_SweepSoscTuning(SCG_SoscType *pSoscConfig, const SCG_SoscTuneType *pTune,
+                                   SCG_OscSweepResultType *pResult, uint32_t u32Count);
+
+/**
+ * @brief Configure the core clock ramp of SCG_SetClkCtrl, NULL disables it.
+ *        The dwells are capped at SCG_RAMP_DWELL_MAX, the ramp runs with interrupts masked.
+ */
+void SCG_SetRampCfg(const SCG_RampCfgType *pRamp);
+
+/**
+ * @brief Copy the clock tree maintained by the driver.
+ */
+void SCG_GetClockTree(SCG_ClockSequenceType *pTree);
+
+/**
+ * @brief Predict the clock tree resulting from a proposal, without register access.
+ * @param pCurrent: current tree, from SCG_GetClockTree or an earlier prediction
+ * @param pProposal: configurations to evaluate
+ * @param pResult: predicted tree, may alias pCurrent
+ * @return SCG_WHATIF_xxx violations, 0 if the setters would accept the proposal
+ */
+uint32_t SCG_EvaluateClockTree(const SCG_ClockSequenceType *pCurrent, const SCG_ClockProposalType *pProposal,
+                               SCG_ClockSequenceType *pResult);
+
+#ifdef SCG_TRACE_ENABLE
+/**
+ * @brief Copy the most recent SCG register write trace entries, oldest first.
+ * @return number of entries copied
+ */
+uint32_t SCG_TraceDump(SCG_TraceEntryType *pEntry, uint32_t u32Max);
+
+/**
+ * @brief Discard the recorded SCG register write trace.
+ */
+void SCG_TraceReset(void);
+#endif
+
+/**
+ * @brief Get the clock monitor event statistics of a source.
+ * @param eSrc: SCG_SIRC_CLK, SCG_SOSC_CLK, SCG_FOSC_CLK, SCG_PLL0_CLK or SCG_FIRC_CLK
+ * @param pStats: statistics output
+ * @return SCG_CLOCK_VALID on success, SCG_CLOCK_PARAM_INVALID for a source without clock monitor
+ */
+SCG_StatusType SCG_GetClockMonitorStats(SCG_ClkSrcType eSrc, SCG_ClockMonitorStatsType *pStats);
+
+/**
+ * @brief Clear the clock monitor event statistics of all sources.
+ */
+void SCG_ClearClockMonitorStats(void);
+
+/**
+ * @brief Register the callback of SCG_Audit.
+ * @param pNotify: called when the audit found the clock tree changed, NULL to disable
+ */
+void SCG_SetAuditNotify(SCG_AuditNotifyCallBackType pNotify);
+
+/**
+ * @brief Check the clock tree against the SCG registers, rebuild it and notify on mismatch.
+ * @return true if the clock tree differed from the hardware
+ */
+bool SCG_Audit(void);
+
+/**
+ * @brief Report the exact frequency of a clock node as the reduced fraction u64Num / u32Den Hz.
+ *        SCG_CalcFreqMilliHz converts it to milli-Hz.
+ * @param eScgClockName: the clock node to query
+ * @param pFreq: exact frequency, 0 / 1 unless the node is valid
+ * @return the same status as SCG_GetScgClockFreq
+ */
+SCG_StatusType SCG_GetScgClockFreqExact(SCG_ClkSrcType eScgClockName, SCG_CalcFreqType *pFreq);
+
+/**
+ * @brief Switch the NVM clock to FIRC for bulk flash program and erase, nested calls are counted.
+ *        Call it while no flash command is running and keep FIRC enabled until the release.
+ * @return SCG_CLOCK_VALID if the boost is held, SCG_CLOCK_DISABLE if FIRC is not valid
+ */
+SCG_StatusType SCG_AcquireNvmClockBoost(void);
+
+/**
+ * @brief Release one successful SCG_AcquireNvmClockBoost, the last release restores the previous
+ *        NVM clock source.
+ */
+void SCG_ReleaseNvmClockBoost(void);
+
+#endif
@@ -0,0 +1,334 @@
+/**
+ * @file fc4xxx_driver_scg_seq.h
+ * @author Flagchip
+ * @brief FC4xxx SCG bring-up register sequences shared by the driver and the early boot code
+ * @version 0.1.0B
+ * @date 2023-09-07
+ *
+ * @copyright Copyright (c) 2020-2023 Flagchip Semiconductors Co., Ltd.
+ *
+ */
+
+/********************************************************************************
+*   Revision History:
+*
+*   Version     Date          Initials       CR#          Descriptions
+*   ---------   ----------    ------------   ----------   ---------------
+*   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
+********************************************************************************/
+#ifndef _DRIVER_FC4XXX_DRIVER_SCG_SEQ_H_
+#define _DRIVER_FC4XXX_DRIVER_SCG_SEQ_H_
+
+/*
+ * The helpers below only touch the SCG registers and const data, they use no static variables,
+ * so fc4xxx_driver_scg.c and fc4xxx_driver_scg_early.c compile the same sequences. They are
+ * expanded with the SCG_HWA_xxx accessors in effect where this header is included: the driver
+ * includes it after its SCG_TRACE_ENABLE wrappers and defines SCG_SEQ_FUNC to place the helpers
+ * in its SCG_RAMFUNC section, the early boot code gets plain accessors and inline functions.
+ * The startup wait loops stay with the callers, the driver uses the learned deadlines.
+ */
+#include "fc4xxx_driver_scg.h"
+#include "fc4xxx_driver_scg_ext.h"
+
+/* ################################################################################## */
+/* ####################################### Macro #################################### */
+
+/**
+ * @brief Storage and placement of the sequence helpers
+ */
+#ifndef SCG_SEQ_FUNC
+#define SCG_SEQ_FUNC                static inline
+#endif
+
+/* rows of s_tSeqDivField */
+#define SCG_SEQ_DIV_FIRC            0U
+#define SCG_SEQ_DIV_SIRC            1U
+#define SCG_SEQ_DIV_FOSC            2U
+#define SCG_SEQ_DIV_PLL0            3U
+
+/* polls of the async divider ACK handshake */
+#define SCG_SEQ_DIV_TIMEOUT         1000U
+
+/* ################################################################################## */
+/* ################################### Type define ################################## */
+typedef struct
+{
+    uint32_t u32DivMask;
+    uint32_t u32DivShift;
+    uint32_t u32EnMask;
+    uint32_t u32AckMask;
+} SCG_SeqDivFieldType;
+
+/* ################################################################################## */
+/* ################################ Local Variables ################################# */
+
+/* async divider fields, indexed by [FIRC, SIRC, FOSC, PLL0][DIVH, DIVM, DIVL] */
+static const SCG_SeqDivFieldType s_tSeqDivField[4U][3U] =
+{
+    {
+        {SCG_FIRCDIV_DIVH_MASK, SCG_FIRCDIV_DIVH_SHIFT, SCG_FIRCDIV_DIVH_EN_MASK, SCG_FIRCDIV_DIVH_ACK_MASK},
+        {SCG_FIRCDIV_DIVM_MASK, SCG_FIRCDIV_DIVM_SHIFT, SCG_FIRCDIV_DIVM_EN_MASK, SCG_FIRCDIV_DIVM_ACK_MASK},
+        {SCG_FIRCDIV_DIVL_MASK, SCG_FIRCDIV_DIVL_SHIFT, SCG_FIRCDIV_DIVL_EN_MASK, SCG_FIRCDIV_DIVL_ACK_MASK}
+    },
+    {
+        {SCG_SIRCDIV_DIVH_MASK, SCG_SIRCDIV_DIVH_SHIFT, SCG_SIRCDIV_DIVH_EN_MASK, SCG_SIRCDIV_DIVH_ACK_MASK},
+        {SCG_SIRCDIV_DIVM_MASK, SCG_SIRCDIV_DIVM_SHIFT, SCG_SIRCDIV_DIVM_EN_MASK, SCG_SIRCDIV_DIVM_ACK_MASK},
+        {SCG_SIRCDIV_DIVL_MASK, SCG_SIRCDIV_DIVL_SHIFT, SCG_SIRCDIV_DIVL_EN_MASK, SCG_SIRCDIV_DIVL_ACK_MASK}
+    },
+    {
+        {SCG_FOSCDIV_DIVH_MASK, SCG_FOSCDIV_DIVH_SHIFT, SCG_FOSCDIV_DIVH_EN_MASK, SCG_FOSCDIV_DIVH_ACK_MASK},
+        {SCG_FOSCDIV_DIVM_MASK, SCG_FOSCDIV_DIVM_SHIFT, SCG_FOSCDIV_DIVM_EN_MASK, SCG_FOSCDIV_DIVM_ACK_MASK},
+        {SCG_FOSCDIV_DIVL_MASK, SCG_FOSCDIV_DIVL_SHIFT, SCG_FOSCDIV_DIVL_EN_MASK, SCG_FOSCDIV_DIVL_ACK_MASK}
+    },
+    {
+        {SCG_PLL0DIV_DIVH_MASK, SCG_PLL0DIV_DIVH_SHIFT, SCG_PLL0DIV_DIVH_EN_MASK, SCG_PLL0DIV_DIVH_ACK_MASK},
+        {SCG_PLL0DIV_DIVM_MASK, SCG_PLL0DIV_DIVM_SHIFT, SCG_PLL0DIV_DIVM_EN_MASK, SCG_PLL0DIV_DIVM_ACK_MASK},
+        {SCG_PLL0DIV_DIVL_MASK, SCG_PLL0DIV_DIVL_SHIFT, SCG_PLL0DIV_DIVL_EN_MASK, SCG_PLL0DIV_DIVL_ACK_MASK}
+    }
+};
+
+/* CCR[SCS] of each SCG_PlanSrcType */
+static const SCG_ClockSrcType s_eSeqPlanSysSrc[3U] =
+{
+    SCG_CLOCK_SRC_FIRC, SCG_CLOCK_SRC_FOSC, SCG_CLOCK_SRC_PLL0
+};
+
+/* ################################################################################## */
+/* ################################ Local Functions  ################################ */
+
+SCG_SEQ_FUNC uint32_t SCG_SeqGetDivReg(uint8_t u8Row)
+{
+    uint32_t u32DivRegVal;
+
+    switch (u8Row)
+    {
+    case SCG_SEQ_DIV_FIRC:
+        u32DivRegVal = SCG_HWA_GetFircDiv();
+        break;
+    case SCG_SEQ_DIV_SIRC:
+        u32DivRegVal = SCG_HWA_GetSircDiv();
+        break;
+    case SCG_SEQ_DIV_FOSC:
+        u32DivRegVal = SCG_HWA_GetFoscDiv();
+        break;
+    default:
+        u32DivRegVal = SCG_HWA_GetPll0Div();
+        break;
+    }
+
+    return u32DivRegVal;
+}
+
+SCG_SEQ_FUNC void SCG_SeqSetDivReg(uint8_t u8Row, uint32_t u32DivRegVal)
+{
+    switch (u8Row)
+    {
+    case SCG_SEQ_DIV_FIRC:
+        SCG_HWA_SetFircDiv(u32DivRegVal);
+        break;
+    case SCG_SEQ_DIV_SIRC:
+        SCG_HWA_SetSircDiv(u32DivRegVal);
+        break;
+    case SCG_SEQ_DIV_FOSC:
+        SCG_HWA_SetFoscDiv(u32DivRegVal);
+        break;
+    default:
+        SCG_HWA_SetPll0Div(u32DivRegVal);
+        break;
+    }
+}
+
+/**
+ * @brief Check if the ACK bits of an async divider register follow their EN bits.
+ *        Always true without SCG_DIV_ACK_HANDSHAKE, the register is then not read.
+ * @param u8Row: row of s_tSeqDivField
+ * @param u32AckMask: ACK bits to check
+ * @param bSet: true if the ACK bits must be set, false if they must be cleared
+ */
+SCG_SEQ_FUNC bool SCG_SeqIsDivAck(uint8_t u8Row, uint32_t u32AckMask, bool bSet)
+{
+#if SCG_DIV_ACK_HANDSHAKE
+    return ((SCG_SeqGetDivReg(u8Row) & u32AckMask) == ((bSet == true) ? u32AckMask : 0U));
+#else
+    (void)u8Row;
+    (void)u32AckMask;
+    (void)bSet;
+    return true;
+#endif
+}
+
+/**
+ * @brief Wait until SCG_SeqIsDivAck is true, at most SCG_SEQ_DIV_TIMEOUT polls.
+ * @return false on timeout
+ */
+SCG_SEQ_FUNC bool SCG_SeqWaitDivAck(uint8_t u8Row, uint32_t u32AckMask, bool bSet)
+{
+    uint32_t u32Temp = SCG_SEQ_DIV_TIMEOUT;
+
+    while ((SCG_SeqIsDivAck(u8Row, u32AckMask, bSet) == false) && (u32Temp > 0U))
+    {
+        u32Temp--;
+    }
+
+    return (u32Temp != 0U);
+}
+
+/**
+ * @brief Program DIVH/DIVM/DIVL of one async divider register with the EN/ACK handshake.
+ *        ACK timeouts are ignored, same as the setters.
+ * @param u8Row: row of s_tSeqDivField
+ * @param pDiv: DIVH, DIVM and DIVL field values
+ */
+SCG_SEQ_FUNC void SCG_SeqWriteDivs(uint8_t u8Row, const uint8_t pDiv[3U])
+{
+    const SCG_SeqDivFieldType *pField = s_tSeqDivField[u8Row];
+    uint32_t u32EnMask = pField[0U].u32EnMask | pField[1U].u32EnMask | pField[2U].u32EnMask;
+    uint32_t u32AckMask = pField[0U].u32AckMask | pField[1U].u32AckMask | pField[2U].u32AckMask;
+    uint32_t u32DivRegVal;
+    uint8_t u8Index;
+
+    u32DivRegVal = SCG_SeqGetDivReg(u8Row) & ~u32EnMask;
+    SCG_SeqSetDivReg(u8Row, u32DivRegVal);
+    (void)SCG_SeqWaitDivAck(u8Row, u32AckMask, false);
+
+    for (u8Index = 0U; u8Index < 3U; u8Index++)
+    {
+        u32DivRegVal &= ~pField[u8Index].u32DivMask;
+        u32DivRegVal |= ((uint32_t)pDiv[u8Index] << pField[u8Index].u32DivShift) & pField[u8Index].u32DivMask;
+    }
+    SCG_SeqSetDivReg(u8Row, u32DivRegVal);
+
+    SCG_SeqSetDivReg(u8Row, u32DivRegVal | u32EnMask);
+    (void)SCG_SeqWaitDivAck(u8Row, u32AckMask, true);
+}
+
+/**
+ * @brief FOSCCFG value for a crystal or an external clock in bypass with the given tuning.
+ */
+SCG_SEQ_FUNC uint32_t SCG_SeqFoscCfgValue(bool bBypass, const SCG_FoscTuneType *pTune)
+{
+    /* COMP_EN must be 1 when using an external crystal */
+    return (uint32_t)(SCG_FOSCCFG_BYPASS(bBypass) | SCG_FOSCCFG_COMP_EN(bBypass == false) |
+                      SCG_FOSCCFG_EOCV(pTune->u8Eocv) | SCG_FOSCCFG_GM_SEL(pTune->u8GmSel) |
+                      SCG_FOSCCFG_ALC_D(pTune->u8AlcD) | SCG_FOSCCFG_HYST_D(pTune->u8HystD));
+}
+
+/**
+ * @brief Write PLL0CFG, with PREDIV BY2 the PLL0 is briefly started with PREDIV BY4 first.
+ */
+SCG_SEQ_FUNC void SCG_SeqWritePll0Cfg(uint32_t u32Src, uint32_t u32Prediv, uint32_t u32Mult)
+{
+    uint32_t u32Temp;
+    uint32_t u32Index;
+
+    if ((uint32_t)SCG_PLL0PREDIV_BY2 == u32Prediv)
+    {
+        u32Temp =  SCG_PLL0CFG_PREDIV(SCG_PLL0PREDIV_BY4) | SCG_PLL0CFG_MULT(u32Mult) |
+                   SCG_PLL0CFG_SOURCE(u32Src) ;
+        SCG_HWA_SetPll0Cfg(u32Temp);
+        u32Temp = SCG_PLL0CSR_EN_MASK;
+        SCG_HWA_SetPll0Csr(u32Temp);
+        for (u32Index = 0; u32Index < 200; u32Index++)
+        {
+            __asm("nop");
+        }
+
+        SCG_HWA_SetPll0Csr(0U);
+    }
+
+    u32Temp =  SCG_PLL0CFG_PREDIV(u32Prediv) | SCG_PLL0CFG_MULT(u32Mult) |
+               SCG_PLL0CFG_SOURCE(u32Src) ;
+    SCG_HWA_SetPll0Cfg(u32Temp);
+}
+
+/**
+ * @brief Unlock FOSCCSR, write FOSCCFG and enable FOSC with the stop enable of the plan.
+ *        The caller then waits for FOSCCSR[VALID] and calls SCG_SeqFinishPlanFosc.
+ * @param pPlan: clock plan with SCG_PLAN_FLAG_FOSC_EN set
+ * @param u32FoscCfg: FOSCCFG value
+ */
+SCG_SEQ_FUNC void SCG_SeqStartPlanFosc(const SCG_ClockPlanType *pPlan, uint32_t u32FoscCfg)
+{
+    uint32_t u32Temp;
+
+    SCG_HWA_SetFoscCfg(u32FoscCfg);
+
+    u32Temp = SCG->FOSCCSR;
+    u32Temp &= ~(uint32_t)SCG_FOSCCSR_LK_MASK;
+    SCG_HWA_SetFoscCsr(u32Temp);
+
+    /* configure stop enable and enable FOSC */
+    u32Temp &= ~(uint32_t)SCG_FOSCCSR_STEN_MASK;
+    u32Temp |= SCG_FOSCCSR_EN(1U) | SCG_FOSCCSR_STEN((pPlan->u16Flags & SCG_PLAN_FLAG_FOSC_STEN) != 0U);
+    SCG_HWA_SetFoscCsr(u32Temp);
+}
+
+/**
+ * @brief Set CM, CMRE and LK of a valid FOSC as the plan requests and program FOSCDIV.
+ */
+SCG_SEQ_FUNC void SCG_SeqFinishPlanFosc(const SCG_ClockPlanType *pPlan)
+{
+    uint16_t u16Flags = pPlan->u16Flags;
+    uint32_t u32Temp;
+
+    u32Temp = SCG->FOSCCSR;
+    /* Configure CM CMRE and lock */
+    u32Temp |= SCG_FOSCCSR_CM((u16Flags & SCG_PLAN_FLAG_FOSC_CM) != 0U);
+    SCG_HWA_SetFoscCsr(u32Temp);
+
+    u32Temp &= ~(uint32_t)SCG_FOSCCSR_CMRE_MASK;
+    u32Temp |= SCG_FOSCCSR_CMRE((u16Flags & SCG_PLAN_FLAG_FOSC_CMRE) != 0U) |
+               SCG_FOSCCSR_LK((u16Flags & SCG_PLAN_FLAG_FOSC_LK) != 0U);
+    SCG_HWA_SetFoscCsr(u32Temp);
+
+    SCG_SeqWriteDivs(SCG_SEQ_DIV_FOSC, pPlan->au8FoscDiv);
+}
+
+/**
+ * @brief Write PLL0CFG and enable PLL0 with the stop enable of the plan.
+ *        The caller then waits for PLL0CSR[LOCK] and calls SCG_SeqFinishPlanPll0.
+ * @param pPlan: clock plan with SCG_PLAN_FLAG_PLL0_EN set
+ */
+SCG_SEQ_FUNC void SCG_SeqStartPlanPll0(const SCG_ClockPlanType *pPlan)
+{
+    uint32_t u32Temp;
+
+    SCG_SeqWritePll0Cfg((pPlan->u8Pll0Src == (uint8_t)SCG_PLAN_SRC_FIRC) ? (uint32_t)SCG_PLL0SOURCE_FIRC : (uint32_t)SCG_PLL0SOURCE_FOSC,
+                        pPlan->u8Pll0Prediv, pPlan->u8Pll0Mult);
+
+    u32Temp = SCG_PLL0CSR_EN(1U) | SCG_PLL0CSR_STEN((pPlan->u16Flags & SCG_PLAN_FLAG_PLL0_STEN) != 0U);
+    SCG_HWA_SetPll0Csr(u32Temp);
+}
+
+/**
+ * @brief Set CM, CMRE and LK of a locked PLL0 as the plan requests and program PLL0DIV.
+ */
+SCG_SEQ_FUNC void SCG_SeqFinishPlanPll0(const SCG_ClockPlanType *pPlan)
+{
+    uint16_t u16Flags = pPlan->u16Flags;
+    uint32_t u32Temp;
+
+    u32Temp = SCG->PLL0CSR;
+    /* Configure CM CMRE and lock */
+    u32Temp |= SCG_PLL0CSR_CM((u16Flags & SCG_PLAN_FLAG_PLL0_CM) != 0U);
+    SCG_HWA_SetPll0Csr(u32Temp);
+    u32Temp |= SCG_PLL0CSR_CMRE((u16Flags & SCG_PLAN_FLAG_PLL0_CMRE) != 0U) |
+               SCG_PLL0CSR_LK((u16Flags & SCG_PLAN_FLAG_PLL0_LK) != 0U);
+    SCG_HWA_SetPll0Csr(u32Temp);
+
+    SCG_SeqWriteDivs(SCG_SEQ_DIV_PLL0, pPlan->au8Pll0Div);
+}
+
+/**
+ * @brief CCR value that selects the system clock source and dividers of the plan.
+ */
+SCG_SEQ_FUNC uint32_t SCG_SeqPlanCcr(const SCG_ClockPlanType *pPlan)
+{
+    return (uint32_t)((uint32_t)SCG_CCR_SYSCLK_CME((pPlan->u16Flags & SCG_PLAN_FLAG_SYSCLK_CME) != 0U) |
+                      (uint32_t)SCG_CCR_SCS(s_eSeqPlanSysSrc[pPlan->u8SysSrc]) |
+                      (uint32_t)SCG_CCR_DIVCORE(pPlan->u8DivCore) |
+                      (uint32_t)SCG_CCR_DIVBUS(pPlan->u8DivBus)  |
+                      (uint32_t)SCG_CCR_DIVSLOW(pPlan->u8DivSlow));
+}
+
+#endif
@@ -0,0 +1,92 @@
+/**
+ * @file fc4xxx_driver_scg_trace.h
+ * @author Flagchip
+ * @brief FC4xxx SCG register write trace record format
+ * @version 0.1.0B
+ * @date 2023-09-07
+ *
+ * @copyright Copyright (c) 2020-2023 Flagchip Semiconductors Co., Ltd.
+ *
+ */
+
+/********************************************************************************
+*   Revision History:
+*
+*   Version     Date          Initials       CR#          Descriptions
+*   ---------   ----------    ------------   ----------   ---------------
+*   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
+********************************************************************************/
+#ifndef _DRIVER_FC4XXX_DRIVER_SCG_TRACE_H_
+#define _DRIVER_FC4XXX_DRIVER_SCG_TRACE_H_
+
+/*
+ * The trace is recorded by fc4xxx_driver_scg.c when SCG_TRACE_ENABLE is defined and decoded on the
+ * host by tools/scg_trace_decode.c, this header has no device header dependency so both use it.
+ */
+#include <stdint.h>
+
+/* ################################################################################## */
+/* ####################################### Macro #################################### */
+
+/**
+ * @brief Number of trace entries, must be a power of 2
+ */
+#ifndef SCG_TRACE_LEN
+#define SCG_TRACE_LEN       64U
+#endif
+
+/* ################################################################################## */
+/* ################################### Type define ################################## */
+
+/**
+ * @brief Traced SCG registers
+ */
+typedef enum
+{
+    SCG_TRACE_REG_CCR = 0U,
+    SCG_TRACE_REG_CLKOUTCFG,
+    SCG_TRACE_REG_FIRCCSR,
+    SCG_TRACE_REG_FIRCDIV,
+    SCG_TRACE_REG_FIRCCFG,
+    SCG_TRACE_REG_FIRCTCFG,
+    SCG_TRACE_REG_SIRCCSR,
+    SCG_TRACE_REG_SIRCDIV,
+    SCG_TRACE_REG_SIRCTCFG,
+    SCG_TRACE_REG_SIRC32KCSR,
+    SCG_TRACE_REG_FOSCCSR,
+    SCG_TRACE_REG_FOSCDIV,
+    SCG_TRACE_REG_FOSCCFG,
+    SCG_TRACE_REG_SOSCCSR,
+    SCG_TRACE_REG_SOSCCFG,
+    SCG_TRACE_REG_PLL0CSR,
+    SCG_TRACE_REG_PLL0DIV,
+    SCG_TRACE_REG_PLL0CFG,
+    SCG_TRACE_REG_NUM
+} SCG_TraceRegType;
+
+/**
+ * @brief Meaning of the recorded value
+ */
+typedef enum
+{
+    SCG_TRACE_OP_WRITE = 0U,            /**< value written by a SCG_HWA_SetXxx accessor */
+    SCG_TRACE_OP_MODIFY,                /**< register read back after an enable, disable or unlock accessor */
+    SCG_TRACE_OP_ERRCLEAR               /**< register read back after a clock error flag was cleared by a
+                                             SCG_HWA_CheckAndClearXxx accessor, SCG_IRQHandler clears the
+                                             flags with a WRITE of the CSR with ERR set */
+} SCG_TraceOpType;
+
+/**
+ * @brief One trace entry, 16 bytes, little endian on target and host
+ */
+typedef struct
+{
+    uint32_t u32Cycles;                 /**< SCG_GET_CYCLES() after the write */
+    uint32_t u32Caller;                 /**< return address into the driver function doing the write */
+    uint32_t u32Value;                  /**< see SCG_TraceOpType */
+    uint16_t u16Seq;                    /**< write sequence number, gaps mean overwritten entries */
+    uint8_t u8Reg;                      /**< SCG_TraceRegType */
+    uint8_t u8Op;                       /**< SCG_TraceOpType */
+} SCG_TraceEntryType;
+
+#endif
@@ -0,0 +1,393 @@
+/**
+ * @file scg_explore.c
+ * @author Flagchip
+ * @brief Host explorer of the legal SCG clock trees with a Pareto table of performance, power,
+ *        bring-up latency and clock accuracy
+ * @version 0.1.0B
+ * @date 2023-09-07
+ *
+ * @copyright Copyright (c) 2020-2023 Flagchip Semiconductors Co., Ltd.
+ *
+ * Build on the host, from the driver directory:
+ *     cc -std=c99 -I. -o scg_explore tools/scg_explore.c fc4xxx_driver_scg_calc.c
+ *
+ * Usage:
+ *     scg_explore [-fosc <Hz>] [-divh <Hz>] [-divm <Hz>] [-divl <Hz>] [-all] [-json]
+ *
+ * Every system clock source (FIRC, FOSC, PLL0 from FIRC, PLL0 from FOSC), every PLL0 ePrediv and
+ * eMult and every DIVCORE is enumerated with the driver's own limits from fc4xxx_driver_scg_calc.c.
+ * PLL0 is range checked like SCG_SetPLL0, its frequency is the one SCG_SetPll0ClockStatus reports
+ * (SCG_CalcPll0NodeFreq), which is what SCG_SetClkCtrl checks the system clocks against.
+ * DIVBUS and DIVSLOW are the fastest legal value for each core clock, prediv/mult pairs giving the
+ * same PLL0 frequency are reported once with the smallest prediv. With -divh/-divm/-divl the async
+ * dividers of the system clock source are the fastest ones not above the given frequency.
+ * Without -all only the Pareto optimal trees are printed: higher core clock, lower power score,
+ * lower bring-up latency and lower clock tolerance.
+ *
+ * The power score and latencies are relative estimates for ranking, not datasheet values.
+ */
+
+/********************************************************************************
+*   Revision History:
+*
+*   Version     Date          Initials       CR#          Descriptions
+*   ---------   ----------    ------------   ----------   ---------------
+*   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
+********************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fc4xxx_driver_scg_calc.h"
+
+/* ################################################################################## */
+/* ####################################### Macro #################################### */
+#define EXPLORE_PREDIV_MAX          7U
+#define EXPLORE_MULT_MAX            47U
+#define EXPLORE_SYSDIV_MAX          15U
+#define EXPLORE_ASYNCDIV_MAX        7U
+#define EXPLORE_MAX_TREES           16384U
+
+/* relative power weights per MHz and static costs */
+#define EXPLORE_PWR_CORE            1.00
+#define EXPLORE_PWR_BUS             0.50
+#define EXPLORE_PWR_SLOW            0.25
+#define EXPLORE_PWR_PLL0            0.30
+#define EXPLORE_PWR_FOSC_STATIC     5.00
+#define EXPLORE_PWR_PLL0_STATIC     8.00
+
+/* bring-up latency estimates in us, FIRC runs out of reset */
+#define EXPLORE_LAT_FOSC_US         3000U
+#define EXPLORE_LAT_PLL0_US         150U
+#define EXPLORE_LAT_SWITCH_US       5U
+
+/* clock tolerance in ppm */
+#define EXPLORE_PPM_FIRC            10000U
+#define EXPLORE_PPM_FOSC            50U
+
+/* ################################################################################## */
+/* ################################### Type define ################################## */
+typedef enum
+{
+    TREE_FIRC = 0,
+    TREE_FOSC,
+    TREE_PLL0_FIRC,
+    TREE_PLL0_FOSC
+} TreeSrcType;
+
+typedef struct
+{
+    TreeSrcType eSrc;
+    uint32_t u32Prediv;
+    uint32_t u32Mult;
+    uint32_t u32SrcFreq;
+    uint32_t au32SysDiv[3];
+    SCG_CalcSysFreqType tSys;
+    uint32_t au32AsyncDiv[3];
+    uint32_t au32AsyncFreq[3];
+    uint32_t u32LatencyUs;
+    uint32_t u32Ppm;
+    double dPower;
+    int bDominated;
+} TreeType;
+
+/* ################################################################################## */
+/* ################################ Local Variables ################################# */
+static const char *const s_pSrcName[] = {"FIRC", "FOSC", "PLL0_FIRC", "PLL0_FOSC"};
+
+static TreeType s_tTree[EXPLORE_MAX_TREES];
+static uint32_t s_u32TreeCount;
+static uint32_t s_au32AsyncTarget[3];
+
+/* ################################################################################## */
+/* ################################ Local Functions  ################################ */
+
+static void Usage(void)
+{
+    fprintf(stderr, "usage: scg_explore [-fosc <Hz>] [-divh <Hz>] [-divm <Hz>] [-divl <Hz>] [-all] [-json]\n");
+    exit(2);
+}
+
+/* fastest legal DIVBUS and DIVSLOW for a source and DIVCORE, false if none */
+static int PickSysDiv(uint32_t u32SrcFreq, uint32_t u32DivCore, uint32_t au32SysDiv[3], SCG_CalcSysFreqType *pSys)
+{
+    uint32_t u32DivBus;
+    uint32_t u32DivSlow;
+
+    for (u32DivBus = 0U; u32DivBus <= EXPLORE_SYSDIV_MAX; u32DivBus++)
+    {
+        if (SCG_CalcSysClk(u32SrcFreq, u32DivCore, u32DivBus, EXPLORE_SYSDIV_MAX, NULL))
+        {
+            break;
+        }
+    }
+    for (u32DivSlow = 0U; u32DivSlow <= EXPLORE_SYSDIV_MAX; u32DivSlow++)
+    {
+        if (SCG_CalcSysClk(u32SrcFreq, u32DivCore, u32DivBus, u32DivSlow, pSys))
+        {
+            break;
+        }
+    }
+
+    au32SysDiv[0] = u32DivCore;
+    au32SysDiv[1] = u32DivBus;
+    au32SysDiv[2] = u32DivSlow;
+
+    return (u32DivBus <= EXPLORE_SYSDIV_MAX) && (u32DivSlow <= EXPLORE_SYSDIV_MAX);
+}
+
+/* fastest async divider not above the target, false if none */
+static int PickAsyncDiv(uint32_t u32SrcFreq, TreeType *pTree)
+{
+    uint32_t u32Which;
+    uint32_t u32Div;
+
+    for (u32Which = 0U; u32Which < 3U; u32Which++)
+    {
+        pTree->au32AsyncDiv[u32Which] = 0U;
+        pTree->au32AsyncFreq[u32Which] = 0U;
+        if (s_au32AsyncTarget[u32Which] != 0U)
+        {
+            for (u32Div = 1U; u32Div <= EXPLORE_ASYNCDIV_MAX; u32Div++)
+            {
+                if (SCG_CalcAsyncDivFreq(u32SrcFreq, u32Div) <= s_au32AsyncTarget[u32Which])
+                {
+                    break;
+                }
+            }
+            if (u32Div > EXPLORE_ASYNCDIV_MAX)
+            {
+                return 0;
+            }
+            pTree->au32AsyncDiv[u32Which] = u32Div;
+            pTree->au32AsyncFreq[u32Which] = SCG_CalcAsyncDivFreq(u32SrcFreq, u32Div);
+        }
+    }
+
+    return 1;
+}
+
+static void AddTrees(TreeSrcType eSrc, uint32_t u32SrcFreq, uint32_t u32Prediv, uint32_t u32Mult)
+{
+    TreeType tTree;
+    uint32_t u32DivCore;
+
+    memset(&tTree, 0, sizeof(tTree));
+    tTree.eSrc = eSrc;
+    tTree.u32Prediv = u32Prediv;
+    tTree.u32Mult = u32Mult;
+    tTree.u32SrcFreq = u32SrcFreq;
+    tTree.u32Ppm = ((eSrc == TREE_FIRC) || (eSrc == TREE_PLL0_FIRC)) ? EXPLORE_PPM_FIRC : EXPLORE_PPM_FOSC;
+    tTree.u32LatencyUs = EXPLORE_LAT_SWITCH_US;
+    tTree.dPower = 0.0;
+    if ((eSrc == TREE_FOSC) || (eSrc == TREE_PLL0_FOSC))
+    {
+        tTree.u32LatencyUs += EXPLORE_LAT_FOSC_US;
+        tTree.dPower += EXPLORE_PWR_FOSC_STATIC;
+    }
+    if ((eSrc == TREE_PLL0_FIRC) || (eSrc == TREE_PLL0_FOSC))
+    {
+        tTree.u32LatencyUs += EXPLORE_LAT_PLL0_US;
+        tTree.dPower += EXPLORE_PWR_PLL0_STATIC + (EXPLORE_PWR_PLL0 * (double)u32SrcFreq / 1e6);
+    }
+
+    if (!PickAsyncDiv(u32SrcFreq, &tTree))
+    {
+        return;
+    }
+
+    for (u32DivCore = 0U; u32DivCore <= EXPLORE_SYSDIV_MAX; u32DivCore++)
+    {
+        if (PickSysDiv(u32SrcFreq, u32DivCore, tTree.au32SysDiv, &tTree.tSys) && (s_u32TreeCount < EXPLORE_MAX_TREES))
+        {
+            s_tTree[s_u32TreeCount] = tTree;
+            s_tTree[s_u32TreeCount].dPower += (EXPLORE_PWR_CORE * (double)tTree.tSys.u32CoreFreq / 1e6) +
+                                              (EXPLORE_PWR_BUS * (double)tTree.tSys.u32BusFreq / 1e6) +
+                                              (EXPLORE_PWR_SLOW * (double)tTree.tSys.u32SlowFreq / 1e6);
+            s_u32TreeCount++;
+        }
+    }
+}
+
+static void AddPll0Trees(TreeSrcType eSrc, uint32_t u32InFreq)
+{
+    uint32_t au32Seen[(EXPLORE_PREDIV_MAX + 1U) * (EXPLORE_MULT_MAX + 1U)];
+    uint32_t u32SeenCount = 0U;
+    uint32_t u32Prediv, u32Mult, u32Index, u32Freq;
+    uint32_t u32RangeFreq;
+    int bFirc = (eSrc == TREE_PLL0_FIRC);
+
+    for (u32Prediv = 0U; u32Prediv <= EXPLORE_PREDIV_MAX; u32Prediv++)
+    {
+        for (u32Mult = 0U; u32Mult <= EXPLORE_MULT_MAX; u32Mult++)
+        {
+            u32RangeFreq = SCG_CalcPll0Freq(u32InFreq, bFirc, u32Prediv, u32Mult);
+            if (!SCG_CalcPll0InRange(u32RangeFreq, bFirc))
+            {
+                continue;
+            }
+            u32Freq = SCG_CalcPll0NodeFreq(u32InFreq, u32Prediv, u32Mult);
+            for (u32Index = 0U; (u32Index < u32SeenCount) && (au32Seen[u32Index] != u32Freq); u32Index++)
+            {
+            }
+            if (u32Index == u32SeenCount)
+            {
+                au32Seen[u32SeenCount++] = u32Freq;
+                AddTrees(eSrc, u32Freq, u32Prediv, u32Mult);
+            }
+        }
+    }
+}
+
+/* a dominates b if it is no worse in every objective and better in one */
+static int Dominates(const TreeType *pA, const TreeType *pB)
+{
+    int bNoWorse = (pA->tSys.u32CoreFreq >= pB->tSys.u32CoreFreq) && (pA->dPower <= pB->dPower) &&
+                   (pA->u32LatencyUs <= pB->u32LatencyUs) && (pA->u32Ppm <= pB->u32Ppm);
+    int bBetter = (pA->tSys.u32CoreFreq > pB->tSys.u32CoreFreq) || (pA->dPower < pB->dPower) ||
+                  (pA->u32LatencyUs < pB->u32LatencyUs) || (pA->u32Ppm < pB->u32Ppm);
+
+    return bNoWorse && bBetter;
+}
+
+static int CompareTree(const void *pA, const void *pB)
+{
+    const TreeType *pTa = (const TreeType *)pA;
+    const TreeType *pTb = (const TreeType *)pB;
+    int iResult;
+
+    if (pTa->tSys.u32CoreFreq != pTb->tSys.u32CoreFreq)
+    {
+        iResult = (pTa->tSys.u32CoreFreq > pTb->tSys.u32CoreFreq) ? -1 : 1;
+    }
+    else
+    {
+        iResult = (pTa->dPower < pTb->dPower) ? -1 : ((pTa->dPower > pTb->dPower) ? 1 : 0);
+    }
+
+    return iResult;
+}
+
+static void PrintTree(const TreeType *pTree, int bJson, int bFirst)
+{
+    if (bJson)
+    {
+        printf("%s  {\"src\": \"%s\", \"src_hz\": %lu, \"prediv\": %lu, \"mult\": %lu, "
+               "\"divcore\": %lu, \"divbus\": %lu, \"divslow\": %lu, "
+               "\"core_hz\": %lu, \"bus_hz\": %lu, \"slow_hz\": %lu, "
+               "\"divh\": %lu, \"divm\": %lu, \"divl\": %lu, "
+               "\"divh_hz\": %lu, \"divm_hz\": %lu, \"divl_hz\": %lu, "
+               "\"latency_us\": %lu, \"power\": %.2f, \"ppm\": %lu}",
+               bFirst ? "" : ",\n", s_pSrcName[pTree->eSrc], (unsigned long)pTree->u32SrcFreq,
+               (unsigned long)pTree->u32Prediv, (unsigned long)pTree->u32Mult,
+               (unsigned long)pTree->au32SysDiv[0], (unsigned long)pTree->au32SysDiv[1], (unsigned long)pTree->au32SysDiv[2],
+               (unsigned long)pTree->tSys.u32CoreFreq, (unsigned long)pTree->tSys.u32BusFreq, (unsigned long)pTree->tSys.u32SlowFreq,
+               (unsigned long)pTree->au32AsyncDiv[0], (unsigned long)pTree->au32AsyncDiv[1], (unsigned long)pTree->au32AsyncDiv[2],
+               (unsigned long)pTree->au32AsyncFreq[0], (unsigned long)pTree->au32AsyncFreq[1], (unsigned long)pTree->au32AsyncFreq[2],
+               (unsigned long)pTree->u32LatencyUs, pTree->dPower, (unsigned long)pTree->u32Ppm);
+    }
+    else
+    {
+        printf("%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%.2f,%lu\n",
+               s_pSrcName[pTree->eSrc], (unsigned long)pTree->u32SrcFreq,
+               (unsigned long)pTree->u32Prediv, (unsigned long)pTree->u32Mult,
+               (unsigned long)pTree->au32SysDiv[0], (unsigned long)pTree->au32SysDiv[1], (unsigned long)pTree->au32SysDiv[2],
+               (unsigned long)pTree->tSys.u32CoreFreq, (unsigned long)pTree->tSys.u32BusFreq, (unsigned long)pTree->tSys.u32SlowFreq,
+               (unsigned long)pTree->au32AsyncDiv[0], (unsigned long)pTree->au32AsyncDiv[1], (unsigned long)pTree->au32AsyncDiv[2],
+               (unsigned long)pTree->au32AsyncFreq[0], (unsigned long)pTree->au32AsyncFreq[1], (unsigned long)pTree->au32AsyncFreq[2],
+               (unsigned long)pTree->u32LatencyUs, pTree->dPower, (unsigned long)pTree->u32Ppm);
+    }
+}
+
+/* ################################################################################## */
+/* ################################ Global Functions ################################ */
+
+int main(int argc, char **argv)
+{
+    uint32_t u32FoscFreq = 0U;
+    uint32_t u32Index, u32Other;
+    int bAll = 0;
+    int bJson = 0;
+    int bFirst = 1;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-fosc") == 0) && ((i + 1) < argc))
+        {
+            u32FoscFreq = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-divh") == 0) && ((i + 1) < argc))
+        {
+            s_au32AsyncTarget[0] = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-divm") == 0) && ((i + 1) < argc))
+        {
+            s_au32AsyncTarget[1] = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if ((strcmp(argv[i], "-divl") == 0) && ((i + 1) < argc))
+        {
+            s_au32AsyncTarget[2] = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "-all") == 0)
+        {
+            bAll = 1;
+        }
+        else if (strcmp(argv[i], "-json") == 0)
+        {
+            bJson = 1;
+        }
+        else
+        {
+            Usage();
+        }
+    }
+
+    AddTrees(TREE_FIRC, FIRC_CLOCK, 0U, 0U);
+    AddPll0Trees(TREE_PLL0_FIRC, FIRC_CLOCK);
+    if (u32FoscFreq != 0U)
+    {
+        AddTrees(TREE_FOSC, u32FoscFreq, 0U, 0U);
+        AddPll0Trees(TREE_PLL0_FOSC, u32FoscFreq);
+    }
+
+    if (!bAll)
+    {
+        for (u32Index = 0U; u32Index < s_u32TreeCount; u32Index++)
+        {
+            for (u32Other = 0U; u32Other < s_u32TreeCount; u32Other++)
+            {
+                if (Dominates(&s_tTree[u32Other], &s_tTree[u32Index]))
+                {
+                    s_tTree[u32Index].bDominated = 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    qsort(s_tTree, s_u32TreeCount, sizeof(s_tTree[0]), CompareTree);
+
+    if (bJson)
+    {
+        printf("[\n");
+    }
+    else
+    {
+        printf("src,src_hz,prediv,mult,divcore,divbus,divslow,core_hz,bus_hz,slow_hz,"
+               "divh,divm,divl,divh_hz,divm_hz,divl_hz,latency_us,power,ppm\n");
+    }
+    for (u32Index = 0U; u32Index < s_u32TreeCount; u32Index++)
+    {
+        if (!s_tTree[u32Index].bDominated)
+        {
+            PrintTree(&s_tTree[u32Index], bJson, bFirst);
+            bFirst = 0;
+        }
+    }
+    if (bJson)
+    {
+        printf("\n]\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,266 @@
+/**
+ * @file scg_plan_gen.c
+ * @author Flagchip
+ * @brief Host generator of the SCG clock plan image applied by SCG_ApplyStoredPlan
+ * @version 0.1.0B
+ * @date 2023-09-07
+ *
+ * @copyright Copyright (c) 2020-2023 Flagchip Semiconductors Co., Ltd.
+ *
+ * Build on the host, from the driver directory:
+ *     cc -std=c99 -I. -o scg_plan_gen tools/scg_plan_gen.c fc4xxx_driver_scg_calc.c
+ *
+ * Example, FOSC 24MHz -> PLL0 150MHz as core clock:
+ *     scg_plan_gen -fosc 24000000 -fosc-div 1 2 4 -pll0 fosc 1 9 -pll0-div 1 2 3 \
+ *                  -sys pll0 0 1 3 -firc-div 1 2 4 > scg_clock_plan.c
+ *
+ * Divider, prediv and mult values are the register field encodings.
+ * The plan is checked with SCG_CalcCheckPlan, the same logic as the driver setters,
+ * an illegal plan is reported and no image is written.
+ */
+
+/********************************************************************************
+*   Revision History:
+*
+*   Version     Date          Initials       CR#          Descriptions
+*   ---------   ----------    ------------   ----------   ---------------
+*   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
+********************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fc4xxx_driver_scg_calc.h"
+
+/* ################################################################################## */
+/* ################################### Type define ################################## */
+typedef struct
+{
+    const char *pName;
+    uint16_t u16Flag;
+} PlanFlagOptType;
+
+/* ################################################################################## */
+/* ################################ Local Variables ################################# */
+static const PlanFlagOptType s_tFlagOpt[] =
+{
+    {"-bypass",     SCG_PLAN_FLAG_FOSC_BYPASS},
+    {"-fosc-sten",  SCG_PLAN_FLAG_FOSC_STEN},
+    {"-fosc-cm",    SCG_PLAN_FLAG_FOSC_CM},
+    {"-fosc-cmre",  SCG_PLAN_FLAG_FOSC_CMRE},
+    {"-fosc-lock",  SCG_PLAN_FLAG_FOSC_LK},
+    {"-pll0-sten",  SCG_PLAN_FLAG_PLL0_STEN},
+    {"-pll0-cm",    SCG_PLAN_FLAG_PLL0_CM},
+    {"-pll0-cmre",  SCG_PLAN_FLAG_PLL0_CMRE},
+    {"-pll0-lock",  SCG_PLAN_FLAG_PLL0_LK},
+    {"-sys-cme",    SCG_PLAN_FLAG_SYSCLK_CME},
+};
+
+static const char *const s_pResultText[] =
+{
+    "ok",
+    "field value out of range",
+    "selected clock source is not enabled",
+    "PLL0 output out of range",
+    "CORE, BUS or SLOW clock above maximum",
+};
+
+/* ################################################################################## */
+/* ################################ Local Functions  ################################ */
+
+static void Usage(void)
+{
+    fprintf(stderr,
+            "usage: scg_plan_gen [options]\n"
+            "  -fosc <Hz>                     enable FOSC\n"
+            "  -pll0 <firc|fosc> <prediv> <mult>\n"
+            "  -sys <firc|fosc|pll0> <divcore> <divbus> <divslow>\n"
+            "  -firc-div|-fosc-div|-pll0-div <h> <m> <l>\n"
+            "  -bypass -fosc-sten -fosc-cm -fosc-cmre -fosc-lock\n"
+            "  -pll0-sten -pll0-cm -pll0-cmre -pll0-lock -sys-cme\n"
+            "  -o <file>                      write the binary image instead of C source\n");
+    exit(2);
+}
+
+static uint32_t ArgU32(int argc, char **argv, int i)
+{
+    char *pEnd;
+    unsigned long u32Val;
+
+    if (i >= argc)
+    {
+        Usage();
+    }
+    u32Val = strtoul(argv[i], &pEnd, 0);
+    if ((*argv[i] == '\0') || (*pEnd != '\0'))
+    {
+        Usage();
+    }
+
+    return (uint32_t)u32Val;
+}
+
+static uint8_t ArgSrc(int argc, char **argv, int i)
+{
+    uint8_t u8Src;
+
+    if (i >= argc)
+    {
+        Usage();
+    }
+    if (strcmp(argv[i], "firc") == 0)
+    {
+        u8Src = (uint8_t)SCG_PLAN_SRC_FIRC;
+    }
+    else if (strcmp(argv[i], "fosc") == 0)
+    {
+        u8Src = (uint8_t)SCG_PLAN_SRC_FOSC;
+    }
+    else if (strcmp(argv[i], "pll0") == 0)
+    {
+        u8Src = (uint8_t)SCG_PLAN_SRC_PLL0;
+    }
+    else
+    {
+        Usage();
+    }
+
+    return u8Src;
+}
+
+static void ArgDiv(int argc, char **argv, int i, uint8_t au8Div[3])
+{
+    au8Div[0] = (uint8_t)ArgU32(argc, argv, i);
+    au8Div[1] = (uint8_t)ArgU32(argc, argv, i + 1);
+    au8Div[2] = (uint8_t)ArgU32(argc, argv, i + 2);
+}
+
+static void PrintPlan(const SCG_ClockPlanType *pPlan)
+{
+    printf("/* generated by scg_plan_gen, core clock %lu Hz */\n", (unsigned long)pPlan->u32CoreFreq);
+    printf("#include \"fc4xxx_driver_scg_calc.h\"\n\n");
+    printf("const SCG_ClockPlanType g_tScgClockPlan =\n{\n");
+    printf("    .u32Magic = 0x%08lXU,\n", (unsigned long)pPlan->u32Magic);
+    printf("    .u16Version = %uU,\n", (unsigned)pPlan->u16Version);
+    printf("    .u16Flags = 0x%04XU,\n", (unsigned)pPlan->u16Flags);
+    printf("    .u32FoscFreq = %luU,\n", (unsigned long)pPlan->u32FoscFreq);
+    printf("    .u32CoreFreq = %luU,\n", (unsigned long)pPlan->u32CoreFreq);
+    printf("    .u8Pll0Src = %uU,\n", (unsigned)pPlan->u8Pll0Src);
+    printf("    .u8Pll0Prediv = %uU,\n", (unsigned)pPlan->u8Pll0Prediv);
+    printf("    .u8Pll0Mult = %uU,\n", (unsigned)pPlan->u8Pll0Mult);
+    printf("    .u8SysSrc = %uU,\n", (unsigned)pPlan->u8SysSrc);
+    printf("    .au8FircDiv = {%uU, %uU, %uU},\n", pPlan->au8FircDiv[0], pPlan->au8FircDiv[1], pPlan->au8FircDiv[2]);
+    printf("    .u8DivCore = %uU,\n", (unsigned)pPlan->u8DivCore);
+    printf("    .au8FoscDiv = {%uU, %uU, %uU},\n", pPlan->au8FoscDiv[0], pPlan->au8FoscDiv[1], pPlan->au8FoscDiv[2]);
+    printf("    .u8DivBus = %uU,\n", (unsigned)pPlan->u8DivBus);
+    printf("    .au8Pll0Div = {%uU, %uU, %uU},\n", pPlan->au8Pll0Div[0], pPlan->au8Pll0Div[1], pPlan->au8Pll0Div[2]);
+    printf("    .u8DivSlow = %uU,\n", (unsigned)pPlan->u8DivSlow);
+    printf("    .u32Crc = 0x%08lXU,\n", (unsigned long)pPlan->u32Crc);
+    printf("};\n");
+}
+
+/* ################################################################################## */
+/* ################################ Global Functions ################################ */
+
+int main(int argc, char **argv)
+{
+    SCG_ClockPlanType tPlan;
+    SCG_CalcResultType eResult;
+    const char *pOutFile = NULL;
+    FILE *pFile;
+    size_t u32Index;
+    int i = 1;
+
+    memset(&tPlan, 0, sizeof(tPlan));
+
+    while (i < argc)
+    {
+        if (strcmp(argv[i], "-fosc") == 0)
+        {
+            tPlan.u16Flags |= SCG_PLAN_FLAG_FOSC_EN;
+            tPlan.u32FoscFreq = ArgU32(argc, argv, i + 1);
+            i += 2;
+        }
+        else if (strcmp(argv[i], "-pll0") == 0)
+        {
+            tPlan.u16Flags |= SCG_PLAN_FLAG_PLL0_EN;
+            tPlan.u8Pll0Src = ArgSrc(argc, argv, i + 1);
+            tPlan.u8Pll0Prediv = (uint8_t)ArgU32(argc, argv, i + 2);
+            tPlan.u8Pll0Mult = (uint8_t)ArgU32(argc, argv, i + 3);
+            i += 4;
+        }
+        else if (strcmp(argv[i], "-sys") == 0)
+        {
+            tPlan.u8SysSrc = ArgSrc(argc, argv, i + 1);
+            tPlan.u8DivCore = (uint8_t)ArgU32(argc, argv, i + 2);
+            tPlan.u8DivBus = (uint8_t)ArgU32(argc, argv, i + 3);
+            tPlan.u8DivSlow = (uint8_t)ArgU32(argc, argv, i + 4);
+            i += 5;
+        }
+        else if (strcmp(argv[i], "-firc-div") == 0)
+        {
+            ArgDiv(argc, argv, i + 1, tPlan.au8FircDiv);
+            i += 4;
+        }
+        else if (strcmp(argv[i], "-fosc-div") == 0)
+        {
+            ArgDiv(argc, argv, i + 1, tPlan.au8FoscDiv);
+            i += 4;
+        }
+        else if (strcmp(argv[i], "-pll0-div") == 0)
+        {
+            ArgDiv(argc, argv, i + 1, tPlan.au8Pll0Div);
+            i += 4;
+        }
+        else if (strcmp(argv[i], "-o") == 0)
+        {
+            if ((i + 1) >= argc)
+            {
+                Usage();
+            }
+            pOutFile = argv[i + 1];
+            i += 2;
+        }
+        else
+        {
+            for (u32Index = 0U; u32Index < (sizeof(s_tFlagOpt) / sizeof(s_tFlagOpt[0])); u32Index++)
+            {
+                if (strcmp(argv[i], s_tFlagOpt[u32Index].pName) == 0)
+                {
+                    break;
+                }
+            }
+            if (u32Index == (sizeof(s_tFlagOpt) / sizeof(s_tFlagOpt[0])))
+            {
+                Usage();
+            }
+            tPlan.u16Flags |= s_tFlagOpt[u32Index].u16Flag;
+            i += 1;
+        }
+    }
+
+    eResult = SCG_CalcCheckPlan(&tPlan, NULL);
+    if (eResult != SCG_CALC_OK)
+    {
+        fprintf(stderr, "scg_plan_gen: illegal plan: %s\n", s_pResultText[eResult]);
+        return 1;
+    }
+
+    SCG_CalcSealPlan(&tPlan);
+
+    if (pOutFile == NULL)
+    {
+        PrintPlan(&tPlan);
+    }
+    else
+    {
+        pFile = fopen(pOutFile, "wb");
+        if ((pFile == NULL) || (fwrite(&tPlan, sizeof(tPlan), 1U, pFile) != 1U))
+        {
+            fprintf(stderr, "scg_plan_gen: cannot write %s\n", pOutFile);
+            return 1;
+        }
+        (void)fclose(pFile);
+    }
+
+    return 0;
+}
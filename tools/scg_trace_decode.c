@@ -0,0 +1,294 @@
+/**
+ * @file scg_trace_decode.c
+ * @author Flagchip
+ * @brief Host decoder of the SCG register write trace recorded with SCG_TRACE_ENABLE
+ * @version 0.1.0B
+ * @date 2023-09-07
+ *
+ * @copyright Copyright (c) 2020-2023 Flagchip Semiconductors Co., Ltd.
+ *
+ * Build on the host, from the driver directory:
+ *     cc -std=c99 -I. -o scg_trace_decode tools/scg_trace_decode.c
+ *
+ * Usage:
+ *     scg_trace_decode [-sym <nm output>] <trace.bin>
+ *
+ * trace.bin holds the entries returned by SCG_TraceDump, as raw little endian SCG_TraceEntryType
+ * records. With -sym, the caller address of each entry is resolved against the output of
+ * "nm -n <application.elf>" to the name of the driver function that did the write.
+ */
+
+/********************************************************************************
+*   Revision History:
+*
+*   Version     Date          Initials       CR#          Descriptions
+*   ---------   ----------    ------------   ----------   ---------------
+*   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
+********************************************************************************/
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fc4xxx_driver_scg_trace.h"
+
+/* ################################################################################## */
+/* ####################################### Macro #################################### */
+#define TRACE_ENTRY_SIZE    16U
+#define SYM_NAME_LEN        64U
+
+/* ################################################################################## */
+/* ################################### Type define ################################## */
+typedef enum
+{
+    FIELDS_NONE = 0U,
+    FIELDS_CSR,
+    FIELDS_CCR,
+    FIELDS_DIV,
+    FIELDS_PLL0CFG
+} FieldsType;
+
+typedef struct
+{
+    const char *pName;
+    FieldsType eFields;
+} TraceRegInfoType;
+
+typedef struct
+{
+    uint32_t u32Addr;
+    char acName[SYM_NAME_LEN];
+} SymType;
+
+/* ################################################################################## */
+/* ################################ Local Variables ################################# */
+static const TraceRegInfoType s_tRegInfo[SCG_TRACE_REG_NUM] =
+{
+    [SCG_TRACE_REG_CCR]         = {"CCR",        FIELDS_CCR},
+    [SCG_TRACE_REG_CLKOUTCFG]   = {"CLKOUTCFG",  FIELDS_NONE},
+    [SCG_TRACE_REG_FIRCCSR]     = {"FIRCCSR",    FIELDS_CSR},
+    [SCG_TRACE_REG_FIRCDIV]     = {"FIRCDIV",    FIELDS_DIV},
+    [SCG_TRACE_REG_FIRCCFG]     = {"FIRCCFG",    FIELDS_NONE},
+    [SCG_TRACE_REG_FIRCTCFG]    = {"FIRCTCFG",   FIELDS_NONE},
+    [SCG_TRACE_REG_SIRCCSR]     = {"SIRCCSR",    FIELDS_CSR},
+    [SCG_TRACE_REG_SIRCDIV]     = {"SIRCDIV",    FIELDS_DIV},
+    [SCG_TRACE_REG_SIRCTCFG]    = {"SIRCTCFG",   FIELDS_NONE},
+    [SCG_TRACE_REG_SIRC32KCSR]  = {"SIRC32KCSR", FIELDS_CSR},
+    [SCG_TRACE_REG_FOSCCSR]     = {"FOSCCSR",    FIELDS_CSR},
+    [SCG_TRACE_REG_FOSCDIV]     = {"FOSCDIV",    FIELDS_DIV},
+    [SCG_TRACE_REG_FOSCCFG]     = {"FOSCCFG",    FIELDS_NONE},
+    [SCG_TRACE_REG_SOSCCSR]     = {"SOSCCSR",    FIELDS_CSR},
+    [SCG_TRACE_REG_SOSCCFG]     = {"SOSCCFG",    FIELDS_NONE},
+    [SCG_TRACE_REG_PLL0CSR]     = {"PLL0CSR",    FIELDS_CSR},
+    [SCG_TRACE_REG_PLL0DIV]     = {"PLL0DIV",    FIELDS_DIV},
+    [SCG_TRACE_REG_PLL0CFG]     = {"PLL0CFG",    FIELDS_PLL0CFG},
+};
+
+static const char *const s_pOpText[] = {"write", "modify", "errclr"};
+
+static SymType *s_pSym;
+static size_t s_u32SymCount;
+
+/* ################################################################################## */
+/* ################################ Local Functions  ################################ */
+
+static void Usage(void)
+{
+    fprintf(stderr, "usage: scg_trace_decode [-sym <nm -n output>] <trace.bin>\n");
+    exit(2);
+}
+
+static uint32_t GetLe32(const uint8_t *pData)
+{
+    return (uint32_t)pData[0] | ((uint32_t)pData[1] << 8) | ((uint32_t)pData[2] << 16) | ((uint32_t)pData[3] << 24);
+}
+
+static void LoadSymbols(const char *pFileName)
+{
+    FILE *pFile = fopen(pFileName, "r");
+    char acLine[256];
+    unsigned long u32Addr;
+    char cType;
+    char acName[SYM_NAME_LEN];
+    size_t u32Cap = 0U;
+
+    if (pFile == NULL)
+    {
+        perror(pFileName);
+        exit(1);
+    }
+    while (fgets(acLine, (int)sizeof(acLine), pFile) != NULL)
+    {
+        if ((sscanf(acLine, "%lx %c %63s", &u32Addr, &cType, acName) == 3) && ((cType == 'T') || (cType == 't')))
+        {
+            if (s_u32SymCount == u32Cap)
+            {
+                u32Cap = (u32Cap == 0U) ? 256U : (u32Cap * 2U);
+                s_pSym = realloc(s_pSym, u32Cap * sizeof(SymType));
+                if (s_pSym == NULL)
+                {
+                    exit(1);
+                }
+            }
+            /* drop the thumb bit so return addresses compare against function starts */
+            s_pSym[s_u32SymCount].u32Addr = (uint32_t)u32Addr & ~1U;
+            strcpy(s_pSym[s_u32SymCount].acName, acName);
+            s_u32SymCount++;
+        }
+    }
+    fclose(pFile);
+}
+
+static void PrintCaller(uint32_t u32Caller)
+{
+    const SymType *pBest = NULL;
+    size_t u32Index;
+    char acText[SYM_NAME_LEN + 16U];
+
+    u32Caller &= ~1U;
+    for (u32Index = 0U; u32Index < s_u32SymCount; u32Index++)
+    {
+        if ((s_pSym[u32Index].u32Addr <= u32Caller) && ((pBest == NULL) || (s_pSym[u32Index].u32Addr > pBest->u32Addr)))
+        {
+            pBest = &s_pSym[u32Index];
+        }
+    }
+
+    if (pBest != NULL)
+    {
+        snprintf(acText, sizeof(acText), "%s+0x%lx", pBest->acName, (unsigned long)(u32Caller - pBest->u32Addr));
+    }
+    else
+    {
+        snprintf(acText, sizeof(acText), "0x%08lx", (unsigned long)u32Caller);
+    }
+    printf("  %-32s", acText);
+}
+
+static void PrintAsyncDiv(const char *pName, uint32_t u32Div, uint32_t u32En)
+{
+    if (u32Div == 0U)
+    {
+        printf(" %s=off", pName);
+    }
+    else
+    {
+        printf(" %s=/%u", pName, 1U << (u32Div - 1U));
+    }
+    printf("%s", (u32En != 0U) ? "" : "(dis)");
+}
+
+static void PrintFields(FieldsType eFields, uint32_t u32Value)
+{
+    uint32_t u32Scs;
+
+    switch (eFields)
+    {
+    case FIELDS_CSR:
+        printf(" EN=%u", u32Value & 1U);
+        break;
+    case FIELDS_CCR:
+        u32Scs = (u32Value >> 24) & 0xFU;
+        printf(" SCS=%s DIVCORE=/%u DIVBUS=/%u DIVSLOW=/%u",
+               (u32Scs == 1U) ? "FOSC" : ((u32Scs == 3U) ? "FIRC" : ((u32Scs == 6U) ? "PLL0" : "?")),
+               ((u32Value >> 16) & 0xFU) + 1U, ((u32Value >> 4) & 0xFU) + 1U, (u32Value & 0xFU) + 1U);
+        break;
+    case FIELDS_DIV:
+        PrintAsyncDiv("DIVH", (u32Value >> 16) & 7U, (u32Value >> 23) & 1U);
+        PrintAsyncDiv("DIVM", (u32Value >> 8) & 7U, (u32Value >> 15) & 1U);
+        PrintAsyncDiv("DIVL", u32Value & 7U, (u32Value >> 7) & 1U);
+        break;
+    case FIELDS_PLL0CFG:
+        printf(" SOURCE=%s PREDIV=/%u MULT=x%u", (((u32Value >> 16) & 1U) != 0U) ? "FIRC" : "FOSC",
+               (u32Value & 7U) + 1U, ((u32Value >> 8) & 0x3FU) + 16U);
+        break;
+    default:
+        break;
+    }
+}
+
+/* ################################################################################## */
+/* ################################ Global Functions ################################ */
+
+int main(int argc, char **argv)
+{
+    const char *pTraceFile = NULL;
+    FILE *pFile;
+    uint8_t au8Raw[TRACE_ENTRY_SIZE];
+    SCG_TraceEntryType tEntry;
+    uint32_t u32PrevCycles = 0U;
+    uint16_t u16NextSeq = 0U;
+    bool bFirst = true;
+    int i = 1;
+
+    while (i < argc)
+    {
+        if ((strcmp(argv[i], "-sym") == 0) && ((i + 1) < argc))
+        {
+            LoadSymbols(argv[i + 1]);
+            i += 2;
+        }
+        else if ((argv[i][0] != '-') && (pTraceFile == NULL))
+        {
+            pTraceFile = argv[i];
+            i++;
+        }
+        else
+        {
+            Usage();
+        }
+    }
+    if (pTraceFile == NULL)
+    {
+        Usage();
+    }
+
+    pFile = fopen(pTraceFile, "rb");
+    if (pFile == NULL)
+    {
+        perror(pTraceFile);
+        return 1;
+    }
+
+    printf("%5s %10s %8s  %-32s %-10s %-6s %-10s fields\n", "seq", "cycles", "delta", "caller", "register", "op", "value");
+    while (fread(au8Raw, 1U, TRACE_ENTRY_SIZE, pFile) == TRACE_ENTRY_SIZE)
+    {
+        tEntry.u32Cycles = GetLe32(&au8Raw[0]);
+        tEntry.u32Caller = GetLe32(&au8Raw[4]);
+        tEntry.u32Value = GetLe32(&au8Raw[8]);
+        tEntry.u16Seq = (uint16_t)((uint32_t)au8Raw[12] | ((uint32_t)au8Raw[13] << 8));
+        tEntry.u8Reg = au8Raw[14];
+        tEntry.u8Op = au8Raw[15];
+
+        if ((bFirst == false) && (tEntry.u16Seq != u16NextSeq))
+        {
+            printf("      ... %u entries lost\n", (unsigned)(uint16_t)(tEntry.u16Seq - u16NextSeq));
+        }
+
+        printf("%5u %10lu %8lu", (unsigned)tEntry.u16Seq, (unsigned long)tEntry.u32Cycles,
+               (unsigned long)((bFirst == true) ? 0U : (tEntry.u32Cycles - u32PrevCycles)));
+        PrintCaller(tEntry.u32Caller);
+        if (tEntry.u8Reg < (uint8_t)SCG_TRACE_REG_NUM)
+        {
+            printf(" %-10s", s_tRegInfo[tEntry.u8Reg].pName);
+        }
+        else
+        {
+            printf(" reg%-7u", (unsigned)tEntry.u8Reg);
+        }
+        printf(" %-6s 0x%08lx", (tEntry.u8Op <= (uint8_t)SCG_TRACE_OP_ERRCLEAR) ? s_pOpText[tEntry.u8Op] : "?",
+               (unsigned long)tEntry.u32Value);
+        if (tEntry.u8Reg < (uint8_t)SCG_TRACE_REG_NUM)
+        {
+            PrintFields(s_tRegInfo[tEntry.u8Reg].eFields, tEntry.u32Value);
+        }
+        printf("\n");
+
+        u32PrevCycles = tEntry.u32Cycles;
+        u16NextSeq = (uint16_t)(tEntry.u16Seq + 1U);
+        bFirst = false;
+    }
+    fclose(pFile);
+    free(s_pSym);
+
+    return 0;
+}
@@ -0,0 +1,1189 @@
+/**
+ * @file scg_fault_bench.c
+ * @author Flagchip
+ * @brief Host fault injection bench of the SCG clock loss recovery on the SCG model
+ * @version 0.1.0B
+ * @date 2023-09-07
+ *
+ * @copyright Copyright (c) 2020-2023 Flagchip Semiconductors Co., Ltd.
+ *
+ * Build on the host, from the driver directory:
+ *     cc -std=c99 -I. -Itools/sim -o scg_fault_bench tools/sim/scg_fault_bench.c tools/sim/scg_sim.c
+ *
+ * Usage:
+ *     scg_fault_bench [-startup <SRC>=<cycles>]... [-ack <cycles>] [-uprd <cycles>] [-failover <cycles>]
+ *                     [-irq <cycles>] [-poll <cycles>] [-apoll <cycles>] [-write <cycles>] [-slow <cycles>]
+ *                     [-run <cycles>] [-tail <cycles>] [-boots <n>] [-ramp <loops>] [-refresh] [-v]
+ *
+ * The bench runs SCG_SetPLL0 (PLL0 from FOSC, PREDIV BY2, clock monitor on), SCG_SetClkCtrl to
+ * PLL0, an application phase of -run cycles on PLL0 and SCG_Deinit against the model, starting on
+ * FIRC / 2 with FOSC running. The driver reads the registers through the device header and does not
+ * build on the host, the bench is a hand transcription of its sequences and has to follow them:
+ * - SCG_SetPLL0 starts the async job in a critical section (SCG_SeqWritePll0Cfg with the PREDIV BY4
+ *   pulse, PLL0CSR EN) and SCG_AsyncWait steps it with SCG_PollAsync, one critical section per poll.
+ *   The lock deadline is learned from the retained startup history, -boots fault free boots fill it
+ *   first, and every phase expires on its cycle deadline or its poll budget (deadline / 8 polls).
+ * - SCG_SetClkCtrl switches with SCG_SwitchCcr, or with SCG_RampCcr and dwells of -ramp loops.
+ * - SCG_IRQHandler clears each ERR right after reading it, notifies and polls the async job.
+ * - SCG_Deinit audits the clock tree, switches back to FIRC and tears the other sources down.
+ * Every write costs -write cycles, every busy wait poll -poll cycles, every SCG_PollAsync -apoll
+ * cycles and every dwell loop 8 cycles. SCG_IRQHandler runs -irq cycles after a monitored source
+ * reports ERR, once the driver is outside its critical sections.
+ *
+ * Each fault is injected before every register write of the sequence in turn, at the start of the
+ * application phase and after the last write, the run then continues for -tail cycles. From the
+ * injection the bench measures the time until the system runs on a valid clock and the time until
+ * the clock tree of the driver (system clock, FIRC, FOSC and PLL0 status) matches the model outside
+ * the API calls, and prints the worst case of each fault.
+ * "never" means the state was not reached by the end of the run. With -refresh the clock error
+ * notification calls SCG_Audit, the register hash of SCG_Audit is not modelled so it always re-reads.
+ */
+
+/********************************************************************************
+*   Revision History:
+*
+*   Version     Date          Initials       CR#          Descriptions
+*   ---------   ----------    ------------   ----------   ---------------
+*   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
+********************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "scg_sim.h"
+
+/* ################################################################################## */
+/* ####################################### Macro #################################### */
+
+/* timeouts of the driver in wait loops, a wait loop is SCG_WAIT_LOOP_CYCLES cycles */
+#define PLL0_STABILIZATION_TIMEOUT          320500U
+#define SCG_CLKSRC_STABILIZATION_TIMEOUT    1000U
+#define CLOCK_OFF_STABILIZATION_TIMEOUT     1000U
+#define CLOCK_DIV_STABILIZATION_TIMEOUT     1000U
+#define SCG_WAIT_LOOP_CYCLES                8U
+#define PLL0_PULSE_NOPS                     200U
+
+/* adaptive startup deadline of SCG_GetStartupDeadline */
+#define SCG_STARTUP_HISTORY_LEN             8U
+#define SCG_STARTUP_HISTORY_MIN             2U
+#define SCG_STARTUP_MARGIN_MUL              2U
+#define SCG_STARTUP_MARGIN_ADD              (1000U * SCG_WAIT_LOOP_CYCLES)
+
+/* core clock ramp of SCG_RampCcr */
+#define SCG_RAMP_DIVCORE_RANGE              16U
+#define SCG_RAMP_DWELL_MAX                  2000U
+
+/* register values of the sequence, the model does not look at the dividers */
+#define CCR_SCS_FIRC        (3U << 24U)
+#define CCR_SCS_PLL0        (6U << 24U)
+#define CCR_SCS_MASK        (0xFU << 24U)
+#define CCR_DIVCORE(x)      ((uint32_t)(x) << 16U)
+#define CCR_DIVCORE_MASK    (0xFU << 16U)
+#define PLL0CFG_BY4         3U
+#define PLL0CFG_BY2         1U
+#define DIV_ALL_EN          (SCG_SIM_DIV_EN(0U) | SCG_SIM_DIV_EN(1U) | SCG_SIM_DIV_EN(2U))
+#define DIV_ALL_ACK         (SCG_SIM_DIV_ACK(0U) | SCG_SIM_DIV_ACK(1U) | SCG_SIM_DIV_ACK(2U))
+#define PLL0DIV_VALUE       0x00010203U
+
+/* SCG_SetPLL0, SCG_SetClkCtrl, application phase, SCG_Deinit */
+#define API_NUM             4U
+#define API_RUN             2U
+#define MAX_POINTS          64U
+#define NEVER               SCG_SIM_NEVER
+
+/* ################################################################################## */
+/* ################################### Type define ################################## */
+
+/* driver status values reported by the sequences */
+typedef enum
+{
+    ST_VALID = 0,
+    ST_DISABLE,
+    ST_TIMEOUT,
+    ST_SEQUENCE_ERROR,
+    ST_ERROR
+} StatusType;
+
+/* phases of the PLL0 job of s_tAsyncJob */
+typedef enum
+{
+    JOB_IDLE = 0,
+    JOB_PLL0_LOCK,
+    JOB_PLL0_DIV_OFF,
+    JOB_PLL0_DIV_ON,
+    JOB_DONE
+} PhaseType;
+
+/* PLL0 slot of s_tStartupHistory, samples in cycles */
+typedef struct
+{
+    uint32_t au32Sample[SCG_STARTUP_HISTORY_LEN];
+    uint8_t u8Count;
+    uint8_t u8Next;
+} HistoryType;
+
+/* s_tAsyncJob and the SCG_AsyncWaitType record of the blocking setter */
+typedef struct
+{
+    PhaseType ePhase;
+    uint64_t u64Start;
+    uint32_t u32Deadline;
+    uint32_t u32Budget;
+    StatusType eStatus;
+    bool bWaitDone;
+    StatusType eWaitStatus;
+} JobType;
+
+/* clock tree of the driver, what s_tClockSequenceInfo holds */
+typedef struct
+{
+    SCG_SimSrcType eSys;
+    bool abValid[SCG_SIM_SRC_NUM];
+    uint32_t u32CoreFreq;
+} ViewType;
+
+typedef struct
+{
+    uint32_t u32Write;
+    uint32_t u32Poll;
+    uint32_t u32AsyncPoll;
+    uint32_t u32Irq;
+    uint32_t u32Run;
+    uint32_t u32Tail;
+    uint32_t u32Dwell;
+    bool bRamp;
+    bool bRefresh;
+} CostType;
+
+typedef struct
+{
+    SCG_SimType tSim;
+    ViewType tView;
+    JobType tJob;
+    HistoryType tHistory;
+    uint64_t u64Now;
+    uint32_t u32Sites;
+    uint32_t au32ApiSites[API_NUM];
+    uint8_t u8Api;
+    bool bInApi;
+    bool bCritical;
+
+    /* fault */
+    uint32_t u32FaultSite;
+    SCG_SimFaultType tFault;
+    bool bInjected;
+
+    /* clock error interrupt */
+    bool bIrqPending;
+    bool bInIrq;
+    uint64_t u64IrqAt;
+    uint32_t u32IrqCount;
+
+    /* measurement from the injection */
+    bool bSysValid;
+    bool bConsistent;
+    uint64_t u64SysValidAt;
+    uint64_t u64ConsistentAt;
+    StatusType aeStatus[API_NUM];
+} BenchType;
+
+typedef struct
+{
+    const char *pName;
+    SCG_SimFaultKindType eKind;
+    SCG_SimSrcType eSrc;
+} ScenarioType;
+
+/* ################################################################################## */
+/* ################################ Local Variables ################################# */
+static const char *const s_pApiName[API_NUM] =
+{
+    "SCG_SetPLL0", "SCG_SetClkCtrl", "run", "SCG_Deinit"
+};
+
+static const char *const s_pStatusName[] =
+{
+    "VALID", "DISABLE", "TIMEOUT", "SEQ_ERR", "ERROR"
+};
+
+static const ScenarioType s_tScenario[] =
+{
+    {"FOSC loss", SCG_SIM_FAULT_OSC_LOSS, SCG_SIM_SRC_FOSC},
+    {"PLL0 loss", SCG_SIM_FAULT_OSC_LOSS, SCG_SIM_SRC_PLL0},
+    {"PLL0 stuck lock", SCG_SIM_FAULT_STUCK_LOCK, SCG_SIM_SRC_PLL0},
+    {"PLL0DIV slow ACK", SCG_SIM_FAULT_SLOW_ACK, SCG_SIM_SRC_PLL0},
+    {"CCR UPRD timeout", SCG_SIM_FAULT_UPRD_TIMEOUT, SCG_SIM_SRC_NONE},
+};
+
+/* sources with the clock monitor enabled by the sequence, in SCG_IRQHandler read order */
+static const SCG_SimSrcType s_eMonitored[2U] =
+{
+    SCG_SIM_SRC_PLL0, SCG_SIM_SRC_FOSC
+};
+
+static const SCG_TraceRegType s_eCsrReg[SCG_SIM_SRC_NUM] =
+{
+    SCG_TRACE_REG_FIRCCSR, SCG_TRACE_REG_SIRCCSR, SCG_TRACE_REG_SIRC32KCSR,
+    SCG_TRACE_REG_FOSCCSR, SCG_TRACE_REG_SOSCCSR, SCG_TRACE_REG_PLL0CSR
+};
+
+/* nominal frequencies, only the ratios matter to the ramp */
+static const uint32_t s_u32SrcFreq[SCG_SIM_SRC_NUM] =
+{
+    96000000U, 12000000U, 32768U, 24000000U, 32768U, 150000000U
+};
+
+static CostType s_tCost = {2U, 6U, 40U, 12U, 20000U, 100000U, 0U, false, false};
+
+/* startup history retained from the previous boots, every run starts from it */
+static HistoryType s_tSeed;
+
+/* ################################################################################## */
+/* ########################### Local Prototype Functions ############################ */
+static void Tick(BenchType *pBench);
+static void Track(BenchType *pBench);
+
+/* ################################################################################## */
+/* ################################ Local Functions  ################################ */
+
+static void Usage(void)
+{
+    fprintf(stderr, "usage: scg_fault_bench [-startup SRC=cycles]... [-ack cycles] [-uprd cycles] [-failover cycles] "
+            "[-irq cycles] [-poll cycles] [-apoll cycles] [-write cycles] [-slow cycles] [-run cycles] "
+            "[-tail cycles] [-boots n] [-ramp loops] [-refresh] [-v]\n");
+    exit(2);
+}
+
+static void ParseStartup(SCG_SimTimingType *pTiming, const char *pArg)
+{
+    const char *pEq = strchr(pArg, '=');
+    uint8_t u8Src;
+    bool bFound = false;
+
+    if (pEq != NULL)
+    {
+        for (u8Src = 0U; u8Src < (uint8_t)SCG_SIM_SRC_NUM; u8Src++)
+        {
+            if ((strlen(SCG_SimSrcName((SCG_SimSrcType)u8Src)) == (size_t)(pEq - pArg)) &&
+                    (strncmp(SCG_SimSrcName((SCG_SimSrcType)u8Src), pArg, (size_t)(pEq - pArg)) == 0))
+            {
+                pTiming->au32Startup[u8Src] = (uint32_t)strtoul(pEq + 1, NULL, 0);
+                bFound = true;
+            }
+        }
+    }
+    if (bFound == false)
+    {
+        Usage();
+    }
+}
+
+static uint32_t Read(const BenchType *pBench, SCG_TraceRegType eReg)
+{
+    return SCG_SimRead(&pBench->tSim, eReg, pBench->u64Now);
+}
+
+static bool IsValid(const BenchType *pBench, SCG_SimSrcType eSrc)
+{
+    return ((Read(pBench, s_eCsrReg[eSrc]) & SCG_SIM_CSR_VLD) != 0U);
+}
+
+/* CCR value in effect, the written one once UPRD is done */
+static uint32_t SysCcr(const BenchType *pBench)
+{
+    return (pBench->u64Now >= pBench->tSim.u64UprdAt) ? pBench->tSim.au32Reg[SCG_TRACE_REG_CCR] :
+           pBench->tSim.u32SysCcr;
+}
+
+/* activate the fault now, the measurement starts from the current state */
+static void Inject(BenchType *pBench)
+{
+    pBench->tFault.u64At = pBench->u64Now;
+    SCG_SimInjectFault(&pBench->tSim, &pBench->tFault);
+    pBench->bInjected = true;
+    pBench->bSysValid = false;
+    pBench->bConsistent = false;
+    pBench->u64SysValidAt = NEVER;
+    pBench->u64ConsistentAt = NEVER;
+    Track(pBench);
+}
+
+/* injection site, before every write and at the start of the application phase */
+static void Site(BenchType *pBench)
+{
+    if ((pBench->bInjected == false) && (pBench->u32Sites == pBench->u32FaultSite))
+    {
+        Inject(pBench);
+    }
+    pBench->u32Sites++;
+    pBench->au32ApiSites[pBench->u8Api]++;
+}
+
+static void Write(BenchType *pBench, SCG_TraceRegType eReg, uint32_t u32Value)
+{
+    Site(pBench);
+    SCG_SimWrite(&pBench->tSim, eReg, u32Value, pBench->u64Now);
+    pBench->u64Now += s_tCost.u32Write;
+    Tick(pBench);
+}
+
+static void EnterApi(BenchType *pBench, uint8_t u8Api)
+{
+    pBench->u8Api = u8Api;
+    pBench->bInApi = true;
+}
+
+/* the clock tree is compared with the model when the API returns */
+static void ExitApi(BenchType *pBench)
+{
+    pBench->bInApi = false;
+    if (pBench->bInjected == true)
+    {
+        Track(pBench);
+    }
+}
+
+/* SCG_ENTER_CRITICAL */
+static void EnterCritical(BenchType *pBench)
+{
+    pBench->bCritical = true;
+}
+
+/* SCG_EXIT_CRITICAL, a pending clock error interrupt is taken here */
+static void ExitCritical(BenchType *pBench)
+{
+    pBench->bCritical = false;
+    Tick(pBench);
+}
+
+/* one poll iteration of a driver busy wait */
+static void Poll(BenchType *pBench)
+{
+    pBench->u64Now += s_tCost.u32Poll;
+    Tick(pBench);
+}
+
+/* SCG_SetPll0ClockStatus, SCG_SetFoscClockStatus */
+static void RefreshSrc(BenchType *pBench, SCG_SimSrcType eSrc)
+{
+    pBench->tView.abValid[eSrc] = IsValid(pBench, eSrc);
+}
+
+/* SCG_SetCoreClockStatus, eRunClock only changes when the new source is valid in the tree */
+static void RefreshCore(BenchType *pBench)
+{
+    SCG_SimSrcType eSys = SCG_SimGetSysSrc(&pBench->tSim, pBench->u64Now);
+
+    if ((eSys < SCG_SIM_SRC_NUM) && (pBench->tView.abValid[eSys] == true))
+    {
+        pBench->tView.eSys = eSys;
+        pBench->tView.u32CoreFreq = s_u32SrcFreq[eSys] / (((SysCcr(pBench) & CCR_DIVCORE_MASK) >> 16U) + 1U);
+    }
+}
+
+/* SCG_Audit: the clock tree re-read from the registers, SCG_ReadClockTree */
+static void Audit(BenchType *pBench)
+{
+    uint8_t u8Src;
+
+    for (u8Src = 0U; u8Src < (uint8_t)SCG_SIM_SRC_NUM; u8Src++)
+    {
+        RefreshSrc(pBench, (SCG_SimSrcType)u8Src);
+    }
+    RefreshCore(pBench);
+}
+
+static void Track(BenchType *pBench)
+{
+    SCG_SimSrcType eSys = SCG_SimGetSysSrc(&pBench->tSim, pBench->u64Now);
+    bool bSysValid = SCG_SimIsValid(&pBench->tSim, eSys, pBench->u64Now);
+    bool bConsistent = (pBench->tView.eSys == eSys) && (pBench->bInApi == false);
+    uint8_t u8Src;
+
+    for (u8Src = 0U; u8Src < (uint8_t)SCG_SIM_SRC_NUM; u8Src++)
+    {
+        if (((u8Src == (uint8_t)SCG_SIM_SRC_FIRC) || (u8Src == (uint8_t)SCG_SIM_SRC_FOSC) ||
+                (u8Src == (uint8_t)SCG_SIM_SRC_PLL0)) &&
+                (pBench->tView.abValid[u8Src] != SCG_SimIsValid(&pBench->tSim, (SCG_SimSrcType)u8Src, pBench->u64Now)))
+        {
+            bConsistent = false;
+        }
+    }
+
+    if (bSysValid != pBench->bSysValid)
+    {
+        pBench->bSysValid = bSysValid;
+        pBench->u64SysValidAt = (bSysValid == true) ? pBench->u64Now : NEVER;
+    }
+    /* inside an API the tree lags the registers by design, only the state seen by the caller counts */
+    if ((pBench->bInApi == false) && (bConsistent != pBench->bConsistent))
+    {
+        pBench->bConsistent = bConsistent;
+        pBench->u64ConsistentAt = (bConsistent == true) ? pBench->u64Now : NEVER;
+    }
+}
+
+/* SCG_GetStartupDeadline of PLL0 in cycles */
+static uint32_t GetStartupDeadline(const BenchType *pBench)
+{
+    uint32_t u32Deadline = PLL0_STABILIZATION_TIMEOUT * SCG_WAIT_LOOP_CYCLES;
+    uint32_t u32Max = 0U;
+    uint8_t u8Index;
+
+    if (pBench->tHistory.u8Count >= SCG_STARTUP_HISTORY_MIN)
+    {
+        for (u8Index = 0U; u8Index < pBench->tHistory.u8Count; u8Index++)
+        {
+            if (pBench->tHistory.au32Sample[u8Index] > u32Max)
+            {
+                u32Max = pBench->tHistory.au32Sample[u8Index];
+            }
+        }
+        u32Deadline = (u32Max * SCG_STARTUP_MARGIN_MUL) + SCG_STARTUP_MARGIN_ADD;
+        if (u32Deadline > (PLL0_STABILIZATION_TIMEOUT * SCG_WAIT_LOOP_CYCLES))
+        {
+            u32Deadline = PLL0_STABILIZATION_TIMEOUT * SCG_WAIT_LOOP_CYCLES;
+        }
+    }
+
+    return u32Deadline;
+}
+
+/* SCG_RecordStartup, a timeout keeps the history */
+static void RecordStartup(BenchType *pBench, uint32_t u32Observed, bool bTimeout)
+{
+    if ((bTimeout == false) && (u32Observed != 0U))
+    {
+        pBench->tHistory.au32Sample[pBench->tHistory.u8Next] = u32Observed;
+        pBench->tHistory.u8Next = (uint8_t)((pBench->tHistory.u8Next + 1U) % SCG_STARTUP_HISTORY_LEN);
+        if (pBench->tHistory.u8Count < SCG_STARTUP_HISTORY_LEN)
+        {
+            pBench->tHistory.u8Count++;
+        }
+    }
+}
+
+/* SCG_ArmAsync */
+static void ArmAsync(BenchType *pBench, PhaseType ePhase, uint32_t u32Deadline)
+{
+    pBench->tJob.ePhase = ePhase;
+    pBench->tJob.u64Start = pBench->u64Now;
+    pBench->tJob.u32Deadline = u32Deadline;
+    pBench->tJob.u32Budget = u32Deadline / SCG_WAIT_LOOP_CYCLES;
+}
+
+/* SCG_IsAsyncExpired */
+static bool IsAsyncExpired(BenchType *pBench)
+{
+    bool bExpired = false;
+
+    if (((pBench->u64Now - pBench->tJob.u64Start) >= pBench->tJob.u32Deadline) || (pBench->tJob.u32Budget == 0U))
+    {
+        bExpired = true;
+    }
+    else
+    {
+        pBench->tJob.u32Budget--;
+    }
+
+    return bExpired;
+}
+
+/* SCG_FinishAsync of the PLL0 job */
+static void FinishAsync(BenchType *pBench)
+{
+    RefreshSrc(pBench, SCG_SIM_SRC_PLL0);
+    pBench->tJob.ePhase = JOB_DONE;
+}
+
+/* SCG_StepAsync, PLL0 phases */
+static void StepAsync(BenchType *pBench)
+{
+    uint32_t u32Temp;
+    bool bExpired = IsAsyncExpired(pBench);
+
+    switch (pBench->tJob.ePhase)
+    {
+    case JOB_PLL0_LOCK:
+        if (IsValid(pBench, SCG_SIM_SRC_PLL0) == true)
+        {
+            RecordStartup(pBench, (uint32_t)(pBench->u64Now - pBench->tJob.u64Start), false);
+            /* CM, then CMRE and LK, read-modify-write writes a set ERR back and clears it */
+            u32Temp = Read(pBench, SCG_TRACE_REG_PLL0CSR);
+            Write(pBench, SCG_TRACE_REG_PLL0CSR, u32Temp);
+            Write(pBench, SCG_TRACE_REG_PLL0CSR, u32Temp | SCG_SIM_CSR_LK);
+            pBench->tJob.eStatus = ST_VALID;
+            /* SCG_HWA_DiablePll0Div */
+            Write(pBench, SCG_TRACE_REG_PLL0DIV, Read(pBench, SCG_TRACE_REG_PLL0DIV) & ~(DIV_ALL_EN | DIV_ALL_ACK));
+            ArmAsync(pBench, JOB_PLL0_DIV_OFF, CLOCK_DIV_STABILIZATION_TIMEOUT * SCG_WAIT_LOOP_CYCLES);
+        }
+        else if (bExpired == true)
+        {
+            RecordStartup(pBench, pBench->tJob.u32Deadline, true);
+            pBench->tJob.eStatus = ST_TIMEOUT;
+            FinishAsync(pBench);
+        }
+        else
+        {
+        }
+        break;
+
+    case JOB_PLL0_DIV_OFF:
+        if (((Read(pBench, SCG_TRACE_REG_PLL0DIV) & DIV_ALL_ACK) == 0U) || (bExpired == true))
+        {
+            Write(pBench, SCG_TRACE_REG_PLL0DIV, PLL0DIV_VALUE);
+            Write(pBench, SCG_TRACE_REG_PLL0DIV, (Read(pBench, SCG_TRACE_REG_PLL0DIV) & ~DIV_ALL_ACK) | DIV_ALL_EN);
+            ArmAsync(pBench, JOB_PLL0_DIV_ON, CLOCK_DIV_STABILIZATION_TIMEOUT * SCG_WAIT_LOOP_CYCLES);
+        }
+        break;
+
+    case JOB_PLL0_DIV_ON:
+        if (((Read(pBench, SCG_TRACE_REG_PLL0DIV) & DIV_ALL_ACK) == DIV_ALL_ACK) || (bExpired == true))
+        {
+            FinishAsync(pBench);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/* SCG_PollAsync, the completion is SCG_AsyncWaitDone of the blocking setter */
+static void PollAsync(BenchType *pBench)
+{
+    bool bDeliver = false;
+
+    EnterCritical(pBench);
+    pBench->u64Now += s_tCost.u32AsyncPoll;
+    if (pBench->tJob.ePhase == JOB_DONE)
+    {
+        pBench->tJob.ePhase = JOB_IDLE;
+        bDeliver = true;
+    }
+    else
+    {
+        StepAsync(pBench);
+    }
+    ExitCritical(pBench);
+
+    if (bDeliver == true)
+    {
+        pBench->tJob.eWaitStatus = pBench->tJob.eStatus;
+        pBench->tJob.bWaitDone = true;
+    }
+}
+
+/* SCG_AsyncWait */
+static StatusType AsyncWait(BenchType *pBench)
+{
+    while (pBench->tJob.bWaitDone == false)
+    {
+        PollAsync(pBench);
+    }
+
+    return pBench->tJob.eWaitStatus;
+}
+
+/* SCG_IRQHandler: each monitored CSR read once and its ERR cleared right away with the value read,
+   then the notifications and one SCG_PollAsync */
+static void IrqHandler(BenchType *pBench)
+{
+    uint32_t u32Csr;
+    uint32_t u32Pending = 0U;
+    uint8_t u8Slot;
+
+    pBench->bInIrq = true;
+    pBench->u64Now += s_tCost.u32Irq;
+    pBench->u32IrqCount++;
+    for (u8Slot = 0U; u8Slot < 2U; u8Slot++)
+    {
+        u32Csr = Read(pBench, s_eCsrReg[s_eMonitored[u8Slot]]);
+        if ((u32Csr & SCG_SIM_CSR_ERR) != 0U)
+        {
+            SCG_SimWrite(&pBench->tSim, s_eCsrReg[s_eMonitored[u8Slot]], u32Csr, pBench->u64Now);
+            pBench->u64Now += s_tCost.u32Write;
+            u32Pending |= 1UL << u8Slot;
+        }
+    }
+    for (u8Slot = 0U; u8Slot < 2U; u8Slot++)
+    {
+        if (((u32Pending & (1UL << u8Slot)) != 0U) && (s_tCost.bRefresh == true))
+        {
+            Audit(pBench);
+        }
+    }
+    PollAsync(pBench);
+    pBench->bInIrq = false;
+}
+
+static bool IsErrPending(const BenchType *pBench)
+{
+    uint32_t u32Csr;
+    uint8_t u8Slot;
+    bool bPending = false;
+
+    for (u8Slot = 0U; u8Slot < 2U; u8Slot++)
+    {
+        u32Csr = Read(pBench, s_eCsrReg[s_eMonitored[u8Slot]]);
+        if (((u32Csr & SCG_SIM_CSR_ERR) != 0U) && ((u32Csr & SCG_SIM_CSR_EN) != 0U))
+        {
+            bPending = true;
+        }
+    }
+
+    return bPending;
+}
+
+/* called after every write and poll: clock error interrupt and measurement */
+static void Tick(BenchType *pBench)
+{
+    if ((pBench->bIrqPending == false) && (IsErrPending(pBench) == true))
+    {
+        pBench->bIrqPending = true;
+        pBench->u64IrqAt = pBench->u64Now + s_tCost.u32Irq;
+    }
+    if ((pBench->bIrqPending == true) && (pBench->bCritical == false) && (pBench->bInIrq == false) &&
+            (pBench->u64Now >= pBench->u64IrqAt))
+    {
+        pBench->bIrqPending = false;
+        IrqHandler(pBench);
+    }
+    if (pBench->bInjected == true)
+    {
+        Track(pBench);
+    }
+}
+
+/* SCG_SwitchCcr */
+static StatusType SwitchCcr(BenchType *pBench, uint32_t u32Ccr, SCG_SimSrcType eSrc)
+{
+    StatusType eStatus = ST_VALID;
+    uint32_t u32Budget = SCG_CLKSRC_STABILIZATION_TIMEOUT;
+
+    Write(pBench, SCG_TRACE_REG_CCR, u32Ccr);
+    while ((SCG_SimIsUpdated(&pBench->tSim, pBench->u64Now) == false) && (u32Budget > 0U))
+    {
+        u32Budget--;
+        Poll(pBench);
+    }
+    if (u32Budget == 0U)
+    {
+        eStatus = ST_TIMEOUT;
+    }
+    else if (SCG_SimGetSysSrc(&pBench->tSim, pBench->u64Now) != eSrc)
+    {
+        eStatus = ST_ERROR;
+    }
+    else
+    {
+    }
+
+    return eStatus;
+}
+
+/* SCG_RampDwell, interrupts stay masked */
+static void RampDwell(BenchType *pBench, uint32_t u32Loops)
+{
+    pBench->u64Now += (uint64_t)u32Loops * SCG_WAIT_LOOP_CYCLES;
+    Tick(pBench);
+}
+
+/* SCG_RampCcr: step down on the current source, enter the target source at most at twice the
+   current clock and step up, the dwell of a step is spent before the next write */
+static StatusType RampCcr(BenchType *pBench, uint32_t u32Ccr, SCG_SimSrcType eSrc, uint32_t u32OldCoreFreq)
+{
+    StatusType eStatus = ST_VALID;
+    uint32_t u32CurCcr = Read(pBench, SCG_TRACE_REG_CCR);
+    uint32_t u32CurDiv = (u32CurCcr & CCR_DIVCORE_MASK) >> 16U;
+    uint32_t u32CurSrcFreq = u32OldCoreFreq * (u32CurDiv + 1U);
+    uint32_t u32CurFreq = u32OldCoreFreq;
+    uint32_t u32Div = (u32Ccr & CCR_DIVCORE_MASK) >> 16U;
+    uint32_t u32TargetFreq = s_u32SrcFreq[eSrc] / (u32Div + 1U);
+    uint32_t u32Dwell = 0U;
+    bool bDone = false;
+
+    while ((eStatus == ST_VALID) && (((u32CurDiv + 1U) * 2U) <= SCG_RAMP_DIVCORE_RANGE) &&
+            ((u32CurFreq / 2U) >= u32TargetFreq))
+    {
+        u32CurDiv = ((u32CurDiv + 1U) * 2U) - 1U;
+        u32CurFreq = u32CurSrcFreq / (u32CurDiv + 1U);
+        u32CurCcr = (u32CurCcr & ~CCR_DIVCORE_MASK) | CCR_DIVCORE(u32CurDiv);
+        RampDwell(pBench, u32Dwell);
+        eStatus = SwitchCcr(pBench, u32CurCcr, SCG_SimGetSysSrc(&pBench->tSim, pBench->u64Now));
+        u32Dwell = s_tCost.u32Dwell;
+    }
+
+    u32CurDiv = u32Div;
+    while ((((u32CurDiv + 1U) * 2U) <= SCG_RAMP_DIVCORE_RANGE) &&
+            ((s_u32SrcFreq[eSrc] / (u32CurDiv + 1U)) > (u32CurFreq * 2U)))
+    {
+        u32CurDiv = ((u32CurDiv + 1U) * 2U) - 1U;
+    }
+
+    while ((eStatus == ST_VALID) && (bDone == false))
+    {
+        u32CurCcr = (u32Ccr & ~CCR_DIVCORE_MASK) | CCR_DIVCORE(u32CurDiv);
+        if (u32CurCcr != Read(pBench, SCG_TRACE_REG_CCR))
+        {
+            RampDwell(pBench, u32Dwell);
+            eStatus = SwitchCcr(pBench, u32CurCcr, eSrc);
+            u32Dwell = s_tCost.u32Dwell;
+        }
+        if (u32CurDiv == u32Div)
+        {
+            bDone = true;
+        }
+        else
+        {
+            u32CurDiv = ((u32CurDiv + 1U) / 2U) - 1U;
+        }
+    }
+
+    return eStatus;
+}
+
+/* SCG_SetPLL0: SCG_StartPll0 in a critical section, then the async job steps of SCG_AsyncWait */
+static StatusType SetPll0(BenchType *pBench)
+{
+    StatusType eStatus;
+
+    EnterApi(pBench, 0U);
+    pBench->tJob.bWaitDone = false;
+    EnterCritical(pBench);
+    if (pBench->tView.eSys == SCG_SIM_SRC_PLL0)
+    {
+        pBench->tJob.eStatus = ST_SEQUENCE_ERROR;
+        FinishAsync(pBench);
+    }
+    else if (pBench->tView.abValid[SCG_SIM_SRC_FOSC] == false)
+    {
+        pBench->tJob.eStatus = ST_ERROR;
+        FinishAsync(pBench);
+    }
+    else
+    {
+        /* SCG_SeqWritePll0Cfg with the PREDIV BY4 pulse */
+        Write(pBench, SCG_TRACE_REG_PLL0CFG, PLL0CFG_BY4);
+        Write(pBench, SCG_TRACE_REG_PLL0CSR, SCG_SIM_CSR_EN);
+        pBench->u64Now += PLL0_PULSE_NOPS;
+        Write(pBench, SCG_TRACE_REG_PLL0CSR, 0U);
+        Write(pBench, SCG_TRACE_REG_PLL0CFG, PLL0CFG_BY2);
+        Write(pBench, SCG_TRACE_REG_PLL0CSR, SCG_SIM_CSR_EN);
+        ArmAsync(pBench, JOB_PLL0_LOCK, GetStartupDeadline(pBench));
+    }
+    ExitCritical(pBench);
+
+    eStatus = AsyncWait(pBench);
+    ExitApi(pBench);
+
+    return eStatus;
+}
+
+/* SCG_SetClkCtrl to PLL0: SCG_ApplyClkCtrl runs in one critical section, SCG_AsyncWait delivers */
+static StatusType SetClkCtrl(BenchType *pBench)
+{
+    StatusType eStatus = ST_ERROR;
+    uint32_t u32Ccr = CCR_SCS_PLL0 | CCR_DIVCORE(0U);
+
+    EnterApi(pBench, 1U);
+    pBench->tJob.bWaitDone = false;
+    EnterCritical(pBench);
+    if (pBench->tView.abValid[SCG_SIM_SRC_PLL0] == true)
+    {
+        if ((s_tCost.bRamp == true) && (pBench->tView.u32CoreFreq != 0U))
+        {
+            eStatus = RampCcr(pBench, u32Ccr, SCG_SIM_SRC_PLL0, pBench->tView.u32CoreFreq);
+        }
+        else
+        {
+            eStatus = SwitchCcr(pBench, u32Ccr, SCG_SIM_SRC_PLL0);
+        }
+    }
+    RefreshCore(pBench);
+    pBench->tJob.eStatus = eStatus;
+    pBench->tJob.ePhase = JOB_DONE;
+    ExitCritical(pBench);
+
+    eStatus = AsyncWait(pBench);
+    ExitApi(pBench);
+
+    return eStatus;
+}
+
+/* application phase on the new clock, interrupts enabled */
+static void RunApp(BenchType *pBench)
+{
+    uint64_t u64End = pBench->u64Now + s_tCost.u32Run;
+
+    pBench->u8Api = API_RUN;
+    Site(pBench);
+    while (pBench->u64Now < u64End)
+    {
+        Poll(pBench);
+    }
+}
+
+/* SCG_SwitchClkCtrlSrc(SCG_CLOCK_SRC_FIRC) */
+static StatusType SwitchToFirc(BenchType *pBench)
+{
+    StatusType eStatus = ST_ERROR;
+
+    RefreshSrc(pBench, SCG_SIM_SRC_FIRC);
+    EnterCritical(pBench);
+    if (pBench->tView.abValid[SCG_SIM_SRC_FIRC] == true)
+    {
+        eStatus = SwitchCcr(pBench, (Read(pBench, SCG_TRACE_REG_CCR) & ~CCR_SCS_MASK) | CCR_SCS_FIRC,
+                            SCG_SIM_SRC_FIRC);
+    }
+    if (eStatus == ST_VALID)
+    {
+        RefreshCore(pBench);
+    }
+    ExitCritical(pBench);
+
+    return eStatus;
+}
+
+/* SCG_Deinit: SCG_Audit, back to FIRC with SCG_SwitchClkCtrlSrc, then SCG_TeardownClockSources */
+static StatusType Deinit(BenchType *pBench)
+{
+    StatusType eStatus = ST_VALID;
+    uint32_t u32Budget;
+    bool bPll0On;
+    bool bFoscOn;
+
+    EnterApi(pBench, 3U);
+    Audit(pBench);
+    if (SCG_SimGetSysSrc(&pBench->tSim, pBench->u64Now) != SCG_SIM_SRC_FIRC)
+    {
+        eStatus = SwitchToFirc(pBench);
+        /* the SCG_SetFIRC retry finds FIRC configured already and switches again */
+        if (eStatus == ST_ERROR)
+        {
+            eStatus = SwitchToFirc(pBench);
+        }
+    }
+
+    if (eStatus == ST_VALID)
+    {
+        /* SOSC and SIRC32K are off in the bench */
+        bPll0On = ((Read(pBench, SCG_TRACE_REG_PLL0CSR) & SCG_SIM_CSR_EN) != 0U) &&
+                  (pBench->tView.eSys != SCG_SIM_SRC_PLL0);
+        bFoscOn = ((Read(pBench, SCG_TRACE_REG_FOSCCSR) & SCG_SIM_CSR_EN) != 0U) &&
+                  (pBench->tView.eSys != SCG_SIM_SRC_FOSC) && (pBench->tView.eSys != SCG_SIM_SRC_PLL0);
+        if (bPll0On == true)
+        {
+            Write(pBench, SCG_TRACE_REG_PLL0CSR, Read(pBench, SCG_TRACE_REG_PLL0CSR) & ~SCG_SIM_CSR_LK);
+            Write(pBench, SCG_TRACE_REG_PLL0CSR, Read(pBench, SCG_TRACE_REG_PLL0CSR) & ~SCG_SIM_CSR_EN);
+        }
+        if (bFoscOn == true)
+        {
+            Write(pBench, SCG_TRACE_REG_FOSCCSR, Read(pBench, SCG_TRACE_REG_FOSCCSR) & ~SCG_SIM_CSR_EN);
+        }
+        u32Budget = CLOCK_OFF_STABILIZATION_TIMEOUT;
+        while ((((bPll0On == true) && (IsValid(pBench, SCG_SIM_SRC_PLL0) == true)) ||
+                ((bFoscOn == true) && (IsValid(pBench, SCG_SIM_SRC_FOSC) == true))) && (u32Budget > 0U))
+        {
+            u32Budget--;
+            Poll(pBench);
+        }
+        RefreshSrc(pBench, SCG_SIM_SRC_PLL0);
+        RefreshSrc(pBench, SCG_SIM_SRC_FOSC);
+    }
+    ExitApi(pBench);
+
+    return eStatus;
+}
+
+/* reset state plus FOSC running on FIRC / 2, the clock tree read once as SCG_InitClockSrcStatus does */
+static void Setup(BenchType *pBench, const SCG_SimTimingType *pTiming)
+{
+    memset(pBench, 0, sizeof(BenchType));
+    pBench->u32FaultSite = 0xFFFFFFFFU;
+    pBench->tHistory = s_tSeed;
+    SCG_SimInit(&pBench->tSim, pTiming);
+    SCG_SimWrite(&pBench->tSim, SCG_TRACE_REG_CCR, CCR_SCS_FIRC | CCR_DIVCORE(1U), 0U);
+    SCG_SimWrite(&pBench->tSim, SCG_TRACE_REG_FOSCCSR, SCG_SIM_CSR_EN, 0U);
+    pBench->u64Now = pTiming->au32Startup[SCG_SIM_SRC_FOSC];
+    Audit(pBench);
+}
+
+/* run the sequence, the fault is injected at site u32FaultSite, at the end if past the last one */
+static void Run(BenchType *pBench, const SCG_SimTimingType *pTiming, const SCG_SimFaultType *pFault,
+                uint32_t u32FaultSite)
+{
+    uint64_t u64End;
+
+    Setup(pBench, pTiming);
+    if (pFault != NULL)
+    {
+        pBench->tFault = *pFault;
+        pBench->u32FaultSite = u32FaultSite;
+    }
+
+    pBench->aeStatus[0U] = SetPll0(pBench);
+    pBench->aeStatus[1U] = SetClkCtrl(pBench);
+    RunApp(pBench);
+    pBench->aeStatus[3U] = Deinit(pBench);
+
+    if ((pFault != NULL) && (pBench->bInjected == false))
+    {
+        /* injection after the last write */
+        Inject(pBench);
+    }
+    u64End = pBench->u64Now + s_tCost.u32Tail;
+    while (pBench->u64Now < u64End)
+    {
+        Poll(pBench);
+    }
+}
+
+static void PrintLatency(uint64_t u64Latency)
+{
+    if (u64Latency == NEVER)
+    {
+        printf(" %12s", "never");
+    }
+    else
+    {
+        printf(" %12llu", (unsigned long long)u64Latency);
+    }
+}
+
+/* name of an injection point, the API and the site index within it */
+static void PointName(char *pName, size_t u32Len, const uint32_t au32ApiSites[API_NUM], uint32_t u32Site)
+{
+    uint32_t u32Base = 0U;
+    uint8_t u8Api = 0U;
+
+    while ((u8Api < API_NUM) && (u32Site >= (u32Base + au32ApiSites[u8Api])))
+    {
+        u32Base += au32ApiSites[u8Api];
+        u8Api++;
+    }
+    if (u8Api < API_NUM)
+    {
+        snprintf(pName, u32Len, "%s#%lu", s_pApiName[u8Api], (unsigned long)(u32Site - u32Base));
+    }
+    else
+    {
+        snprintf(pName, u32Len, "end");
+    }
+}
+
+/* ################################################################################## */
+/* ################################ Global Functions ################################ */
+
+int main(int argc, char **argv)
+{
+    static BenchType s_tBench;
+    SCG_SimTimingType tTiming;
+    SCG_SimFaultType tFault;
+    uint32_t au32ApiSites[API_NUM];
+    uint32_t u32Total;
+    uint32_t u32Point;
+    uint32_t u32Never;
+    uint32_t u32Violations;
+    uint32_t u32Scenario;
+    uint32_t u32Slow = 20000U;
+    uint32_t u32Boots = 8U;
+    uint64_t u64Valid;
+    uint64_t u64Consistent;
+    uint64_t u64WorstValid;
+    uint64_t u64WorstConsistent;
+    char acPoint[32];
+    char acWorstValid[32];
+    char acWorstConsistent[32];
+    bool bVerbose = false;
+    int i = 1;
+
+    memset(&tTiming, 0, sizeof(tTiming));
+    tTiming.au32Startup[SCG_SIM_SRC_FOSC] = 50000U;
+    tTiming.au32Startup[SCG_SIM_SRC_PLL0] = 20000U;
+    tTiming.u32DivAck = 8U;
+    tTiming.u32Uprd = 4U;
+    tTiming.u32Failover = 64U;
+    while (i < argc)
+    {
+        if ((strcmp(argv[i], "-startup") == 0) && ((i + 1) < argc))
+        {
+            ParseStartup(&tTiming, argv[i + 1]);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-ack") == 0) && ((i + 1) < argc))
+        {
+            tTiming.u32DivAck = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-uprd") == 0) && ((i + 1) < argc))
+        {
+            tTiming.u32Uprd = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-failover") == 0) && ((i + 1) < argc))
+        {
+            tTiming.u32Failover = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-irq") == 0) && ((i + 1) < argc))
+        {
+            s_tCost.u32Irq = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-poll") == 0) && ((i + 1) < argc))
+        {
+            s_tCost.u32Poll = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-apoll") == 0) && ((i + 1) < argc))
+        {
+            s_tCost.u32AsyncPoll = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-write") == 0) && ((i + 1) < argc))
+        {
+            s_tCost.u32Write = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-slow") == 0) && ((i + 1) < argc))
+        {
+            u32Slow = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-run") == 0) && ((i + 1) < argc))
+        {
+            s_tCost.u32Run = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-tail") == 0) && ((i + 1) < argc))
+        {
+            s_tCost.u32Tail = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-boots") == 0) && ((i + 1) < argc))
+        {
+            u32Boots = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-ramp") == 0) && ((i + 1) < argc))
+        {
+            /* SCG_SetRampCfg caps the dwells */
+            s_tCost.u32Dwell = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            if (s_tCost.u32Dwell > SCG_RAMP_DWELL_MAX)
+            {
+                s_tCost.u32Dwell = SCG_RAMP_DWELL_MAX;
+            }
+            s_tCost.bRamp = true;
+            i += 2;
+        }
+        else if (strcmp(argv[i], "-refresh") == 0)
+        {
+            s_tCost.bRefresh = true;
+            i++;
+        }
+        else if (strcmp(argv[i], "-v") == 0)
+        {
+            bVerbose = true;
+            i++;
+        }
+        else
+        {
+            Usage();
+        }
+    }
+    if ((s_tCost.u32Poll == 0U) || (s_tCost.u32AsyncPoll == 0U))
+    {
+        /* the busy waits must make progress */
+        Usage();
+    }
+
+    /* fault free boots fill the retained startup history the measured runs start from */
+    for (u32Point = 0U; u32Point < u32Boots; u32Point++)
+    {
+        Run(&s_tBench, &tTiming, NULL, 0U);
+        s_tSeed = s_tBench.tHistory;
+    }
+
+    Setup(&s_tBench, &tTiming);
+    printf("PLL0 lock deadline %lu cycles after %lu boots, ramp %s\n", (unsigned long)GetStartupDeadline(&s_tBench),
+           (unsigned long)u32Boots, (s_tCost.bRamp == true) ? "on" : "off");
+
+    /* fault free run: injection sites of each API, the sequence must not break a rule */
+    Run(&s_tBench, &tTiming, NULL, 0U);
+    memcpy(au32ApiSites, s_tBench.au32ApiSites, sizeof(au32ApiSites));
+    u32Total = s_tBench.u32Sites;
+    u32Violations = 0U;
+    for (u32Point = 0U; u32Point < (uint32_t)SCG_SIM_RULE_NUM; u32Point++)
+    {
+        u32Violations += s_tBench.tSim.au32RuleCount[u32Point];
+    }
+    printf("fault free: %s %s, %s %s, %s %s, %lu sites, %llu cycles, %lu rule violations\n\n",
+           s_pApiName[0U], s_pStatusName[s_tBench.aeStatus[0U]], s_pApiName[1U], s_pStatusName[s_tBench.aeStatus[1U]],
+           s_pApiName[3U], s_pStatusName[s_tBench.aeStatus[3U]], (unsigned long)u32Total,
+           (unsigned long long)(s_tBench.u64Now - s_tCost.u32Tail), (unsigned long)u32Violations);
+    if (u32Total >= MAX_POINTS)
+    {
+        u32Total = MAX_POINTS - 1U;
+    }
+
+    printf("%-20s %12s %-22s %12s %-22s %6s %6s\n", "fault", "valid clock", "worst at", "consistent", "worst at",
+           "never", "rules");
+    for (u32Scenario = 0U; u32Scenario < (uint32_t)(sizeof(s_tScenario) / sizeof(s_tScenario[0U])); u32Scenario++)
+    {
+        tFault.eKind = s_tScenario[u32Scenario].eKind;
+        tFault.eSrc = s_tScenario[u32Scenario].eSrc;
+        tFault.u64At = 0U;
+        tFault.u32Extra = u32Slow;
+        u64WorstValid = 0U;
+        u64WorstConsistent = 0U;
+        snprintf(acWorstValid, sizeof(acWorstValid), "-");
+        snprintf(acWorstConsistent, sizeof(acWorstConsistent), "-");
+        u32Never = 0U;
+        u32Violations = 0U;
+
+        for (u32Point = 0U; u32Point <= u32Total; u32Point++)
+        {
+            Run(&s_tBench, &tTiming, &tFault, u32Point);
+            PointName(acPoint, sizeof(acPoint), au32ApiSites, u32Point);
+            u64Valid = (s_tBench.u64SysValidAt == NEVER) ? NEVER : (s_tBench.u64SysValidAt - s_tBench.tFault.u64At);
+            u64Consistent = (s_tBench.u64ConsistentAt == NEVER) ? NEVER :
+                            (s_tBench.u64ConsistentAt - s_tBench.tFault.u64At);
+            if ((u64Valid == NEVER) || (u64Consistent == NEVER))
+            {
+                u32Never++;
+            }
+            if ((u64WorstValid != NEVER) && (u64Valid >= u64WorstValid))
+            {
+                u64WorstValid = u64Valid;
+                snprintf(acWorstValid, sizeof(acWorstValid), "%s", acPoint);
+            }
+            if ((u64WorstConsistent != NEVER) && (u64Consistent >= u64WorstConsistent))
+            {
+                u64WorstConsistent = u64Consistent;
+                snprintf(acWorstConsistent, sizeof(acWorstConsistent), "%s", acPoint);
+            }
+            for (i = 0; i < (int)SCG_SIM_RULE_NUM; i++)
+            {
+                u32Violations += s_tBench.tSim.au32RuleCount[i];
+            }
+
+            if (bVerbose == true)
+            {
+                printf("  %-18s %-22s", s_tScenario[u32Scenario].pName, acPoint);
+                PrintLatency(u64Valid);
+                PrintLatency(u64Consistent);
+                printf("  %s %s %s, %lu irq\n", s_pStatusName[s_tBench.aeStatus[0U]],
+                       s_pStatusName[s_tBench.aeStatus[1U]], s_pStatusName[s_tBench.aeStatus[3U]],
+                       (unsigned long)s_tBench.u32IrqCount);
+            }
+        }
+
+        printf("%-20s", s_tScenario[u32Scenario].pName);
+        PrintLatency(u64WorstValid);
+        printf(" %-22s", acWorstValid);
+        PrintLatency(u64WorstConsistent);
+        printf(" %-22s %6lu %6lu\n", acWorstConsistent, (unsigned long)u32Never, (unsigned long)u32Violations);
+    }
+
+    return 0;
+}
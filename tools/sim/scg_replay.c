@@ -0,0 +1,400 @@
+/**
+ * @file scg_replay.c
+ * @author Flagchip
+ * @brief Host replay of a SCG register write trace through the SCG model
+ * @version 0.1.0B
+ * @date 2023-09-07
+ *
+ * @copyright Copyright (c) 2020-2023 Flagchip Semiconductors Co., Ltd.
+ *
+ * Build on the host, from the driver directory:
+ *     cc -std=c99 -I. -Itools/sim -o scg_replay tools/sim/scg_replay.c tools/sim/scg_sim.c
+ *
+ * Usage:
+ *     scg_replay [-startup <SRC>=<cycles>]... [-ack <cycles>] [-uprd <cycles>] [-sym <nm output>] <trace.bin>
+ *
+ * trace.bin is the SCG_TraceDump output also read by tools/scg_trace_decode.c. Every entry is applied
+ * to the model at its recorded cycle count, broken sequencing rules are printed next to the entry.
+ * The time up to the next entry is attributed to the phase started by the entry (oscillator
+ * startup, divider handshake, PLL0 erratum pulse, system clock switch, ...) and a per phase
+ * summary is printed at the end. The model timing only decides the rule checks, the phase times
+ * are the measured ones.
+ */
+
+/********************************************************************************
+*   Revision History:
+*
+*   Version     Date          Initials       CR#          Descriptions
+*   ---------   ----------    ------------   ----------   ---------------
+*   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
+********************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "scg_sim.h"
+
+/* ################################################################################## */
+/* ####################################### Macro #################################### */
+#define TRACE_ENTRY_SIZE    16U
+#define SYM_NAME_LEN        64U
+#define PHASE_NAME_LEN      32U
+#define PHASE_MAX           64U
+
+/* control bits kept from a MODIFY read back */
+#define CSR_CTRL_MASK       (~(SCG_SIM_CSR_VLD | SCG_SIM_CSR_ERR))
+#define DIV_CTRL_MASK       (~(SCG_SIM_DIV_ACK(0U) | SCG_SIM_DIV_ACK(1U) | SCG_SIM_DIV_ACK(2U)))
+
+/* ################################################################################## */
+/* ################################### Type define ################################## */
+typedef struct
+{
+    uint32_t u32Addr;
+    char acName[SYM_NAME_LEN];
+} SymType;
+
+typedef struct
+{
+    char acName[PHASE_NAME_LEN];
+    uint32_t u32Count;
+    uint64_t u64Total;
+    uint64_t u64Max;
+} PhaseType;
+
+/* ################################################################################## */
+/* ################################ Local Variables ################################# */
+static SymType *s_pSym;
+static size_t s_u32SymCount;
+static PhaseType s_tPhase[PHASE_MAX];
+static uint32_t s_u32PhaseCount;
+
+/* ################################################################################## */
+/* ################################ Local Functions  ################################ */
+
+static void Usage(void)
+{
+    fprintf(stderr, "usage: scg_replay [-startup SRC=cycles]... [-ack cycles] [-uprd cycles] [-sym <nm -n output>] "
+            "<trace.bin>\n");
+    exit(2);
+}
+
+static uint32_t GetLe32(const uint8_t *pData)
+{
+    return (uint32_t)pData[0] | ((uint32_t)pData[1] << 8) | ((uint32_t)pData[2] << 16) | ((uint32_t)pData[3] << 24);
+}
+
+static void LoadSymbols(const char *pFileName)
+{
+    FILE *pFile = fopen(pFileName, "r");
+    char acLine[256];
+    unsigned long u32Addr;
+    char cType;
+    char acName[SYM_NAME_LEN];
+    size_t u32Cap = 0U;
+
+    if (pFile == NULL)
+    {
+        perror(pFileName);
+        exit(1);
+    }
+    while (fgets(acLine, (int)sizeof(acLine), pFile) != NULL)
+    {
+        if ((sscanf(acLine, "%lx %c %63s", &u32Addr, &cType, acName) == 3) && ((cType == 'T') || (cType == 't')))
+        {
+            if (s_u32SymCount == u32Cap)
+            {
+                u32Cap = (u32Cap == 0U) ? 256U : (u32Cap * 2U);
+                s_pSym = realloc(s_pSym, u32Cap * sizeof(SymType));
+                if (s_pSym == NULL)
+                {
+                    exit(1);
+                }
+            }
+            s_pSym[s_u32SymCount].u32Addr = (uint32_t)u32Addr & ~1U;
+            strcpy(s_pSym[s_u32SymCount].acName, acName);
+            s_u32SymCount++;
+        }
+    }
+    fclose(pFile);
+}
+
+static const char *CallerName(uint32_t u32Caller)
+{
+    const SymType *pBest = NULL;
+    size_t u32Index;
+
+    u32Caller &= ~1U;
+    for (u32Index = 0U; u32Index < s_u32SymCount; u32Index++)
+    {
+        if ((s_pSym[u32Index].u32Addr <= u32Caller) && ((pBest == NULL) || (s_pSym[u32Index].u32Addr > pBest->u32Addr)))
+        {
+            pBest = &s_pSym[u32Index];
+        }
+    }
+
+    return (pBest != NULL) ? pBest->acName : "";
+}
+
+static void ParseStartup(SCG_SimTimingType *pTiming, const char *pArg)
+{
+    const char *pEq = strchr(pArg, '=');
+    uint8_t u8Src;
+    bool bFound = false;
+
+    if (pEq != NULL)
+    {
+        for (u8Src = 0U; u8Src < (uint8_t)SCG_SIM_SRC_NUM; u8Src++)
+        {
+            if ((strlen(SCG_SimSrcName((SCG_SimSrcType)u8Src)) == (size_t)(pEq - pArg)) &&
+                    (strncmp(SCG_SimSrcName((SCG_SimSrcType)u8Src), pArg, (size_t)(pEq - pArg)) == 0))
+            {
+                pTiming->au32Startup[u8Src] = (uint32_t)strtoul(pEq + 1, NULL, 0);
+                bFound = true;
+            }
+        }
+    }
+    if (bFound == false)
+    {
+        Usage();
+    }
+}
+
+static void AddPhase(const char *pName, uint64_t u64Cycles)
+{
+    uint32_t u32Index = 0U;
+
+    while ((u32Index < s_u32PhaseCount) && (strcmp(s_tPhase[u32Index].acName, pName) != 0))
+    {
+        u32Index++;
+    }
+    if ((u32Index == s_u32PhaseCount) && (s_u32PhaseCount < PHASE_MAX))
+    {
+        snprintf(s_tPhase[u32Index].acName, PHASE_NAME_LEN, "%s", pName);
+        s_u32PhaseCount++;
+    }
+    if (u32Index < s_u32PhaseCount)
+    {
+        s_tPhase[u32Index].u32Count++;
+        s_tPhase[u32Index].u64Total += u64Cycles;
+        if (u64Cycles > s_tPhase[u32Index].u64Max)
+        {
+            s_tPhase[u32Index].u64Max = u64Cycles;
+        }
+    }
+}
+
+/* name the phase started by a write, from the register and the model state before the write */
+static void PhaseName(char *pName, const SCG_SimType *pSim, const SCG_TraceEntryType *pEntry, uint64_t u64Now)
+{
+    SCG_TraceRegType eReg = (SCG_TraceRegType)pEntry->u8Reg;
+    SCG_SimSrcType eSrc = SCG_SimGetRegSrc(eReg);
+    const char *pRegName = SCG_SimRegName(eReg);
+    uint32_t u32Old = SCG_SimRead(pSim, eReg, u64Now);
+    uint32_t u32EnMask = SCG_SIM_DIV_EN(0U) | SCG_SIM_DIV_EN(1U) | SCG_SIM_DIV_EN(2U);
+
+    if ((pEntry->u8Op == (uint8_t)SCG_TRACE_OP_ERRCLEAR) ||
+            ((pEntry->u8Op == (uint8_t)SCG_TRACE_OP_WRITE) &&
+             ((eReg == SCG_TRACE_REG_FIRCCSR) || (eReg == SCG_TRACE_REG_SIRCCSR) || (eReg == SCG_TRACE_REG_FOSCCSR) ||
+              (eReg == SCG_TRACE_REG_SOSCCSR) || (eReg == SCG_TRACE_REG_PLL0CSR)) &&
+             ((pEntry->u32Value & SCG_SIM_CSR_ERR) != 0U)))
+    {
+        /* SCG_IRQHandler writes the CSR back with ERR set to clear the clock error flag */
+        snprintf(pName, PHASE_NAME_LEN, "error clear");
+    }
+    else if (eReg == SCG_TRACE_REG_CCR)
+    {
+        snprintf(pName, PHASE_NAME_LEN, "system clock switch");
+    }
+    else if ((eReg == SCG_TRACE_REG_PLL0CSR) && ((pEntry->u32Value & SCG_SIM_CSR_EN) != 0U) &&
+             ((u32Old & SCG_SIM_CSR_EN) == 0U) &&
+             (SCG_SIM_PLL0CFG_PREDIV(pSim->au32Reg[SCG_TRACE_REG_PLL0CFG]) == 3U))
+    {
+        snprintf(pName, PHASE_NAME_LEN, "PLL0 erratum pulse");
+    }
+    else if ((eReg == SCG_TRACE_REG_FIRCCSR) || (eReg == SCG_TRACE_REG_SIRCCSR) || (eReg == SCG_TRACE_REG_SIRC32KCSR) ||
+             (eReg == SCG_TRACE_REG_FOSCCSR) || (eReg == SCG_TRACE_REG_SOSCCSR) || (eReg == SCG_TRACE_REG_PLL0CSR))
+    {
+        if (((pEntry->u32Value ^ u32Old) & SCG_SIM_CSR_EN) == 0U)
+        {
+            snprintf(pName, PHASE_NAME_LEN, "%s control", SCG_SimSrcName(eSrc));
+        }
+        else
+        {
+            snprintf(pName, PHASE_NAME_LEN, "%s %s", SCG_SimSrcName(eSrc),
+                     ((pEntry->u32Value & SCG_SIM_CSR_EN) != 0U) ? "startup" : "shutdown");
+        }
+    }
+    else if ((eReg == SCG_TRACE_REG_FIRCDIV) || (eReg == SCG_TRACE_REG_SIRCDIV) || (eReg == SCG_TRACE_REG_FOSCDIV) ||
+             (eReg == SCG_TRACE_REG_PLL0DIV))
+    {
+        if ((pEntry->u32Value & u32EnMask & ~u32Old) != 0U)
+        {
+            snprintf(pName, PHASE_NAME_LEN, "%s enable ack", pRegName);
+        }
+        else if ((u32Old & u32EnMask & ~pEntry->u32Value) != 0U)
+        {
+            snprintf(pName, PHASE_NAME_LEN, "%s disable ack", pRegName);
+        }
+        else
+        {
+            snprintf(pName, PHASE_NAME_LEN, "%s program", pRegName);
+        }
+    }
+    else if (eReg == SCG_TRACE_REG_PLL0CFG)
+    {
+        snprintf(pName, PHASE_NAME_LEN, "PLL0 config");
+    }
+    else
+    {
+        snprintf(pName, PHASE_NAME_LEN, "%s config", pRegName);
+    }
+}
+
+static void OnViolation(SCG_SimRuleType eRule, SCG_TraceRegType eReg, uint64_t u64Now, void *pContext)
+{
+    (void)pContext;
+    printf("      !! %s: %s at %llu\n", SCG_SimRegName(eReg), SCG_SimRuleText(eRule), (unsigned long long)u64Now);
+}
+
+/* ################################################################################## */
+/* ################################ Global Functions ################################ */
+
+int main(int argc, char **argv)
+{
+    const char *pTraceFile = NULL;
+    FILE *pFile;
+    uint8_t au8Raw[TRACE_ENTRY_SIZE];
+    SCG_TraceEntryType tEntry;
+    SCG_SimTimingType tTiming;
+    SCG_SimType tSim;
+    char acPhase[PHASE_NAME_LEN] = "";
+    uint64_t u64Now = 0U;
+    uint64_t u64PhaseStart = 0U;
+    uint32_t u32PrevCycles = 0U;
+    uint32_t u32Value;
+    uint32_t u32Violations = 0U;
+    uint32_t u32Index;
+    bool bFirst = true;
+    int i = 1;
+
+    memset(&tTiming, 0, sizeof(tTiming));
+    while (i < argc)
+    {
+        if ((strcmp(argv[i], "-startup") == 0) && ((i + 1) < argc))
+        {
+            ParseStartup(&tTiming, argv[i + 1]);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-ack") == 0) && ((i + 1) < argc))
+        {
+            tTiming.u32DivAck = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-uprd") == 0) && ((i + 1) < argc))
+        {
+            tTiming.u32Uprd = (uint32_t)strtoul(argv[i + 1], NULL, 0);
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-sym") == 0) && ((i + 1) < argc))
+        {
+            LoadSymbols(argv[i + 1]);
+            i += 2;
+        }
+        else if ((argv[i][0] != '-') && (pTraceFile == NULL))
+        {
+            pTraceFile = argv[i];
+            i++;
+        }
+        else
+        {
+            Usage();
+        }
+    }
+    if (pTraceFile == NULL)
+    {
+        Usage();
+    }
+
+    pFile = fopen(pTraceFile, "rb");
+    if (pFile == NULL)
+    {
+        perror(pTraceFile);
+        return 1;
+    }
+
+    SCG_SimInit(&tSim, &tTiming);
+    tSim.pViolation = OnViolation;
+
+    printf("%5s %12s  %-28s %-10s %-6s %-10s phase\n", "seq", "time", "caller", "register", "op", "value");
+    while (fread(au8Raw, 1U, TRACE_ENTRY_SIZE, pFile) == TRACE_ENTRY_SIZE)
+    {
+        tEntry.u32Cycles = GetLe32(&au8Raw[0]);
+        tEntry.u32Caller = GetLe32(&au8Raw[4]);
+        tEntry.u32Value = GetLe32(&au8Raw[8]);
+        tEntry.u16Seq = (uint16_t)((uint32_t)au8Raw[12] | ((uint32_t)au8Raw[13] << 8));
+        tEntry.u8Reg = au8Raw[14];
+        tEntry.u8Op = au8Raw[15];
+        if (tEntry.u8Reg >= (uint8_t)SCG_TRACE_REG_NUM)
+        {
+            continue;
+        }
+
+        /* the cycle counter wraps, the time base of the model does not */
+        u64Now += (bFirst == true) ? 0U : (uint32_t)(tEntry.u32Cycles - u32PrevCycles);
+        if (bFirst == false)
+        {
+            AddPhase(acPhase, u64Now - u64PhaseStart);
+        }
+        PhaseName(acPhase, &tSim, &tEntry, u64Now);
+        u64PhaseStart = u64Now;
+
+        printf("%5u %12llu  %-28s %-10s %-6s 0x%08lx %s\n", (unsigned)tEntry.u16Seq, (unsigned long long)u64Now,
+               CallerName(tEntry.u32Caller), SCG_SimRegName((SCG_TraceRegType)tEntry.u8Reg),
+               (tEntry.u8Op == (uint8_t)SCG_TRACE_OP_WRITE) ? "write" :
+               ((tEntry.u8Op == (uint8_t)SCG_TRACE_OP_MODIFY) ? "modify" : "errclr"),
+               (unsigned long)tEntry.u32Value, acPhase);
+
+        if (tEntry.u8Op != (uint8_t)SCG_TRACE_OP_ERRCLEAR)
+        {
+            u32Value = tEntry.u32Value;
+            if (tEntry.u8Op == (uint8_t)SCG_TRACE_OP_MODIFY)
+            {
+                /* a read back also holds status bits, only the control bits are written */
+                u32Value &= CSR_CTRL_MASK & DIV_CTRL_MASK;
+            }
+            SCG_SimWrite(&tSim, (SCG_TraceRegType)tEntry.u8Reg, u32Value, u64Now);
+        }
+
+        u32PrevCycles = tEntry.u32Cycles;
+        bFirst = false;
+    }
+    fclose(pFile);
+    if (bFirst == false)
+    {
+        /* the last phase ends when the trace was dumped, it has no known length */
+        AddPhase(acPhase, 0U);
+    }
+
+    printf("\n%-28s %6s %12s %12s\n", "phase", "count", "total", "max");
+    for (u32Index = 0U; u32Index < s_u32PhaseCount; u32Index++)
+    {
+        printf("%-28s %6lu %12llu %12llu\n", s_tPhase[u32Index].acName, (unsigned long)s_tPhase[u32Index].u32Count,
+               (unsigned long long)s_tPhase[u32Index].u64Total, (unsigned long long)s_tPhase[u32Index].u64Max);
+    }
+    printf("\n");
+    for (u32Index = 0U; u32Index < (uint32_t)SCG_SIM_RULE_NUM; u32Index++)
+    {
+        if (tSim.au32RuleCount[u32Index] != 0U)
+        {
+            printf("rule violated %lu times: %s\n", (unsigned long)tSim.au32RuleCount[u32Index],
+                   SCG_SimRuleText((SCG_SimRuleType)u32Index));
+            u32Violations += tSim.au32RuleCount[u32Index];
+        }
+    }
+    if (u32Violations == 0U)
+    {
+        printf("no sequencing rule violated\n");
+    }
+    free(s_pSym);
+
+    return (u32Violations == 0U) ? 0 : 3;
+}
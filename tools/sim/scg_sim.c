@@ -0,0 +1,425 @@
+/**
+ * @file scg_sim.c
+ * @author Flagchip
+ * @brief Host model of the SCG registers with the driver sequencing rules
+ * @version 0.1.0B
+ * @date 2023-09-07
+ *
+ * @copyright Copyright (c) 2020-2023 Flagchip Semiconductors Co., Ltd.
+ *
+ */
+
+/********************************************************************************
+*   Revision History:
+*
+*   Version     Date          Initials       CR#          Descriptions
+*   ---------   ----------    ------------   ----------   ---------------
+*   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
+********************************************************************************/
+#include <stddef.h>
+#include <string.h>
+#include "scg_sim.h"
+
+/* ################################################################################## */
+/* ####################################### Macro #################################### */
+#define SCG_SIM_PREDIV_BY2          1U
+#define SCG_SIM_PREDIV_BY4          3U
+
+/* CCR[SCS] encodings */
+#define SCG_SIM_SCS_FOSC            1U
+#define SCG_SIM_SCS_FIRC            3U
+#define SCG_SIM_SCS_PLL0            6U
+
+/* ################################################################################## */
+/* ################################ Local Variables ################################# */
+static const char *const s_pSrcName[SCG_SIM_SRC_NUM + 1U] =
+{
+    "FIRC", "SIRC", "SIRC32K", "FOSC", "SOSC", "PLL0", "-"
+};
+
+static const char *const s_pRegName[SCG_TRACE_REG_NUM] =
+{
+    "CCR", "CLKOUTCFG", "FIRCCSR", "FIRCDIV", "FIRCCFG", "FIRCTCFG", "SIRCCSR", "SIRCDIV", "SIRCTCFG",
+    "SIRC32KCSR", "FOSCCSR", "FOSCDIV", "FOSCCFG", "SOSCCSR", "SOSCCFG", "PLL0CSR", "PLL0DIV", "PLL0CFG"
+};
+
+static const SCG_SimSrcType s_eRegSrc[SCG_TRACE_REG_NUM] =
+{
+    SCG_SIM_SRC_NONE, SCG_SIM_SRC_NONE, SCG_SIM_SRC_FIRC, SCG_SIM_SRC_FIRC, SCG_SIM_SRC_FIRC, SCG_SIM_SRC_FIRC,
+    SCG_SIM_SRC_SIRC, SCG_SIM_SRC_SIRC, SCG_SIM_SRC_SIRC, SCG_SIM_SRC_SIRC32K, SCG_SIM_SRC_FOSC, SCG_SIM_SRC_FOSC,
+    SCG_SIM_SRC_FOSC, SCG_SIM_SRC_SOSC, SCG_SIM_SRC_SOSC, SCG_SIM_SRC_PLL0, SCG_SIM_SRC_PLL0, SCG_SIM_SRC_PLL0
+};
+
+static const char *const s_pRuleText[SCG_SIM_RULE_NUM] =
+{
+    "divider changed while enabled",
+    "divider changed before the disable ACK",
+    "PLL0CFG written while PLL0 is enabled",
+    "PLL0 PREDIV BY2 enabled without the BY4 pulse",
+    "oscillator config written while enabled",
+    "CCR selects a source that is not valid",
+    "source disabled while in use",
+};
+
+static const char *const s_pFaultName[SCG_SIM_FAULT_NUM] =
+{
+    "none", "oscillator loss", "stuck lock", "slow divider ACK", "UPRD timeout"
+};
+
+/* ################################################################################## */
+/* ################################ Local Functions  ################################ */
+
+static bool SCG_SimIsCsr(SCG_TraceRegType eReg)
+{
+    return ((eReg == SCG_TRACE_REG_FIRCCSR) || (eReg == SCG_TRACE_REG_SIRCCSR) || (eReg == SCG_TRACE_REG_SIRC32KCSR) ||
+            (eReg == SCG_TRACE_REG_FOSCCSR) || (eReg == SCG_TRACE_REG_SOSCCSR) || (eReg == SCG_TRACE_REG_PLL0CSR));
+}
+
+static bool SCG_SimIsDiv(SCG_TraceRegType eReg)
+{
+    return ((eReg == SCG_TRACE_REG_FIRCDIV) || (eReg == SCG_TRACE_REG_SIRCDIV) || (eReg == SCG_TRACE_REG_FOSCDIV) ||
+            (eReg == SCG_TRACE_REG_PLL0DIV));
+}
+
+static SCG_TraceRegType SCG_SimCsrOf(SCG_SimSrcType eSrc)
+{
+    static const SCG_TraceRegType s_eCsr[SCG_SIM_SRC_NUM] =
+    {
+        SCG_TRACE_REG_FIRCCSR, SCG_TRACE_REG_SIRCCSR, SCG_TRACE_REG_SIRC32KCSR,
+        SCG_TRACE_REG_FOSCCSR, SCG_TRACE_REG_SOSCCSR, SCG_TRACE_REG_PLL0CSR
+    };
+
+    return s_eCsr[eSrc];
+}
+
+static bool SCG_SimIsEnabled(const SCG_SimType *pSim, SCG_SimSrcType eSrc)
+{
+    return ((pSim->au32Reg[SCG_SimCsrOf(eSrc)] & SCG_SIM_CSR_EN) != 0U);
+}
+
+static SCG_SimSrcType SCG_SimScsToSrc(uint32_t u32Scs)
+{
+    SCG_SimSrcType eSrc;
+
+    switch (u32Scs)
+    {
+    case SCG_SIM_SCS_FOSC:
+        eSrc = SCG_SIM_SRC_FOSC;
+        break;
+    case SCG_SIM_SCS_FIRC:
+        eSrc = SCG_SIM_SRC_FIRC;
+        break;
+    case SCG_SIM_SCS_PLL0:
+        eSrc = SCG_SIM_SRC_PLL0;
+        break;
+    default:
+        eSrc = SCG_SIM_SRC_NONE;
+        break;
+    }
+
+    return eSrc;
+}
+
+static SCG_SimSrcType SCG_SimPll0Ref(const SCG_SimType *pSim)
+{
+    return ((pSim->au32Reg[SCG_TRACE_REG_PLL0CFG] & SCG_SIM_PLL0CFG_FIRC) != 0U) ? SCG_SIM_SRC_FIRC : SCG_SIM_SRC_FOSC;
+}
+
+static bool SCG_SimFaultActive(const SCG_SimType *pSim, SCG_SimFaultKindType eKind, SCG_SimSrcType eSrc,
+                               uint64_t u64Now)
+{
+    return ((pSim->tFault.eKind == eKind) && (u64Now >= pSim->tFault.u64At) &&
+            ((eKind == SCG_SIM_FAULT_UPRD_TIMEOUT) || (pSim->tFault.eSrc == eSrc)));
+}
+
+/* time a source stopped, PLL0 also stops with its reference */
+static uint64_t SCG_SimLostAt(const SCG_SimType *pSim, SCG_SimSrcType eSrc)
+{
+    uint64_t u64LostAt = pSim->au64LostAt[eSrc];
+
+    if ((eSrc == SCG_SIM_SRC_PLL0) && (pSim->au64LostAt[SCG_SimPll0Ref(pSim)] < u64LostAt))
+    {
+        u64LostAt = pSim->au64LostAt[SCG_SimPll0Ref(pSim)];
+    }
+
+    return u64LostAt;
+}
+
+static void SCG_SimViolate(SCG_SimType *pSim, SCG_SimRuleType eRule, SCG_TraceRegType eReg, uint64_t u64Now)
+{
+    pSim->au32RuleCount[eRule]++;
+    if (pSim->pViolation != NULL)
+    {
+        pSim->pViolation(eRule, eReg, u64Now, pSim->pContext);
+    }
+}
+
+static void SCG_SimWriteCsr(SCG_SimType *pSim, SCG_TraceRegType eReg, uint32_t u32Value, uint64_t u64Now)
+{
+    SCG_SimSrcType eSrc = s_eRegSrc[eReg];
+    bool bWasOn = ((pSim->au32Reg[eReg] & SCG_SIM_CSR_EN) != 0U);
+    bool bOn = ((u32Value & SCG_SIM_CSR_EN) != 0U);
+    uint32_t u32Prediv = SCG_SIM_PLL0CFG_PREDIV(pSim->au32Reg[SCG_TRACE_REG_PLL0CFG]);
+
+    if ((bWasOn == false) && (bOn == true))
+    {
+        pSim->au64ValidAt[eSrc] = (SCG_SimFaultActive(pSim, SCG_SIM_FAULT_STUCK_LOCK, eSrc, u64Now) == true) ?
+                                  SCG_SIM_NEVER : (u64Now + pSim->tTiming.au32Startup[eSrc]);
+        if ((eSrc == SCG_SIM_SRC_PLL0) && (u32Prediv == SCG_SIM_PREDIV_BY4))
+        {
+            pSim->bPll0PulseArmed = true;
+            pSim->u32Pll0PulseCfg = pSim->au32Reg[SCG_TRACE_REG_PLL0CFG];
+        }
+        else if ((eSrc == SCG_SIM_SRC_PLL0) && (u32Prediv == SCG_SIM_PREDIV_BY2))
+        {
+            /* the pulse must use the same source and multiplier as the final configuration */
+            if ((pSim->bPll0PulseDone == false) ||
+                    ((pSim->u32Pll0PulseCfg & ~0x7U) != (pSim->au32Reg[SCG_TRACE_REG_PLL0CFG] & ~0x7U)))
+            {
+                SCG_SimViolate(pSim, SCG_SIM_RULE_PLL0_PREDIV2_PULSE, eReg, u64Now);
+            }
+            pSim->bPll0PulseDone = false;
+        }
+        else
+        {
+        }
+    }
+    else if ((bWasOn == true) && (bOn == false))
+    {
+        if ((SCG_SimGetSysSrc(pSim, u64Now) == eSrc) ||
+                ((eSrc == SCG_SimPll0Ref(pSim)) && (SCG_SimIsEnabled(pSim, SCG_SIM_SRC_PLL0) == true)))
+        {
+            SCG_SimViolate(pSim, SCG_SIM_RULE_SRC_DISABLED_IN_USE, eReg, u64Now);
+        }
+        pSim->au64ValidAt[eSrc] = SCG_SIM_NEVER;
+        if ((eSrc == SCG_SIM_SRC_PLL0) && (pSim->bPll0PulseArmed == true))
+        {
+            pSim->bPll0PulseArmed = false;
+            pSim->bPll0PulseDone = true;
+        }
+    }
+    else
+    {
+    }
+
+    /* ERR is write 1 to clear */
+    if ((u32Value & SCG_SIM_CSR_ERR) != 0U)
+    {
+        pSim->abErrCleared[eSrc] = true;
+    }
+
+    pSim->au32Reg[eReg] = u32Value & ~(SCG_SIM_CSR_VLD | SCG_SIM_CSR_ERR);
+}
+
+static void SCG_SimWriteDiv(SCG_SimType *pSim, SCG_TraceRegType eReg, uint32_t u32Value, uint64_t u64Now)
+{
+    uint32_t u32Old = pSim->au32Reg[eReg];
+    uint8_t u8Out;
+
+    for (u8Out = 0U; u8Out < 3U; u8Out++)
+    {
+        if (((u32Old ^ u32Value) & SCG_SIM_DIV_FIELD(u8Out)) != 0U)
+        {
+            if (((u32Old & SCG_SIM_DIV_EN(u8Out)) != 0U) && ((u32Value & SCG_SIM_DIV_EN(u8Out)) != 0U))
+            {
+                SCG_SimViolate(pSim, SCG_SIM_RULE_DIV_WHILE_ENABLED, eReg, u64Now);
+            }
+            else if (((u32Old & SCG_SIM_DIV_EN(u8Out)) == 0U) && (u64Now < pSim->au64AckAt[eReg][u8Out]))
+            {
+                SCG_SimViolate(pSim, SCG_SIM_RULE_DIV_ACK_PENDING, eReg, u64Now);
+            }
+            else
+            {
+            }
+        }
+        if (((u32Old ^ u32Value) & SCG_SIM_DIV_EN(u8Out)) != 0U)
+        {
+            pSim->au64AckAt[eReg][u8Out] = u64Now + pSim->tTiming.u32DivAck;
+            if (SCG_SimFaultActive(pSim, SCG_SIM_FAULT_SLOW_ACK, s_eRegSrc[eReg], u64Now) == true)
+            {
+                pSim->au64AckAt[eReg][u8Out] += pSim->tFault.u32Extra;
+            }
+        }
+    }
+
+    pSim->au32Reg[eReg] = u32Value & ~(SCG_SIM_DIV_ACK(0U) | SCG_SIM_DIV_ACK(1U) | SCG_SIM_DIV_ACK(2U));
+}
+
+/* ################################################################################## */
+/* ################################ Global Functions ################################ */
+
+void SCG_SimInit(SCG_SimType *pSim, const SCG_SimTimingType *pTiming)
+{
+    uint8_t u8Index;
+
+    memset(pSim, 0, sizeof(SCG_SimType));
+    if (pTiming != NULL)
+    {
+        pSim->tTiming = *pTiming;
+    }
+
+    for (u8Index = 0U; u8Index < (uint8_t)SCG_SIM_SRC_NUM; u8Index++)
+    {
+        pSim->au64ValidAt[u8Index] = SCG_SIM_NEVER;
+        pSim->au64LostAt[u8Index] = SCG_SIM_NEVER;
+    }
+    pSim->au32Reg[SCG_TRACE_REG_FIRCCSR] = SCG_SIM_CSR_EN;
+    pSim->au64ValidAt[SCG_SIM_SRC_FIRC] = 0U;
+    pSim->au32Reg[SCG_TRACE_REG_SIRCCSR] = SCG_SIM_CSR_EN;
+    pSim->au64ValidAt[SCG_SIM_SRC_SIRC] = 0U;
+    pSim->au32Reg[SCG_TRACE_REG_CCR] = SCG_SIM_SCS_FIRC << 24U;
+    pSim->u32SysCcr = pSim->au32Reg[SCG_TRACE_REG_CCR];
+}
+
+void SCG_SimWrite(SCG_SimType *pSim, SCG_TraceRegType eReg, uint32_t u32Value, uint64_t u64Now)
+{
+    SCG_SimSrcType eSrc = (eReg < SCG_TRACE_REG_NUM) ? s_eRegSrc[eReg] : SCG_SIM_SRC_NONE;
+
+    if (eReg >= SCG_TRACE_REG_NUM)
+    {
+        /* unknown register, ignored */
+    }
+    else if (SCG_SimIsCsr(eReg) == true)
+    {
+        SCG_SimWriteCsr(pSim, eReg, u32Value, u64Now);
+    }
+    else if (SCG_SimIsDiv(eReg) == true)
+    {
+        SCG_SimWriteDiv(pSim, eReg, u32Value, u64Now);
+    }
+    else if (eReg == SCG_TRACE_REG_CCR)
+    {
+        eSrc = SCG_SimScsToSrc(SCG_SIM_CCR_SCS(u32Value));
+        if ((eSrc == SCG_SIM_SRC_NONE) || (SCG_SimIsValid(pSim, eSrc, u64Now) == false))
+        {
+            SCG_SimViolate(pSim, SCG_SIM_RULE_CCR_SRC_NOT_VALID, eReg, u64Now);
+        }
+        pSim->u32SysCcr = (u64Now >= pSim->u64UprdAt) ? pSim->au32Reg[SCG_TRACE_REG_CCR] : pSim->u32SysCcr;
+        pSim->au32Reg[SCG_TRACE_REG_CCR] = u32Value;
+        pSim->u64UprdAt = (SCG_SimFaultActive(pSim, SCG_SIM_FAULT_UPRD_TIMEOUT, SCG_SIM_SRC_NONE, u64Now) == true) ?
+                          SCG_SIM_NEVER : (u64Now + pSim->tTiming.u32Uprd);
+    }
+    else
+    {
+        if (((eReg == SCG_TRACE_REG_PLL0CFG) || (eReg == SCG_TRACE_REG_FOSCCFG) || (eReg == SCG_TRACE_REG_SOSCCFG)) &&
+                (SCG_SimIsEnabled(pSim, eSrc) == true))
+        {
+            SCG_SimViolate(pSim, (eReg == SCG_TRACE_REG_PLL0CFG) ? SCG_SIM_RULE_PLL0CFG_WHILE_ENABLED :
+                           SCG_SIM_RULE_OSCCFG_WHILE_ENABLED, eReg, u64Now);
+        }
+        pSim->au32Reg[eReg] = u32Value;
+    }
+}
+
+uint32_t SCG_SimRead(const SCG_SimType *pSim, SCG_TraceRegType eReg, uint64_t u64Now)
+{
+    uint32_t u32Value = 0U;
+    uint8_t u8Out;
+
+    if (eReg < SCG_TRACE_REG_NUM)
+    {
+        u32Value = pSim->au32Reg[eReg];
+        if (SCG_SimIsCsr(eReg) == true)
+        {
+            if (SCG_SimIsValid(pSim, s_eRegSrc[eReg], u64Now) == true)
+            {
+                u32Value |= SCG_SIM_CSR_VLD;
+            }
+            if ((u64Now >= SCG_SimLostAt(pSim, s_eRegSrc[eReg])) && (pSim->abErrCleared[s_eRegSrc[eReg]] == false))
+            {
+                u32Value |= SCG_SIM_CSR_ERR;
+            }
+        }
+        else if (SCG_SimIsDiv(eReg) == true)
+        {
+            for (u8Out = 0U; u8Out < 3U; u8Out++)
+            {
+                /* ACK follows EN after the ACK delay */
+                if (((u32Value & SCG_SIM_DIV_EN(u8Out)) != 0U) == (u64Now >= pSim->au64AckAt[eReg][u8Out]))
+                {
+                    u32Value |= SCG_SIM_DIV_ACK(u8Out);
+                }
+            }
+        }
+        else
+        {
+        }
+    }
+
+    return u32Value;
+}
+
+void SCG_SimInjectFault(SCG_SimType *pSim, const SCG_SimFaultType *pFault)
+{
+    pSim->tFault = *pFault;
+    if ((pFault->eKind == SCG_SIM_FAULT_OSC_LOSS) && (pFault->eSrc < SCG_SIM_SRC_NUM))
+    {
+        pSim->au64LostAt[pFault->eSrc] = pFault->u64At;
+        pSim->abErrCleared[pFault->eSrc] = false;
+    }
+}
+
+bool SCG_SimIsUpdated(const SCG_SimType *pSim, uint64_t u64Now)
+{
+    return (u64Now >= pSim->u64UprdAt);
+}
+
+bool SCG_SimIsValid(const SCG_SimType *pSim, SCG_SimSrcType eSrc, uint64_t u64Now)
+{
+    bool bValid = false;
+
+    if (eSrc < SCG_SIM_SRC_NUM)
+    {
+        bValid = (SCG_SimIsEnabled(pSim, eSrc) == true) && (u64Now >= pSim->au64ValidAt[eSrc]) &&
+                 (u64Now < pSim->au64LostAt[eSrc]);
+        if ((bValid == true) && (eSrc == SCG_SIM_SRC_PLL0))
+        {
+            bValid = SCG_SimIsValid(pSim, SCG_SimPll0Ref(pSim), u64Now);
+        }
+    }
+
+    return bValid;
+}
+
+SCG_SimSrcType SCG_SimGetSysSrc(const SCG_SimType *pSim, uint64_t u64Now)
+{
+    uint32_t u32Ccr = (u64Now >= pSim->u64UprdAt) ? pSim->au32Reg[SCG_TRACE_REG_CCR] : pSim->u32SysCcr;
+    SCG_SimSrcType eSrc = SCG_SimScsToSrc(SCG_SIM_CCR_SCS(u32Ccr));
+    uint64_t u64LostAt;
+
+    if ((eSrc < SCG_SIM_SRC_NUM) && (pSim->tTiming.u32Failover != SCG_SIM_NO_FAILOVER))
+    {
+        u64LostAt = SCG_SimLostAt(pSim, eSrc);
+        if ((u64LostAt != SCG_SIM_NEVER) && (u64Now >= (u64LostAt + pSim->tTiming.u32Failover)))
+        {
+            eSrc = SCG_SIM_SRC_FIRC;
+        }
+    }
+
+    return eSrc;
+}
+
+SCG_SimSrcType SCG_SimGetRegSrc(SCG_TraceRegType eReg)
+{
+    return (eReg < SCG_TRACE_REG_NUM) ? s_eRegSrc[eReg] : SCG_SIM_SRC_NONE;
+}
+
+const char *SCG_SimSrcName(SCG_SimSrcType eSrc)
+{
+    return s_pSrcName[(eSrc < SCG_SIM_SRC_NUM) ? eSrc : SCG_SIM_SRC_NUM];
+}
+
+const char *SCG_SimRegName(SCG_TraceRegType eReg)
+{
+    return (eReg < SCG_TRACE_REG_NUM) ? s_pRegName[eReg] : "?";
+}
+
+const char *SCG_SimRuleText(SCG_SimRuleType eRule)
+{
+    return (eRule < SCG_SIM_RULE_NUM) ? s_pRuleText[eRule] : "?";
+}
+
+const char *SCG_SimFaultName(SCG_SimFaultKindType eKind)
+{
+    return (eKind < SCG_SIM_FAULT_NUM) ? s_pFaultName[eKind] : "?";
+}
@@ -0,0 +1,202 @@
+/**
+ * @file scg_sim.h
+ * @author Flagchip
+ * @brief Host model of the SCG registers with the driver sequencing rules
+ * @version 0.1.0B
+ * @date 2023-09-07
+ *
+ * @copyright Copyright (c) 2020-2023 Flagchip Semiconductors Co., Ltd.
+ *
+ */
+
+/********************************************************************************
+*   Revision History:
+*
+*   Version     Date          Initials       CR#          Descriptions
+*   ---------   ----------    ------------   ----------   ---------------
+*   0.1.0B      2023-09-07    Flagchip032    N/A          FC4150F1MB release version 0.1.0B
+********************************************************************************/
+#ifndef _TOOLS_SIM_SCG_SIM_H_
+#define _TOOLS_SIM_SCG_SIM_H_
+
+/*
+ * The model keeps the control bits of the registers listed in SCG_TraceRegType and derives the
+ * status bits (VLD, divider ACK, UPRD) from the time of the enabling write and the model timing.
+ * Every write is checked against the sequencing rules of fc4xxx_driver_scg.c, a broken rule is
+ * reported through the violation callback. Times are in the cycles of the trace time base.
+ * Faults injected with SCG_SimInjectFault change the derived status bits from their activation time.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include "fc4xxx_driver_scg_trace.h"
+
+/* ################################################################################## */
+/* ####################################### Macro #################################### */
+
+/* FC4150 register layout used by the model */
+#define SCG_SIM_CSR_EN              0x00000001U
+#define SCG_SIM_CSR_LK              0x00800000U
+#define SCG_SIM_CSR_VLD             0x01000000U
+#define SCG_SIM_CSR_ERR             0x04000000U
+#define SCG_SIM_DIV_FIELD(u8Out)    (0x7U << ((2U - (u8Out)) * 8U))
+#define SCG_SIM_DIV_EN(u8Out)       (0x80U << ((2U - (u8Out)) * 8U))
+#define SCG_SIM_DIV_ACK(u8Out)      (0x40U << ((2U - (u8Out)) * 8U))
+#define SCG_SIM_CCR_SCS(u32Ccr)     (((u32Ccr) >> 24U) & 0xFU)
+#define SCG_SIM_PLL0CFG_PREDIV(u32Cfg)  ((u32Cfg) & 0x7U)
+#define SCG_SIM_PLL0CFG_FIRC        0x00010000U
+
+#define SCG_SIM_NEVER               0xFFFFFFFFFFFFFFFFU
+#define SCG_SIM_NO_FAILOVER         0xFFFFFFFFU
+
+/* ################################################################################## */
+/* ################################### Type define ################################## */
+
+/**
+ * @brief Modelled clock sources
+ */
+typedef enum
+{
+    SCG_SIM_SRC_FIRC = 0U,
+    SCG_SIM_SRC_SIRC,
+    SCG_SIM_SRC_SIRC32K,
+    SCG_SIM_SRC_FOSC,
+    SCG_SIM_SRC_SOSC,
+    SCG_SIM_SRC_PLL0,
+    SCG_SIM_SRC_NUM,
+    SCG_SIM_SRC_NONE = SCG_SIM_SRC_NUM
+} SCG_SimSrcType;
+
+/**
+ * @brief Sequencing rules checked on every write
+ */
+typedef enum
+{
+    SCG_SIM_RULE_DIV_WHILE_ENABLED = 0U,    /**< divider field changed while its output is enabled */
+    SCG_SIM_RULE_DIV_ACK_PENDING,           /**< divider field changed before the disable ACK cleared */
+    SCG_SIM_RULE_PLL0CFG_WHILE_ENABLED,     /**< PLL0CFG written while PLL0 is enabled */
+    SCG_SIM_RULE_PLL0_PREDIV2_PULSE,        /**< PLL0 enabled with PREDIV BY2 without the BY4 pulse */
+    SCG_SIM_RULE_OSCCFG_WHILE_ENABLED,      /**< FOSCCFG or SOSCCFG written while the oscillator runs */
+    SCG_SIM_RULE_CCR_SRC_NOT_VALID,         /**< CCR selects a source that is not valid */
+    SCG_SIM_RULE_SRC_DISABLED_IN_USE,       /**< source disabled while it clocks the system or PLL0 */
+    SCG_SIM_RULE_NUM
+} SCG_SimRuleType;
+
+/**
+ * @brief Injected faults
+ */
+typedef enum
+{
+    SCG_SIM_FAULT_NONE = 0U,
+    SCG_SIM_FAULT_OSC_LOSS,                 /**< eSrc stops at u64At for good, VLD clears and ERR is set */
+    SCG_SIM_FAULT_STUCK_LOCK,               /**< eSrc enabled at or after u64At never gets VLD */
+    SCG_SIM_FAULT_SLOW_ACK,                 /**< divider ACKs of eSrc changed at or after u64At take u32Extra longer */
+    SCG_SIM_FAULT_UPRD_TIMEOUT,             /**< CCR writes at or after u64At never take effect, UPRD stays low */
+    SCG_SIM_FAULT_NUM
+} SCG_SimFaultKindType;
+
+/**
+ * @brief One injected fault
+ */
+typedef struct
+{
+    SCG_SimFaultKindType eKind;
+    SCG_SimSrcType eSrc;                    /**< faulty source, not used by SCG_SIM_FAULT_UPRD_TIMEOUT */
+    uint64_t u64At;                         /**< time the fault becomes active */
+    uint32_t u32Extra;                      /**< added ACK delay of SCG_SIM_FAULT_SLOW_ACK */
+} SCG_SimFaultType;
+
+/**
+ * @brief Model timing, cycles from the enabling write until the status bit is set
+ */
+typedef struct
+{
+    uint32_t au32Startup[SCG_SIM_SRC_NUM];  /**< time to VLD, PLL0 lock time for PLL0 */
+    uint32_t u32DivAck;                     /**< divider EN to ACK and disable to ACK clear */
+    uint32_t u32Uprd;                       /**< CCR write to system clock update done */
+    uint32_t u32Failover;                   /**< loss of the system clock source to the switch to FIRC,
+                                                 SCG_SIM_NO_FAILOVER if the system clock is not switched */
+} SCG_SimTimingType;
+
+/**
+ * @brief Rule violation callback
+ */
+typedef void (*SCG_SimViolationCallBackType)(SCG_SimRuleType eRule, SCG_TraceRegType eReg, uint64_t u64Now,
+                                             void *pContext);
+
+/**
+ * @brief Model state
+ */
+typedef struct
+{
+    SCG_SimTimingType tTiming;
+    uint32_t au32Reg[SCG_TRACE_REG_NUM];        /**< control bits of each register */
+    uint64_t au64ValidAt[SCG_SIM_SRC_NUM];      /**< time the source gets valid, SCG_SIM_NEVER when off */
+    uint64_t au64AckAt[SCG_TRACE_REG_NUM][3];   /**< time the ACK of DIVH/DIVM/DIVL follows its EN bit */
+    uint64_t u64UprdAt;                         /**< time the last CCR write takes effect */
+    uint32_t u32SysCcr;                         /**< CCR value in effect */
+    uint32_t u32Pll0PulseCfg;                   /**< PLL0CFG of the PREDIV BY4 pulse */
+    bool bPll0PulseArmed;                       /**< PLL0 running with PREDIV BY4 */
+    bool bPll0PulseDone;                        /**< BY4 pulse completed since the last BY2 enable */
+    SCG_SimFaultType tFault;                    /**< active fault, SCG_SIM_FAULT_NONE without */
+    uint64_t au64LostAt[SCG_SIM_SRC_NUM];       /**< time the source was lost, SCG_SIM_NEVER if not */
+    bool abErrCleared[SCG_SIM_SRC_NUM];         /**< ERR of the lost source cleared by a CSR write */
+    uint32_t au32RuleCount[SCG_SIM_RULE_NUM];
+    SCG_SimViolationCallBackType pViolation;
+    void *pContext;
+} SCG_SimType;
+
+/* ################################################################################## */
+/* ################################ Global Functions ################################ */
+
+/**
+ * @brief Reset state: FIRC and SIRC running, FIRC is the system clock.
+ * @param pTiming: model timing, NULL for zero latencies
+ */
+void SCG_SimInit(SCG_SimType *pSim, const SCG_SimTimingType *pTiming);
+
+/**
+ * @brief Apply a register write at time u64Now and check the sequencing rules.
+ */
+void SCG_SimWrite(SCG_SimType *pSim, SCG_TraceRegType eReg, uint32_t u32Value, uint64_t u64Now);
+
+/**
+ * @brief Register value at time u64Now, control bits plus the derived status bits.
+ */
+uint32_t SCG_SimRead(const SCG_SimType *pSim, SCG_TraceRegType eReg, uint64_t u64Now);
+
+/**
+ * @brief Inject a fault, it replaces the fault injected before. An oscillator loss stays in effect
+ *        when another fault is injected later.
+ */
+void SCG_SimInjectFault(SCG_SimType *pSim, const SCG_SimFaultType *pFault);
+
+/**
+ * @brief Check if the last CCR write took effect at time u64Now (UPRD).
+ */
+bool SCG_SimIsUpdated(const SCG_SimType *pSim, uint64_t u64Now);
+
+/**
+ * @brief Check if a source is valid at time u64Now, PLL0 also needs a valid reference.
+ */
+bool SCG_SimIsValid(const SCG_SimType *pSim, SCG_SimSrcType eSrc, uint64_t u64Now);
+
+/**
+ * @brief Source clocking the system at time u64Now, from the CCR value in effect.
+ *        FIRC once the failover time has passed after the loss of that source.
+ */
+SCG_SimSrcType SCG_SimGetSysSrc(const SCG_SimType *pSim, uint64_t u64Now);
+
+/**
+ * @brief Source controlled by a CSR, DIV or CFG register, SCG_SIM_SRC_NONE for CCR and CLKOUTCFG.
+ */
+SCG_SimSrcType SCG_SimGetRegSrc(SCG_TraceRegType eReg);
+
+/**
+ * @brief Name of a source, register or rule.
+ */
+const char *SCG_SimSrcName(SCG_SimSrcType eSrc);
+const char *SCG_SimRegName(SCG_TraceRegType eReg);
+const char *SCG_SimRuleText(SCG_SimRuleType eRule);
+const char *SCG_SimFaultName(SCG_SimFaultKindType eKind);
+
+#endif